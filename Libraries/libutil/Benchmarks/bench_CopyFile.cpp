@@ -0,0 +1,75 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <libutil/DefaultFilesystem.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using libutil::DefaultFilesystem;
+using libutil::Filesystem;
+
+/*
+ * Copy a file repeatedly, with both the default filesystem's copy and the
+ * generic copy through memory. Pass the directory to copy in, to measure a
+ * particular filesystem; some filesystems can share the data instead.
+ */
+int
+main(int argc, char **argv)
+{
+    size_t megabytes = (argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 256);
+    int iterations = (argc > 2 ? std::atoi(argv[2]) : 5);
+    std::string directory = (argc > 3 ? argv[3] : "/tmp");
+
+    DefaultFilesystem filesystem;
+    std::string from = directory + "/bench_CopyFile.from";
+    std::string to = directory + "/bench_CopyFile.to";
+
+    std::vector<uint8_t> contents(megabytes * 1024 * 1024);
+    for (size_t n = 0; n < contents.size(); n++) {
+        contents[n] = static_cast<uint8_t>((n * 131) ^ (n >> 11));
+    }
+    if (!filesystem.write(contents, from)) {
+        fprintf(stderr, "error: couldn't write %s\n", from.c_str());
+        return 1;
+    }
+    contents.clear();
+    contents.shrink_to_fit();
+
+    std::chrono::duration<double> fast = std::chrono::duration<double>::zero();
+    std::chrono::duration<double> generic = std::chrono::duration<double>::zero();
+
+    for (int i = 0; i < iterations; i++) {
+        filesystem.removeFile(to);
+        auto start = std::chrono::steady_clock::now();
+        bool success = filesystem.copyFile(from, to);
+        fast += std::chrono::steady_clock::now() - start;
+
+        filesystem.removeFile(to);
+        start = std::chrono::steady_clock::now();
+        success = success && filesystem.Filesystem::copyFile(from, to);
+        generic += std::chrono::steady_clock::now() - start;
+
+        if (!success) {
+            fprintf(stderr, "error: couldn't copy %s\n", from.c_str());
+            return 1;
+        }
+    }
+
+    filesystem.removeFile(from);
+    filesystem.removeFile(to);
+
+    double total = static_cast<double>(megabytes) * iterations;
+    printf("file: %zu MB, %d iterations\n", megabytes, iterations);
+    printf("copy: %.3f s, %.1f MB/s\n", fast.count(), total / fast.count());
+    printf("generic copy: %.3f s, %.1f MB/s\n", generic.count(), total / generic.count());
+
+    return 0;
+}
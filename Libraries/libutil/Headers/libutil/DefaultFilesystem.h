@@ -17,6 +17,7 @@ class DefaultFilesystem : public Filesystem {
 public:
     virtual bool exists(std::string const &path) const;
     virtual ext::optional<Type> type(std::string const &path) const;
+    virtual ext::optional<Metadata> metadata(std::string const &path) const;
 
 public:
     virtual bool isReadable(std::string const &path) const;
@@ -28,7 +29,9 @@ public:
     virtual bool writeFilePermissions(std::string const &path, Permissions::Operation operation, Permissions permissions);
     virtual bool createFile(std::string const &path);
     virtual bool read(std::vector<uint8_t> *contents, std::string const &path, size_t offset = 0, ext::optional<size_t> length = ext::nullopt) const;
+    virtual std::unique_ptr<MappedFile> map(std::string const &path) const;
     virtual bool write(std::vector<uint8_t> const &contents, std::string const &path);
+    virtual bool writeAtomically(std::string const &path, bool skipIfIdentical, bool synchronize, std::function<bool(Append const &)> const &cb);
     virtual bool copyFile(std::string const &from, std::string const &to);
     virtual bool removeFile(std::string const &path);
 
@@ -46,6 +49,8 @@ public:
     virtual bool writeDirectoryPermissions(std::string const &path, Permissions::Operation operation, Permissions permissions, bool recursive);
     virtual bool createDirectory(std::string const &path, bool recursive);
     virtual bool readDirectory(std::string const &path, bool recursive, std::function<void(std::string const &)> const &cb) const;
+    virtual bool enumerateDirectory(std::string const &path, bool recursive, bool metadata, std::function<void(DirectoryEntry const &)> const &cb) const;
+    virtual bool walkDirectory(std::string const &path, bool metadata, std::function<void(DirectoryEntry const &)> const &cb) const;
     virtual bool copyDirectory(std::string const &from, std::string const &to, bool recursive);
     virtual bool removeDirectory(std::string const &path, bool recursive);
 
@@ -0,0 +1,67 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef __libutil_ExecutableCache_h
+#define __libutil_ExecutableCache_h
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <ext/optional>
+
+namespace libutil {
+
+class Filesystem;
+
+/*
+ * Remembers where executables were found in a list of search paths, so
+ * running the same tool many times doesn't search for it each time. Results,
+ * optionally including executables that weren't found, are kept until
+ * invalidated; use one cache for the duration of a build, and invalidate
+ * directories that the build writes into. Not safe to use from multiple
+ * threads at once.
+ */
+class ExecutableCache {
+private:
+    struct Entry {
+        std::vector<std::string>    paths; /* normalized */
+        ext::optional<std::string>  executable;
+    };
+
+private:
+    std::unordered_map<std::string, Entry> _entries;
+    bool                                   _missing;
+
+public:
+    /*
+     * If missing is false, executables that weren't found are searched
+     * for again each time.
+     */
+    explicit ExecutableCache(bool missing = true);
+
+public:
+    /*
+     * Find an executable in search paths, like `Filesystem::findExecutable`.
+     */
+    ext::optional<std::string> find(Filesystem const *filesystem, std::string const &name, std::vector<std::string> const &paths);
+
+public:
+    /*
+     * Forget all results.
+     */
+    void invalidate();
+
+    /*
+     * Forget results that searched a directory, after it has changed.
+     */
+    void invalidate(std::string const &directory);
+};
+
+}
+
+#endif  // !__libutil_ExecutableCache_h
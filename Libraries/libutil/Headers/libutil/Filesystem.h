@@ -9,9 +9,12 @@
 #ifndef __libutil_Filesystem_h
 #define __libutil_Filesystem_h
 
+#include <libutil/MappedFile.h>
 #include <libutil/Permissions.h>
 
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 #include <ext/optional>
@@ -38,6 +41,54 @@ public:
         Directory,
     };
 
+    /*
+     * Information about a filesystem entry, used to detect changes to it.
+     */
+    struct Metadata {
+        /*
+         * The type of the entry.
+         */
+        Type     type;
+
+        /*
+         * The size of the entry's contents, in bytes.
+         */
+        uint64_t size;
+
+        /*
+         * The last modification time, in nanoseconds since the Unix epoch.
+         * Zero if the filesystem does not track modification times.
+         */
+        int64_t  modificationTime;
+    };
+
+    /*
+     * Appends to the contents of a file being written. Returns false if the
+     * contents could not be written.
+     */
+    using Append = std::function<bool(uint8_t const *data, size_t size)>;
+
+    /*
+     * An entry found when enumerating a directory.
+     */
+    struct DirectoryEntry {
+        /*
+         * The path to the entry, relative to the enumerated directory.
+         */
+        std::string             path;
+
+        /*
+         * The type of the entry. Like `type()`, symbolic links are not
+         * followed. Empty for unsupported types.
+         */
+        ext::optional<Type>     type;
+
+        /*
+         * The metadata for the entry, if it was requested.
+         */
+        ext::optional<Metadata> metadata;
+    };
+
 public:
     /*
      * Test if a filesystem entry exists.
@@ -49,6 +100,12 @@ public:
      */
     virtual ext::optional<Type> type(std::string const &path) const = 0;
 
+    /*
+     * Get the metadata for a filesystem entry. Like `type()`, does not follow
+     * a symbolic link at the path itself.
+     */
+    virtual ext::optional<Metadata> metadata(std::string const &path) const = 0;
+
 public:
     /*
      * Test if a file is readable.
@@ -87,11 +144,28 @@ public:
      */
     virtual bool read(std::vector<uint8_t> *contents, std::string const &path, size_t offset = 0, ext::optional<size_t> length = ext::nullopt) const = 0;
 
+    /*
+     * Read a whole file without copying it, where possible. Returns null if
+     * the file can't be read. The file should not change while mapped.
+     */
+    virtual std::unique_ptr<MappedFile> map(std::string const &path) const;
+
     /*
      * Write to a file.
      */
     virtual bool write(std::vector<uint8_t> const &contents, std::string const &path) = 0;
 
+    /*
+     * Write to a file, with the contents appended in pieces by a function.
+     * A regular file is replaced as a whole, so it is never seen partially
+     * written. Anything that can't be replaced, such as a device, a pipe, or
+     * a file with other hard links, is written in place instead. If
+     * `skipIfIdentical` is set and the contents are unchanged, the file is
+     * left alone, keeping its modification time. If `synchronize` is set,
+     * the contents are flushed to storage first.
+     */
+    virtual bool writeAtomically(std::string const &path, bool skipIfIdentical, bool synchronize, std::function<bool(Append const &)> const &cb);
+
     /*
      * Copy a file to a new path.
      */
@@ -160,6 +234,20 @@ public:
      */
     virtual bool readDirectory(std::string const &path, bool recursive, std::function<void(std::string const &)> const &cb) const = 0;
 
+    /*
+     * Enumerate contents of a directory, with the type of each entry and,
+     * optionally, its metadata. Where possible, these come from reading the
+     * directory rather than looking up each entry afterwards.
+     */
+    virtual bool enumerateDirectory(std::string const &path, bool recursive, bool metadata, std::function<void(DirectoryEntry const &)> const &cb) const;
+
+    /*
+     * Recursively enumerate contents of a directory, reading subdirectories
+     * in parallel where possible. The callback can be called concurrently
+     * from multiple threads, and in no particular order.
+     */
+    virtual bool walkDirectory(std::string const &path, bool metadata, std::function<void(DirectoryEntry const &)> const &cb) const;
+
     /*
      * Copy a directory to a new path, optionally recursively.
      */
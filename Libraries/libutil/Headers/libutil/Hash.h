@@ -0,0 +1,92 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef __libutil_Hash_h
+#define __libutil_Hash_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <ext/optional>
+
+namespace libutil {
+
+class Filesystem;
+
+/*
+ * Fast, non-cryptographic 128-bit hashing for cache keys and content
+ * hashes. The design follows XXH3's long input loop, with SIMD when it's
+ * available, but the output is not compatible with XXH3. Hashes are the
+ * same on all platforms, but use MD5 anywhere compatibility with Xcode
+ * matters.
+ */
+class Hash {
+public:
+    /*
+     * A 128-bit hash value.
+     */
+    struct Digest {
+        uint64_t low;
+        uint64_t high;
+
+        bool operator==(Digest const &other) const
+        { return low == other.low && high == other.high; }
+        bool operator!=(Digest const &other) const
+        { return !(*this == other); }
+
+        /*
+         * The digest as 32 lowercase hex characters.
+         */
+        std::string hex() const;
+    };
+
+private:
+    uint64_t _accumulators[8];
+    uint8_t  _buffer[64];
+    size_t   _buffered;
+    size_t   _stripes;
+    uint64_t _length;
+
+public:
+    Hash();
+
+public:
+    /*
+     * Add data to the hash.
+     */
+    void update(void const *data, size_t size);
+
+    /*
+     * Add a string to the hash, including a trailing NUL to separate it
+     * from any string added after.
+     */
+    void update(std::string const &string)
+    { update(string.c_str(), string.size() + 1); }
+
+    /*
+     * The hash of the data so far. More data can be added afterwards.
+     */
+    Digest digest() const;
+
+public:
+    /*
+     * Hash a block of data.
+     */
+    static Digest
+    Data(void const *data, size_t size);
+
+    /*
+     * Hash the contents of a file, mapping it into memory when possible.
+     */
+    static ext::optional<Digest>
+    File(Filesystem const *filesystem, std::string const &path);
+};
+
+}
+
+#endif  // !__libutil_Hash_h
@@ -0,0 +1,73 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef __libutil_MappedFile_h
+#define __libutil_MappedFile_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace libutil {
+
+/*
+ * The read-only contents of a file. Either mapped into memory, so the file
+ * is not copied, or held in a buffer where mapping is not possible.
+ */
+class MappedFile {
+private:
+    std::vector<uint8_t> _buffer;
+    void                *_map;
+    size_t               _size;
+
+public:
+    /*
+     * Contents held in a buffer.
+     */
+    explicit MappedFile(std::vector<uint8_t> &&buffer);
+
+    /*
+     * Contents mapped into memory. Takes ownership of the mapping.
+     */
+    MappedFile(void *map, size_t size);
+
+    ~MappedFile();
+
+    MappedFile(MappedFile const &) = delete;
+    MappedFile &operator=(MappedFile const &) = delete;
+
+public:
+    /*
+     * The contents. Valid for the lifetime of this object.
+     */
+    uint8_t const *data() const
+    { return (_map != nullptr ? static_cast<uint8_t const *>(_map) : _buffer.data()); }
+
+    /*
+     * The size of the contents, in bytes.
+     */
+    size_t size() const
+    { return _size; }
+
+    /*
+     * If the contents are mapped rather than held in a buffer.
+     */
+    bool mapped() const
+    { return _map != nullptr; }
+
+public:
+    /*
+     * Copy the contents into a buffer, for APIs that need one.
+     */
+    std::vector<uint8_t> copy() const
+    { return std::vector<uint8_t>(data(), data() + _size); }
+};
+
+}
+
+#endif  // !__libutil_MappedFile_h
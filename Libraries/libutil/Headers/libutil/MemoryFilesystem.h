@@ -72,6 +72,7 @@ public:
 public:
     virtual bool exists(std::string const &path) const;
     virtual ext::optional<Type> type(std::string const &path) const;
+    virtual ext::optional<Metadata> metadata(std::string const &path) const;
 
 public:
     virtual bool isReadable(std::string const &path) const;
@@ -101,6 +102,7 @@ public:
     virtual bool writeDirectoryPermissions(std::string const &path, Permissions::Operation operation, Permissions permissions, bool recursive);
     virtual bool createDirectory(std::string const &path, bool recursive);
     virtual bool readDirectory(std::string const &path, bool recursive, std::function<void(std::string const &)> const &cb) const;
+    virtual bool enumerateDirectory(std::string const &path, bool recursive, bool metadata, std::function<void(DirectoryEntry const &)> const &cb) const;
     virtual bool copyDirectory(std::string const &from, std::string const &to, bool recursive);
     virtual bool removeDirectory(std::string const &path, bool recursive);
 
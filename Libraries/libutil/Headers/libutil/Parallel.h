@@ -0,0 +1,39 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef __libutil_Parallel_h
+#define __libutil_Parallel_h
+
+#include <cstddef>
+#include <functional>
+
+namespace libutil {
+
+/*
+ * Runs independent work items concurrently on a pool of threads.
+ */
+class Parallel {
+public:
+    /*
+     * The number of threads to use by default. At least one.
+     */
+    static size_t DefaultThreadCount();
+
+public:
+    /*
+     * Call a function for each index in [0, count), returning once all calls
+     * have completed. Calls for different indexes can run concurrently, in any
+     * order, so each must only touch state for its own index. A thread count
+     * of zero uses the default; one runs all calls in order on this thread.
+     */
+    static void ForEach(size_t count, std::function<void(size_t)> const &cb, size_t threads = 0);
+};
+
+}
+
+#endif  // !__libutil_Parallel_h
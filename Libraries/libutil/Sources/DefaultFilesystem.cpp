@@ -8,9 +8,16 @@
 
 #include <libutil/DefaultFilesystem.h>
 #include <libutil/FSUtil.h>
+#include <libutil/Hash.h>
+#include <libutil/Parallel.h>
 #include <libutil/Relative.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <stack>
+#include <vector>
 #include <climits>
 #include <cstdlib>
 #include <cstdio>
@@ -24,8 +31,15 @@
 #include <libgen.h>
 #include <dirent.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 #if defined(__APPLE__) || defined(__FreeBSD__)
 #include <copyfile.h>
+#elif defined(__linux__)
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
 #endif
 #endif
 
@@ -33,6 +47,9 @@
 
 using libutil::DefaultFilesystem;
 using libutil::Filesystem;
+using libutil::FSUtil;
+using libutil::Hash;
+using libutil::MappedFile;
 using libutil::Permissions;
 
 #if _WIN32
@@ -118,6 +135,41 @@ exists(std::string const &path) const
 #endif
 }
 
+#if !_WIN32
+static ext::optional<Filesystem::Type>
+ModeType(mode_t mode)
+{
+    if (S_ISREG(mode)) {
+        return Filesystem::Type::File;
+    } else if (S_ISLNK(mode)) {
+        return Filesystem::Type::SymbolicLink;
+    } else if (S_ISDIR(mode)) {
+        return Filesystem::Type::Directory;
+    } else {
+        /* Unsupported file type, e.g. character or block device. */
+        return ext::nullopt;
+    }
+}
+
+static ext::optional<Filesystem::Metadata>
+StatMetadata(struct stat const &st)
+{
+    ext::optional<Filesystem::Type> type = ModeType(st.st_mode);
+    if (!type) {
+        return ext::nullopt;
+    }
+
+#if defined(__APPLE__)
+    struct timespec modified = st.st_mtimespec;
+#else
+    struct timespec modified = st.st_mtim;
+#endif
+    int64_t modificationTime = static_cast<int64_t>(modified.tv_sec) * INT64_C(1000000000) + modified.tv_nsec;
+
+    return Filesystem::Metadata { *type, static_cast<uint64_t>(st.st_size), modificationTime };
+}
+#endif
+
 ext::optional<Filesystem::Type> DefaultFilesystem::
 type(std::string const &path) const
 {
@@ -169,16 +221,40 @@ type(std::string const &path) const
         return ext::nullopt;
     }
 
-    if (S_ISREG(st.st_mode)) {
-        return Type::File;
-    } else if (S_ISLNK(st.st_mode)) {
-        return Type::SymbolicLink;
-    } else if (S_ISDIR(st.st_mode)) {
-        return Type::Directory;
-    } else {
-        /* Unsupported file type, e.g. character or block device. */
+    return ModeType(st.st_mode);
+#endif
+}
+
+ext::optional<Filesystem::Metadata> DefaultFilesystem::
+metadata(std::string const &path) const
+{
+#if _WIN32
+    ext::optional<Type> type = this->type(path);
+    if (!type) {
+        return ext::nullopt;
+    }
+
+    WideString wide = StringToWideString(path);
+
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExW(wide.c_str(), GetFileExInfoStandard, &data)) {
+        return ext::nullopt;
+    }
+
+    uint64_t size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+
+    /* File times are in 100 nanosecond intervals since 1601. */
+    uint64_t ticks = (static_cast<uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+    int64_t modificationTime = (static_cast<int64_t>(ticks) - INT64_C(116444736000000000)) * 100;
+
+    return Metadata { *type, size, modificationTime };
+#else
+    struct stat st;
+    if (::lstat(path.c_str(), &st) < 0) {
         return ext::nullopt;
     }
+
+    return StatMetadata(st);
 #endif
 }
 
@@ -561,6 +637,33 @@ read(std::vector<uint8_t> *contents, std::string const &path, size_t offset, ext
 #endif
 }
 
+std::unique_ptr<MappedFile> DefaultFilesystem::
+map(std::string const &path) const
+{
+#if !_WIN32
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    /* Empty files can't be mapped, and other types aren't worth it. */
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        size_t size = static_cast<size_t>(st.st_size);
+        void *map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+
+        if (map != MAP_FAILED) {
+            return std::unique_ptr<MappedFile>(new MappedFile(map, size));
+        }
+    } else {
+        ::close(fd);
+    }
+#endif
+
+    return Filesystem::map(path);
+}
+
 bool DefaultFilesystem::
 write(std::vector<uint8_t> const &contents, std::string const &path)
 {
@@ -582,26 +685,316 @@ write(std::vector<uint8_t> const &contents, std::string const &path)
     CloseHandle(handle);
     return true;
 #else
-    FILE *fp = std::fopen(path.c_str(), "wb");
-    if (fp == nullptr) {
-        return false;
+    return this->writeAtomically(path, false, false, [&contents](Append const &append) -> bool {
+        return append(contents.data(), contents.size());
+    });
+#endif
+}
+
+#if !_WIN32
+/*
+ * Buffers small pieces of contents before writing them to a descriptor.
+ */
+class DescriptorWriter {
+private:
+    int                  _fd;
+    std::vector<uint8_t> _buffer;
+    size_t               _buffered;
+
+public:
+    explicit DescriptorWriter(int fd) :
+        _fd      (fd),
+        _buffer  (64 * 1024),
+        _buffered(0)
+    {
+    }
+
+public:
+    bool append(uint8_t const *data, size_t size)
+    {
+        if (_buffered + size > _buffer.size()) {
+            if (!flush()) {
+                return false;
+            }
+            if (size >= _buffer.size()) {
+                return Write(_fd, data, size);
+            }
+        }
+
+        if (size > 0) {
+            memcpy(_buffer.data() + _buffered, data, size);
+            _buffered += size;
+        }
+        return true;
     }
 
-    size_t size = contents.size();
+    bool flush()
+    {
+        bool result = Write(_fd, _buffer.data(), _buffered);
+        _buffered = 0;
+        return result;
+    }
 
-    if (size > 0) {
-        if (std::fwrite(contents.data(), size, 1, fp) != 1) {
-            std::fclose(fp);
+private:
+    static bool
+    Write(int fd, uint8_t const *data, size_t size)
+    {
+        while (size > 0) {
+            ssize_t result = ::write(fd, data, size);
+            if (result < 0 && errno == EINTR) {
+                continue;
+            } else if (result < 0) {
+                return false;
+            }
+
+            data += result;
+            size -= static_cast<size_t>(result);
+        }
+
+        return true;
+    }
+};
+
+/*
+ * Write over an existing file, or create it, keeping its identity: used
+ * for anything that can't be replaced by renaming a new file over it.
+ */
+static bool
+WriteInPlace(Filesystem const *filesystem, std::string const &path, bool skipIfIdentical, bool synchronize, std::function<bool(Filesystem::Append const &)> const &cb)
+{
+    /* Compare before truncating, so the contents must be collected first. */
+    struct stat st;
+    if (skipIfIdentical && ::stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode)) {
+        std::vector<uint8_t> contents;
+        if (!cb([&contents](uint8_t const *data, size_t size) -> bool {
+            contents.insert(contents.end(), data, data + size);
+            return true;
+        })) {
             return false;
         }
+
+        if (contents.size() == static_cast<uint64_t>(st.st_size)) {
+            ext::optional<Hash::Digest> existing = Hash::File(filesystem, path);
+            if (existing && *existing == Hash::Data(contents.data(), contents.size())) {
+                return true;
+            }
+        }
+
+        return WriteInPlace(filesystem, path, false, synchronize, [&contents](Filesystem::Append const &append) -> bool {
+            return append(contents.data(), contents.size());
+        });
     }
 
-    std::fclose(fp);
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (fd < 0) {
+        return false;
+    }
+
+    DescriptorWriter writer = DescriptorWriter(fd);
+    bool success = cb([&writer](uint8_t const *data, size_t size) -> bool {
+        return writer.append(data, size);
+    });
+    success = (success && writer.flush() && (!synchronize || ::fsync(fd) == 0));
+    success &= (::close(fd) == 0);
+    return success;
+}
+#endif
+
+bool DefaultFilesystem::
+writeAtomically(std::string const &path, bool skipIfIdentical, bool synchronize, std::function<bool(Append const &)> const &cb)
+{
+#if _WIN32
+    return Filesystem::writeAtomically(path, skipIfIdentical, synchronize, cb);
+#else
+    /* Replace what a link points to, as writing through it would. */
+    std::string destination = path;
+    struct stat st;
+    bool exists = (::lstat(destination.c_str(), &st) == 0);
+    if (exists && S_ISLNK(st.st_mode)) {
+        std::string resolved = this->resolvePath(destination);
+        if (resolved.empty()) {
+            /* Broken link: create what it points to. */
+            return WriteInPlace(this, path, skipIfIdentical, synchronize, cb);
+        }
+
+        destination = resolved;
+        exists = (::lstat(destination.c_str(), &st) == 0);
+    }
+
+    if (exists && S_ISDIR(st.st_mode)) {
+        return false;
+    }
+
+    /*
+     * Only regular files can be replaced. Devices, pipes and sockets must
+     * be written to, and replacing a file with other links would separate
+     * it from them.
+     */
+    if (exists && (!S_ISREG(st.st_mode) || st.st_nlink > 1)) {
+        return WriteInPlace(this, destination, skipIfIdentical, synchronize, cb);
+    }
+
+    /* Write next to the destination, so it can be renamed into place. */
+    std::string directory = FSUtil::GetDirectoryName(destination);
+    if (directory.empty()) {
+        directory = ".";
+    }
+
+    static std::atomic<unsigned int> counter(0);
+    std::string temporary;
+    int fd = -1;
+    for (int attempt = 0; fd < 0 && attempt < 16; attempt++) {
+        temporary = directory + "/." + FSUtil::GetBaseName(destination) + "." + std::to_string(::getpid()) + "-" + std::to_string(counter++) + ".tmp";
+        fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0666);
+        if (fd < 0 && errno != EEXIST) {
+            break;
+        }
+    }
+    if (fd < 0) {
+        /* A writable file in a directory that isn't can still be written. */
+        if (exists) {
+            return WriteInPlace(this, destination, skipIfIdentical, synchronize, cb);
+        }
+        return false;
+    }
+
+    /* Keep the permissions of the file being replaced. */
+    if (exists) {
+        ::fchmod(fd, st.st_mode & 07777);
+    }
+
+    /* Only hash the contents while they could still match. */
+    bool compare = (skipIfIdentical && exists);
+    Hash hash;
+    uint64_t size = 0;
+
+    DescriptorWriter writer = DescriptorWriter(fd);
+    bool success = cb([&](uint8_t const *data, size_t count) -> bool {
+        size += count;
+        compare &= (size <= static_cast<uint64_t>(st.st_size));
+        if (compare) {
+            hash.update(data, count);
+        }
+
+        return writer.append(data, count);
+    });
+    success = (success && writer.flush() && (!synchronize || ::fsync(fd) == 0));
+    success &= (::close(fd) == 0);
+    if (!success) {
+        ::unlink(temporary.c_str());
+        return false;
+    }
+
+    /* Identical contents leave the file, and its modification time, alone. */
+    if (compare && size == static_cast<uint64_t>(st.st_size)) {
+        ext::optional<Hash::Digest> existing = Hash::File(this, destination);
+        if (existing && *existing == hash.digest()) {
+            ::unlink(temporary.c_str());
+            return true;
+        }
+    }
+
+    if (::rename(temporary.c_str(), destination.c_str()) != 0) {
+        ::unlink(temporary.c_str());
+        return false;
+    }
+
+    /* Make the rename itself durable. */
+    if (synchronize) {
+        int directoryFD = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (directoryFD >= 0) {
+            ::fsync(directoryFD);
+            ::close(directoryFD);
+        }
+    }
 
     return true;
 #endif
 }
 
+#if defined(__linux__)
+/*
+ * Copy between file descriptors with the fastest method available: share the
+ * data if the filesystem supports reflinks, then copy in the kernel, and only
+ * then through a buffer. Each method falls back to the next if the kernel or
+ * filesystem doesn't support it.
+ */
+static bool
+CopyFileContents(int in, int out, uint64_t size)
+{
+#if defined(FICLONE)
+    if (::ioctl(out, FICLONE, in) == 0) {
+        return true;
+    }
+#endif
+
+    uint64_t copied = 0;
+
+#if defined(SYS_copy_file_range)
+    while (copied < size) {
+        ssize_t result = ::syscall(SYS_copy_file_range, in, nullptr, out, nullptr, static_cast<size_t>(size - copied), 0u);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        } else if (result < 0 && copied == 0 && (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP)) {
+            break;
+        } else if (result < 0) {
+            return false;
+        } else if (result == 0) {
+            /* The file got shorter. */
+            return true;
+        }
+
+        copied += static_cast<uint64_t>(result);
+    }
+
+    if (copied >= size) {
+        return true;
+    }
+#endif
+
+    while (copied < size) {
+        ssize_t result = ::sendfile(out, in, nullptr, static_cast<size_t>(std::min<uint64_t>(size - copied, 0x7ffff000)));
+        if (result < 0 && errno == EINTR) {
+            continue;
+        } else if (result < 0 && copied == 0 && (errno == ENOSYS || errno == EINVAL)) {
+            break;
+        } else if (result < 0) {
+            return false;
+        } else if (result == 0) {
+            return true;
+        }
+
+        copied += static_cast<uint64_t>(result);
+    }
+
+    if (copied >= size) {
+        return true;
+    }
+
+    char buffer[64 * 1024];
+    while (true) {
+        ssize_t result = ::read(in, buffer, sizeof(buffer));
+        if (result < 0 && errno == EINTR) {
+            continue;
+        } else if (result < 0) {
+            return false;
+        } else if (result == 0) {
+            return true;
+        }
+
+        for (ssize_t written = 0; written < result;) {
+            ssize_t write = ::write(out, buffer + written, static_cast<size_t>(result - written));
+            if (write < 0 && errno == EINTR) {
+                continue;
+            } else if (write < 0) {
+                return false;
+            }
+            written += write;
+        }
+    }
+}
+#endif
+
 bool DefaultFilesystem::
 copyFile(std::string const &from, std::string const &to)
 {
@@ -658,6 +1051,60 @@ copyFile(std::string const &from, std::string const &to)
     ::copyfile_state_free(state);
 
     return true;
+#elif defined(__linux__)
+    struct stat st;
+    if (::lstat(from.c_str(), &st) != 0 || (!S_ISREG(st.st_mode) && !S_ISLNK(st.st_mode))) {
+        return false;
+    }
+
+    ext::optional<Type> toType = this->type(to);
+    if (toType) {
+        switch (*toType) {
+            case Type::File:
+                if (!this->removeFile(to)) {
+                    return false;
+                }
+                break;
+            case Type::SymbolicLink:
+                if (!this->removeSymbolicLink(to)) {
+                    return false;
+                }
+                break;
+            case Type::Directory:
+                return false;
+        }
+    }
+
+    /* Like copyfile(3) with COPYFILE_NOFOLLOW, copy links themselves. */
+    if (S_ISLNK(st.st_mode)) {
+        bool directory = false;
+        ext::optional<std::string> target = this->readSymbolicLink(from, &directory);
+        return (target && this->writeSymbolicLink(*target, to, directory));
+    }
+
+    int in = ::open(from.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        return false;
+    }
+
+    int out = ::open(to.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, st.st_mode & 07777);
+    if (out < 0) {
+        ::close(in);
+        return false;
+    }
+
+    bool success = CopyFileContents(in, out, static_cast<uint64_t>(st.st_size));
+
+    /* The mode passed to open() is limited by the umask. */
+    success = success && ::fchmod(out, st.st_mode & 07777) == 0;
+    success = (::close(out) == 0) && success;
+    ::close(in);
+
+    if (!success) {
+        ::unlink(to.c_str());
+    }
+
+    return success;
 #else
     return Filesystem::copyFile(from, to);
 #endif
@@ -1054,6 +1501,207 @@ readDirectory(std::string const &path, bool recursive, std::function<void(std::s
     return process(path, ext::nullopt);
 }
 
+#if !_WIN32
+/*
+ * Fill in the type and metadata of an entry read from a directory. Only
+ * looks up the entry if the directory didn't say enough.
+ */
+static void
+ReadEntryDetails(int fd, struct dirent const *entry, bool metadata, Filesystem::DirectoryEntry *result)
+{
+#if defined(DT_UNKNOWN)
+    switch (entry->d_type) {
+        case DT_REG: result->type = Filesystem::Type::File; break;
+        case DT_LNK: result->type = Filesystem::Type::SymbolicLink; break;
+        case DT_DIR: result->type = Filesystem::Type::Directory; break;
+        default: break;
+    }
+    bool known = (entry->d_type != DT_UNKNOWN);
+#else
+    bool known = false;
+#endif
+
+    if (metadata || !known) {
+        struct stat st;
+        if (::fstatat(fd, entry->d_name, &st, AT_SYMLINK_NOFOLLOW) == 0) {
+            result->type = ModeType(st.st_mode);
+            if (metadata) {
+                result->metadata = StatMetadata(st);
+            }
+        }
+    }
+}
+#endif
+
+bool DefaultFilesystem::
+enumerateDirectory(std::string const &path, bool recursive, bool metadata, std::function<void(DirectoryEntry const &)> const &cb) const
+{
+#if _WIN32
+    return Filesystem::enumerateDirectory(path, recursive, metadata, cb);
+#else
+    std::function<bool(std::string const &, ext::optional<std::string> const &)> process =
+        [&recursive, &metadata, &cb, &process](std::string const &absolute, ext::optional<std::string> const &relative) -> bool {
+        DIR *dp = ::opendir(absolute.c_str());
+        if (dp == nullptr) {
+            return false;
+        }
+
+        int fd = ::dirfd(dp);
+        std::vector<std::string> subdirectories;
+
+        /* Report children. */
+        while (struct dirent *entry = ::readdir(dp)) {
+            char const *name = entry->d_name;
+            if (::strcmp(name, ".") == 0 || ::strcmp(name, "..") == 0) {
+                continue;
+            }
+
+            DirectoryEntry result;
+            result.path = (relative ? *relative + "/" + name : name);
+            ReadEntryDetails(fd, entry, metadata, &result);
+
+            if (recursive && result.type == Type::Directory) {
+                subdirectories.push_back(name);
+            }
+
+            cb(result);
+        }
+
+        ::closedir(dp);
+
+        /* Process subdirectories. */
+        for (std::string const &name : subdirectories) {
+            std::string path = (relative ? *relative + "/" + name : name);
+            if (!process(absolute + "/" + name, path)) {
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    return process(path, ext::nullopt);
+#endif
+}
+
+bool DefaultFilesystem::
+walkDirectory(std::string const &path, bool metadata, std::function<void(DirectoryEntry const &)> const &cb) const
+{
+#if _WIN32
+    return Filesystem::walkDirectory(path, metadata, cb);
+#else
+    struct Directory {
+        int         fd;
+        std::string relative;
+    };
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    /*
+     * Directories waiting to be read, each already open so it's found
+     * relative to its parent. Past a limit, directories are read by the
+     * thread that found them instead, to bound the open descriptors.
+     */
+    static size_t const MaximumQueued = 256;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<Directory> queue = { { fd, std::string() } };
+    size_t active = 0;
+    std::atomic<bool> success(true);
+
+    std::function<void(Directory const &)> read = [&](Directory const &directory) {
+        DIR *dp = ::fdopendir(directory.fd);
+        if (dp == nullptr) {
+            ::close(directory.fd);
+            success = false;
+            return;
+        }
+
+        int fd = ::dirfd(dp);
+        while (struct dirent *entry = ::readdir(dp)) {
+            char const *name = entry->d_name;
+            if (::strcmp(name, ".") == 0 || ::strcmp(name, "..") == 0) {
+                continue;
+            }
+
+            DirectoryEntry result;
+            result.path = (directory.relative.empty() ? name : directory.relative + "/" + name);
+            ReadEntryDetails(fd, entry, metadata, &result);
+
+            cb(result);
+
+            if (result.type == Type::Directory) {
+                int child = ::openat(fd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+                if (child < 0) {
+                    success = false;
+                    continue;
+                }
+
+                Directory next = { child, result.path };
+
+                std::unique_lock<std::mutex> lock(mutex);
+                if (queue.size() < MaximumQueued) {
+                    queue.push_back(std::move(next));
+                    condition.notify_one();
+                } else {
+                    lock.unlock();
+                    read(next);
+                }
+            }
+        }
+
+        ::closedir(dp);
+    };
+
+    /*
+     * Most trees are small, so read on this thread to start with. Only
+     * start more threads once enough directories are waiting to be read.
+     */
+    static size_t const ParallelQueued = 8;
+
+    while (!queue.empty() && queue.size() < ParallelQueued) {
+        Directory directory = std::move(queue.back());
+        queue.pop_back();
+        read(directory);
+    }
+
+    if (queue.empty()) {
+        return success;
+    }
+
+    /* Each thread reads directories until none are queued or being read. */
+    size_t threads = Parallel::DefaultThreadCount();
+    Parallel::ForEach(threads, [&](size_t) {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            condition.wait(lock, [&] { return !queue.empty() || active == 0; });
+            if (queue.empty()) {
+                break;
+            }
+
+            Directory directory = std::move(queue.back());
+            queue.pop_back();
+            active++;
+
+            lock.unlock();
+            read(directory);
+            lock.lock();
+
+            active--;
+            if (active == 0 && queue.empty()) {
+                condition.notify_all();
+            }
+        }
+    }, threads);
+
+    return success;
+#endif
+}
+
 bool DefaultFilesystem::
 copyDirectory(std::string const &from, std::string const &to, bool recursive)
 {
@@ -0,0 +1,74 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <libutil/ExecutableCache.h>
+#include <libutil/Filesystem.h>
+#include <libutil/FSUtil.h>
+
+#include <algorithm>
+
+using libutil::ExecutableCache;
+using libutil::Filesystem;
+using libutil::FSUtil;
+
+ExecutableCache::
+ExecutableCache(bool missing) :
+    _missing(missing)
+{
+}
+
+ext::optional<std::string> ExecutableCache::
+find(Filesystem const *filesystem, std::string const &name, std::vector<std::string> const &paths)
+{
+    /* Paths can't contain a NUL, so it separates them unambiguously. */
+    std::string key = name;
+    for (std::string const &path : paths) {
+        key += '\0';
+        key += path;
+    }
+
+    auto it = _entries.find(key);
+    if (it != _entries.end()) {
+        return it->second.executable;
+    }
+
+    ext::optional<std::string> executable = filesystem->findExecutable(name, paths);
+    if (!executable && !_missing) {
+        return executable;
+    }
+
+    /* Normalize now, so invalidating doesn't need to. */
+    std::vector<std::string> normalized;
+    for (std::string const &path : paths) {
+        normalized.push_back(FSUtil::NormalizePath(path));
+    }
+
+    _entries[key] = { normalized, executable };
+    return executable;
+}
+
+void ExecutableCache::
+invalidate()
+{
+    _entries.clear();
+}
+
+void ExecutableCache::
+invalidate(std::string const &directory)
+{
+    std::string normalized = FSUtil::NormalizePath(directory);
+
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        std::vector<std::string> const &paths = it->second.paths;
+        if (std::any_of(paths.begin(), paths.end(), [&](std::string const &path) { return path == normalized; })) {
+            it = _entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
@@ -14,6 +14,7 @@
 
 using libutil::Filesystem;
 using libutil::FSUtil;
+using libutil::MappedFile;
 
 bool Filesystem::
 copyFile(std::string const &from, std::string const &to)
@@ -57,6 +58,68 @@ copySymbolicLink(std::string const &from, std::string const &to)
     return true;
 }
 
+bool Filesystem::
+enumerateDirectory(std::string const &path, bool recursive, bool metadata, std::function<void(DirectoryEntry const &)> const &cb) const
+{
+    return this->readDirectory(path, recursive, [this, &path, &metadata, &cb](std::string const &name) {
+        DirectoryEntry entry;
+        entry.path = name;
+
+        if (metadata) {
+            entry.metadata = this->metadata(path + "/" + name);
+            if (entry.metadata) {
+                entry.type = entry.metadata->type;
+            }
+        } else {
+            entry.type = this->type(path + "/" + name);
+        }
+
+        cb(entry);
+    });
+}
+
+bool Filesystem::
+writeAtomically(std::string const &path, bool skipIfIdentical, bool synchronize, std::function<bool(Append const &)> const &cb)
+{
+    std::vector<uint8_t> contents;
+    if (!cb([&contents](uint8_t const *data, size_t size) -> bool {
+        contents.insert(contents.end(), data, data + size);
+        return true;
+    })) {
+        return false;
+    }
+
+    if (skipIfIdentical) {
+        ext::optional<Metadata> metadata = this->metadata(path);
+        if (metadata && metadata->type == Type::File && metadata->size == contents.size()) {
+            std::vector<uint8_t> existing;
+            if (this->read(&existing, path) && existing == contents) {
+                return true;
+            }
+        }
+    }
+
+    /* Without a way to flush or replace atomically, write directly. */
+    return this->write(contents, path);
+}
+
+std::unique_ptr<MappedFile> Filesystem::
+map(std::string const &path) const
+{
+    std::vector<uint8_t> contents;
+    if (!this->read(&contents, path)) {
+        return nullptr;
+    }
+
+    return std::unique_ptr<MappedFile>(new MappedFile(std::move(contents)));
+}
+
+bool Filesystem::
+walkDirectory(std::string const &path, bool metadata, std::function<void(DirectoryEntry const &)> const &cb) const
+{
+    return this->enumerateDirectory(path, true, metadata, cb);
+}
+
 bool Filesystem::
 copyDirectory(std::string const &from, std::string const &to, bool recursive)
 {
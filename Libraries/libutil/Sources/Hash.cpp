@@ -0,0 +1,240 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <libutil/Hash.h>
+#include <libutil/Filesystem.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HASH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+using libutil::Hash;
+using libutil::Filesystem;
+using libutil::MappedFile;
+
+static uint64_t const Prime32_1 = 0x9E3779B1U;
+static uint64_t const Prime32_2 = 0x85EBCA77U;
+static uint64_t const Prime32_3 = 0xC2B2AE3DU;
+static uint64_t const Prime64_1 = 0x9E3779B185EBCA87ULL;
+static uint64_t const Prime64_2 = 0xC2B2AE3D27D4EB4FULL;
+static uint64_t const Prime64_3 = 0x165667B19E3779F9ULL;
+static uint64_t const Prime64_4 = 0x85EBCA77C2B2AE63ULL;
+static uint64_t const Prime64_5 = 0x27D4EB2F165667C5ULL;
+
+/*
+ * Keys mixed into each stripe. Generated with splitmix64. Each stripe of a
+ * block uses the keys starting one further along; the last eight scramble
+ * the accumulators at the end of each block.
+ */
+static uint64_t const Secret[24] = {
+    0xc5c61029296ce9d3ULL, 0x3652fa800f699288ULL, 0xd6fad78f33859e73ULL,
+    0xf6c45d8fda403951ULL, 0x5a2548e774507e75ULL, 0x882efcec4a7a72c7ULL,
+    0xfdf9280591509a41ULL, 0x2ac06b7b6a1906bbULL, 0x933ca49c3c729562ULL,
+    0xad067f19ef2e9b7dULL, 0x74cab5ac2c0ff6d2ULL, 0x787f9986b161b4c4ULL,
+    0xdebfcff8ebf2252bULL, 0x92ca63fa20ec3e24ULL, 0x9adf31b146e2d1e9ULL,
+    0x7e321149b7e7b449ULL, 0x796fe28d5d66d411ULL, 0x4fa5dec9f3a49cb0ULL,
+    0x7976a39bc63258e3ULL, 0xd520246dff90ceaaULL, 0x68929aeef829976eULL,
+    0xc09ef76f6c89fe42ULL, 0x6d9a9fe2dd9f3606ULL, 0x79e7eff34a11a482ULL,
+};
+
+static size_t const StripeSize = 64;
+static size_t const StripesPerBlock = 16;
+
+static inline uint64_t
+Read64(uint8_t const *p)
+{
+    uint64_t value;
+    ::memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+static inline void
+Accumulate(uint64_t *accumulators, uint8_t const *stripe, uint64_t const *secret)
+{
+#if HASH_SSE2
+    for (size_t i = 0; i < 4; i++) {
+        __m128i accumulator = _mm_loadu_si128(reinterpret_cast<__m128i const *>(accumulators + 2 * i));
+        __m128i data = _mm_loadu_si128(reinterpret_cast<__m128i const *>(stripe + 16 * i));
+        __m128i key = _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<__m128i const *>(secret + 2 * i)));
+
+        /* Multiply the low and high halves of each lane together. */
+        __m128i product = _mm_mul_epu32(key, _mm_shuffle_epi32(key, _MM_SHUFFLE(0, 3, 0, 1)));
+
+        /* Add each lane's data into the neighboring lane. */
+        __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+        accumulator = _mm_add_epi64(product, _mm_add_epi64(accumulator, swapped));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(accumulators + 2 * i), accumulator);
+    }
+#else
+    for (size_t i = 0; i < 8; i++) {
+        uint64_t data = Read64(stripe + 8 * i);
+        uint64_t key = data ^ secret[i];
+        accumulators[i ^ 1] += data;
+        accumulators[i] += (key & 0xFFFFFFFFULL) * (key >> 32);
+    }
+#endif
+}
+
+static inline void
+Scramble(uint64_t *accumulators)
+{
+    uint64_t const *secret = Secret + StripesPerBlock;
+    for (size_t i = 0; i < 8; i++) {
+        uint64_t accumulator = accumulators[i];
+        accumulator ^= accumulator >> 47;
+        accumulator ^= secret[i];
+        accumulator *= Prime32_1;
+        accumulators[i] = accumulator;
+    }
+}
+
+static inline uint64_t
+Multiply128Fold64(uint64_t lhs, uint64_t rhs)
+{
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+    uint64_t lo_lo = (lhs & 0xFFFFFFFFULL) * (rhs & 0xFFFFFFFFULL);
+    uint64_t hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFFULL);
+    uint64_t lo_hi = (lhs & 0xFFFFFFFFULL) * (rhs >> 32);
+    uint64_t hi_hi = (lhs >> 32) * (rhs >> 32);
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFULL) + lo_hi;
+    uint64_t upper = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+    uint64_t lower = (cross << 32) | (lo_lo & 0xFFFFFFFFULL);
+    return lower ^ upper;
+#endif
+}
+
+static inline uint64_t
+Avalanche(uint64_t value)
+{
+    value ^= value >> 37;
+    value *= 0x165667919E3779F9ULL;
+    value ^= value >> 32;
+    return value;
+}
+
+static inline uint64_t
+Merge(uint64_t const *accumulators, uint64_t const *secret, uint64_t start)
+{
+    uint64_t result = start;
+    for (size_t i = 0; i < 4; i++) {
+        result += Multiply128Fold64(accumulators[2 * i] ^ secret[2 * i], accumulators[2 * i + 1] ^ secret[2 * i + 1]);
+    }
+    return Avalanche(result);
+}
+
+std::string Hash::Digest::
+hex() const
+{
+    static char const digits[] = "0123456789abcdef";
+
+    std::string result = std::string(32, '0');
+    for (size_t i = 0; i < 16; i++) {
+        result[15 - i] = digits[(high >> (4 * i)) & 0xF];
+        result[31 - i] = digits[(low >> (4 * i)) & 0xF];
+    }
+    return result;
+}
+
+Hash::
+Hash() :
+    _accumulators { Prime32_3, Prime64_1, Prime64_2, Prime64_3, Prime64_4, Prime32_2, Prime64_5, Prime32_1 },
+    _buffered     (0),
+    _stripes      (0),
+    _length       (0)
+{
+}
+
+void Hash::
+update(void const *data, size_t size)
+{
+    uint8_t const *input = static_cast<uint8_t const *>(data);
+    _length += size;
+
+    auto consume = [this](uint8_t const *stripe) {
+        Accumulate(_accumulators, stripe, Secret + _stripes);
+        if (++_stripes == StripesPerBlock) {
+            Scramble(_accumulators);
+            _stripes = 0;
+        }
+    };
+
+    /* Finish a stripe started by a previous update. */
+    if (_buffered > 0) {
+        size_t count = std::min(StripeSize - _buffered, size);
+        ::memcpy(_buffer + _buffered, input, count);
+        _buffered += count;
+        input += count;
+        size -= count;
+
+        if (_buffered < StripeSize) {
+            return;
+        }
+
+        consume(_buffer);
+        _buffered = 0;
+    }
+
+    for (; size >= StripeSize; input += StripeSize, size -= StripeSize) {
+        consume(input);
+    }
+
+    if (size > 0) {
+        ::memcpy(_buffer, input, size);
+        _buffered = size;
+    }
+}
+
+Hash::Digest Hash::
+digest() const
+{
+    uint64_t accumulators[8];
+    ::memcpy(accumulators, _accumulators, sizeof(accumulators));
+
+    /* Pad the last partial stripe; the length distinguishes the padding. */
+    if (_buffered > 0) {
+        uint8_t stripe[StripeSize] = { 0 };
+        ::memcpy(stripe, _buffer, _buffered);
+        Accumulate(accumulators, stripe, Secret + _stripes);
+    }
+
+    Digest digest;
+    digest.low = Merge(accumulators, Secret + 1, _length * Prime64_1);
+    digest.high = Merge(accumulators, Secret + 13, ~(_length * Prime64_2));
+    return digest;
+}
+
+Hash::Digest Hash::
+Data(void const *data, size_t size)
+{
+    Hash hash;
+    hash.update(data, size);
+    return hash.digest();
+}
+
+ext::optional<Hash::Digest> Hash::
+File(Filesystem const *filesystem, std::string const &path)
+{
+    std::unique_ptr<MappedFile> contents = filesystem->map(path);
+    if (contents == nullptr) {
+        return ext::nullopt;
+    }
+
+    return Data(contents->data(), contents->size());
+}
@@ -0,0 +1,40 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <libutil/MappedFile.h>
+
+#if !_WIN32
+#include <sys/mman.h>
+#endif
+
+using libutil::MappedFile;
+
+MappedFile::
+MappedFile(std::vector<uint8_t> &&buffer) :
+    _buffer(std::move(buffer)),
+    _map   (nullptr),
+    _size  (_buffer.size())
+{
+}
+
+MappedFile::
+MappedFile(void *map, size_t size) :
+    _map (map),
+    _size(size)
+{
+}
+
+MappedFile::
+~MappedFile()
+{
+#if !_WIN32
+    if (_map != nullptr) {
+        ::munmap(_map, _size);
+    }
+#endif
+}
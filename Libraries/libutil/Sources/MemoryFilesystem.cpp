@@ -195,6 +195,25 @@ type(std::string const &path) const
     return type;
 }
 
+ext::optional<Filesystem::Metadata> MemoryFilesystem::
+metadata(std::string const &path) const
+{
+    ext::optional<Metadata> metadata;
+
+    if (!WalkPath<MemoryFilesystem::Entry const>(this, path, false, [&metadata](MemoryFilesystem::Entry const *parent, std::string const &name, MemoryFilesystem::Entry const *entry) -> MemoryFilesystem::Entry const * {
+        if (entry != nullptr) {
+            /* Modification times are not tracked. */
+            metadata = Metadata { entry->type(), entry->contents().size(), 0 };
+        }
+
+        return entry;
+    })) {
+        return ext::nullopt;
+    }
+
+    return metadata;
+}
+
 bool MemoryFilesystem::
 isReadable(std::string const &path) const
 {
@@ -448,6 +467,44 @@ readDirectory(std::string const &path, bool recursive, std::function<void(std::s
     });
 }
 
+bool MemoryFilesystem::
+enumerateDirectory(std::string const &path, bool recursive, bool metadata, std::function<void(DirectoryEntry const &)> const &cb) const
+{
+    std::function<void(ext::optional<std::string> const &, MemoryFilesystem::Entry const *)> process =
+        [&recursive, &metadata, &cb, &process](ext::optional<std::string> const &subpath, MemoryFilesystem::Entry const *entry) {
+        /* Report children. */
+        for (MemoryFilesystem::Entry const &child : entry->children()) {
+            std::string path = (subpath ? *subpath + "/" + child.name() : child.name());
+
+            /* Process subdirectories first. */
+            if (recursive) {
+                process(path, &child);
+            }
+
+            DirectoryEntry result;
+            result.path = path;
+            result.type = child.type();
+            if (metadata) {
+                /* Modification times are not tracked. */
+                result.metadata = Metadata { child.type(), child.contents().size(), 0 };
+            }
+
+            cb(result);
+        }
+    };
+
+    return WalkPath<MemoryFilesystem::Entry const>(this, path, false, [&process](MemoryFilesystem::Entry const *parent, std::string const &name, MemoryFilesystem::Entry const *entry) -> MemoryFilesystem::Entry const * {
+        if (entry != nullptr && entry->type() == Type::Directory) {
+            /* Found directory, process. */
+            process(ext::nullopt, entry);
+            return entry;
+        } else {
+            /* Did not exit or not a directory. */
+            return nullptr;
+        }
+    });
+}
+
 bool MemoryFilesystem::
 removeDirectory(std::string const &path, bool recursive)
 {
@@ -0,0 +1,62 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <libutil/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using libutil::Parallel;
+
+size_t Parallel::
+DefaultThreadCount()
+{
+    unsigned int count = std::thread::hardware_concurrency();
+    return (count > 0 ? count : 1);
+}
+
+void Parallel::
+ForEach(size_t count, std::function<void(size_t)> const &cb, size_t threads)
+{
+    if (threads == 0) {
+        threads = DefaultThreadCount();
+    }
+    threads = std::min(threads, count);
+
+    if (threads <= 1) {
+        for (size_t n = 0; n < count; n++) {
+            cb(n);
+        }
+        return;
+    }
+
+    /*
+     * Each worker takes the next unclaimed index until none are left; this
+     * balances work items of uneven cost. This thread works as well.
+     */
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t n = next++; n < count; n = next++) {
+            cb(n);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t n = 0; n < threads - 1; n++) {
+        workers.emplace_back(worker);
+    }
+
+    worker();
+
+    for (std::thread &thread : workers) {
+        thread.join();
+    }
+}
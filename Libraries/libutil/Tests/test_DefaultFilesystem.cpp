@@ -0,0 +1,331 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <libutil/DefaultFilesystem.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fcntl.h>
+#include <ftw.h>
+#include <mutex>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using libutil::DefaultFilesystem;
+using libutil::Filesystem;
+
+static int
+RemoveEntry(char const *path, struct stat const *st, int flag, struct FTW *ftw)
+{
+    return ::remove(path);
+}
+
+class DefaultFilesystemTest : public ::testing::Test {
+protected:
+    DefaultFilesystem filesystem;
+    std::string       root;
+
+protected:
+    void SetUp() override
+    {
+        char path[] = "/tmp/libutil-filesystem-XXXXXX";
+        ASSERT_NE(nullptr, ::mkdtemp(path));
+        root = path;
+    }
+
+    void TearDown() override
+    {
+        ::nftw(root.c_str(), &RemoveEntry, 16, FTW_DEPTH | FTW_PHYS);
+    }
+};
+
+static std::vector<uint8_t>
+Pattern(size_t size)
+{
+    std::vector<uint8_t> data;
+    data.reserve(size);
+    for (size_t n = 0; n < size; n++) {
+        data.push_back(static_cast<uint8_t>((n * 131) ^ (n >> 9)));
+    }
+    return data;
+}
+
+TEST_F(DefaultFilesystemTest, CopyFile)
+{
+    /* Larger than a single read, and not a multiple of a page. */
+    std::vector<uint8_t> contents = Pattern(1000003);
+    ASSERT_TRUE(filesystem.write(contents, root + "/from"));
+    ASSERT_EQ(0, ::chmod((root + "/from").c_str(), 0751));
+
+    ASSERT_TRUE(filesystem.copyFile(root + "/from", root + "/to"));
+    std::vector<uint8_t> copied;
+    ASSERT_TRUE(filesystem.read(&copied, root + "/to"));
+    EXPECT_EQ(contents, copied);
+
+    struct stat st;
+    ASSERT_EQ(0, ::stat((root + "/to").c_str(), &st));
+    EXPECT_EQ(0751, st.st_mode & 07777);
+
+    /* Overwrites files, but not directories. */
+    ASSERT_TRUE(filesystem.write(Pattern(10), root + "/from"));
+    ASSERT_TRUE(filesystem.copyFile(root + "/from", root + "/to"));
+    ASSERT_TRUE(filesystem.read(&copied, root + "/to"));
+    EXPECT_EQ(Pattern(10), copied);
+
+    ASSERT_TRUE(filesystem.createDirectory(root + "/directory", false));
+    EXPECT_FALSE(filesystem.copyFile(root + "/from", root + "/directory"));
+    EXPECT_FALSE(filesystem.copyFile(root + "/directory", root + "/other"));
+    EXPECT_FALSE(filesystem.copyFile(root + "/missing", root + "/other"));
+
+    /* Empty files. */
+    ASSERT_TRUE(filesystem.write(std::vector<uint8_t>(), root + "/empty"));
+    ASSERT_TRUE(filesystem.copyFile(root + "/empty", root + "/to"));
+    ASSERT_TRUE(filesystem.read(&copied, root + "/to"));
+    EXPECT_TRUE(copied.empty());
+}
+
+TEST_F(DefaultFilesystemTest, CopyFileSymbolicLink)
+{
+    ASSERT_TRUE(filesystem.write(Pattern(100), root + "/file"));
+    ASSERT_TRUE(filesystem.writeSymbolicLink("file", root + "/link", false));
+
+    /* Links are copied as links, replacing what was there. */
+    ASSERT_TRUE(filesystem.write(Pattern(10), root + "/to"));
+    ASSERT_TRUE(filesystem.copyFile(root + "/link", root + "/to"));
+    EXPECT_EQ(Filesystem::Type::SymbolicLink, filesystem.type(root + "/to"));
+    EXPECT_EQ(std::string("file"), filesystem.readSymbolicLink(root + "/to"));
+
+    /* Copying onto a link replaces the link rather than its target. */
+    ASSERT_TRUE(filesystem.write(Pattern(20), root + "/other"));
+    ASSERT_TRUE(filesystem.copyFile(root + "/other", root + "/to"));
+    EXPECT_EQ(Filesystem::Type::File, filesystem.type(root + "/to"));
+
+    std::vector<uint8_t> contents;
+    ASSERT_TRUE(filesystem.read(&contents, root + "/file"));
+    EXPECT_EQ(Pattern(100), contents);
+}
+
+TEST_F(DefaultFilesystemTest, EnumerateDirectory)
+{
+    ASSERT_TRUE(filesystem.write(Pattern(100), root + "/file"));
+    ASSERT_TRUE(filesystem.createDirectory(root + "/dir/sub", true));
+    ASSERT_TRUE(filesystem.write(Pattern(10), root + "/dir/sub/nested"));
+    ASSERT_TRUE(filesystem.writeSymbolicLink("dir", root + "/link", true));
+
+    std::vector<Filesystem::DirectoryEntry> entries;
+    EXPECT_TRUE(filesystem.enumerateDirectory(root, true, true, [&entries](Filesystem::DirectoryEntry const &entry) {
+        entries.push_back(entry);
+    }));
+    std::sort(entries.begin(), entries.end(), [](Filesystem::DirectoryEntry const &a, Filesystem::DirectoryEntry const &b) {
+        return a.path < b.path;
+    });
+
+    /* Links are not followed. */
+    ASSERT_EQ(5, entries.size());
+    EXPECT_EQ("dir", entries[0].path);
+    EXPECT_EQ(Filesystem::Type::Directory, entries[0].type);
+    EXPECT_EQ("dir/sub/nested", entries[2].path);
+    EXPECT_EQ(Filesystem::Type::File, entries[2].type);
+    EXPECT_EQ("link", entries[4].path);
+    EXPECT_EQ(Filesystem::Type::SymbolicLink, entries[4].type);
+
+    /* Metadata matches looking up each entry. */
+    for (Filesystem::DirectoryEntry const &entry : entries) {
+        ASSERT_TRUE(entry.metadata);
+        ext::optional<Filesystem::Metadata> metadata = filesystem.metadata(root + "/" + entry.path);
+        ASSERT_TRUE(metadata);
+        EXPECT_EQ(metadata->type, entry.metadata->type);
+        EXPECT_EQ(metadata->size, entry.metadata->size);
+        EXPECT_EQ(metadata->modificationTime, entry.metadata->modificationTime);
+    }
+
+    /* Only metadata when asked, and not for missing directories. */
+    entries.clear();
+    EXPECT_TRUE(filesystem.enumerateDirectory(root + "/dir", false, false, [&entries](Filesystem::DirectoryEntry const &entry) {
+        entries.push_back(entry);
+    }));
+    ASSERT_EQ(1, entries.size());
+    EXPECT_FALSE(entries[0].metadata);
+    EXPECT_FALSE(filesystem.enumerateDirectory(root + "/missing", false, false, [](Filesystem::DirectoryEntry const &entry) { }));
+}
+
+TEST_F(DefaultFilesystemTest, WalkDirectory)
+{
+    /* Wide and deep enough to spread across threads. */
+    std::vector<std::string> expected;
+    for (int n = 0; n < 20; n++) {
+        std::string directory = "dir" + std::to_string(n);
+        expected.push_back(directory);
+        for (int m = 0; m < 10; m++) {
+            std::string subdirectory = directory + "/sub" + std::to_string(m);
+            ASSERT_TRUE(filesystem.createDirectory(root + "/" + subdirectory, true));
+            ASSERT_TRUE(filesystem.write(Pattern(n + m), root + "/" + subdirectory + "/file"));
+            expected.push_back(subdirectory);
+            expected.push_back(subdirectory + "/file");
+        }
+    }
+    ASSERT_TRUE(filesystem.writeSymbolicLink("dir0", root + "/link", true));
+    expected.push_back("link");
+    std::sort(expected.begin(), expected.end());
+
+    std::mutex mutex;
+    std::vector<Filesystem::DirectoryEntry> entries;
+    EXPECT_TRUE(filesystem.walkDirectory(root, true, [&](Filesystem::DirectoryEntry const &entry) {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.push_back(entry);
+    }));
+    std::sort(entries.begin(), entries.end(), [](Filesystem::DirectoryEntry const &a, Filesystem::DirectoryEntry const &b) {
+        return a.path < b.path;
+    });
+
+    /* Every entry once, without following links. */
+    std::vector<std::string> paths;
+    for (Filesystem::DirectoryEntry const &entry : entries) {
+        paths.push_back(entry.path);
+        ASSERT_TRUE(entry.metadata);
+        EXPECT_EQ(filesystem.type(root + "/" + entry.path), entry.type);
+        if (entry.type == Filesystem::Type::File) {
+            EXPECT_EQ(filesystem.metadata(root + "/" + entry.path)->size, entry.metadata->size);
+        }
+    }
+    EXPECT_EQ(expected, paths);
+
+    EXPECT_FALSE(filesystem.walkDirectory(root + "/missing", false, [](Filesystem::DirectoryEntry const &entry) { }));
+}
+
+TEST_F(DefaultFilesystemTest, WalkDirectorySmall)
+{
+    /* Small enough to read without starting threads. */
+    ASSERT_TRUE(filesystem.createDirectory(root + "/a/b", true));
+    ASSERT_TRUE(filesystem.write(Pattern(1), root + "/a/b/file"));
+
+    std::vector<std::string> paths;
+    EXPECT_TRUE(filesystem.walkDirectory(root, false, [&](Filesystem::DirectoryEntry const &entry) {
+        paths.push_back(entry.path);
+    }));
+    EXPECT_EQ(std::vector<std::string>({ "a", "a/b", "a/b/file" }), paths);
+
+    paths.clear();
+    EXPECT_TRUE(filesystem.walkDirectory(root + "/a/b", false, [&](Filesystem::DirectoryEntry const &entry) {
+        paths.push_back(entry.path);
+    }));
+    EXPECT_EQ(std::vector<std::string>({ "file" }), paths);
+}
+
+TEST_F(DefaultFilesystemTest, Map)
+{
+    std::vector<uint8_t> contents = Pattern(100003);
+    ASSERT_TRUE(filesystem.write(contents, root + "/file"));
+
+    std::unique_ptr<libutil::MappedFile> mapped = filesystem.map(root + "/file");
+    ASSERT_NE(nullptr, mapped);
+    EXPECT_TRUE(mapped->mapped());
+    EXPECT_EQ(contents, mapped->copy());
+
+    /* Empty files can't be mapped, but still read. */
+    ASSERT_TRUE(filesystem.write(std::vector<uint8_t>(), root + "/empty"));
+    mapped = filesystem.map(root + "/empty");
+    ASSERT_NE(nullptr, mapped);
+    EXPECT_EQ(0, mapped->size());
+
+    EXPECT_EQ(nullptr, filesystem.map(root + "/missing"));
+}
+
+TEST_F(DefaultFilesystemTest, WriteAtomically)
+{
+    std::vector<uint8_t> contents = Pattern(200003);
+    auto chunks = [&contents](Filesystem::Append const &append) -> bool {
+        /* Uneven pieces, some larger than the buffer. */
+        for (size_t offset = 0, n = 0; offset < contents.size(); n++) {
+            size_t size = std::min<size_t>(contents.size() - offset, (n % 3 == 0 ? 70000 : 1000 + n));
+            if (!append(contents.data() + offset, size)) {
+                return false;
+            }
+            offset += size;
+        }
+        return true;
+    };
+
+    std::string path = root + "/file";
+    ASSERT_TRUE(filesystem.writeAtomically(path, true, true, chunks));
+    std::vector<uint8_t> written;
+    ASSERT_TRUE(filesystem.read(&written, path));
+    EXPECT_EQ(contents, written);
+
+    /* Identical contents leave the file in place. */
+    ASSERT_EQ(0, ::chmod(path.c_str(), 0750));
+    struct stat before;
+    ASSERT_EQ(0, ::stat(path.c_str(), &before));
+    ASSERT_TRUE(filesystem.writeAtomically(path, true, false, chunks));
+    struct stat after;
+    ASSERT_EQ(0, ::stat(path.c_str(), &after));
+    EXPECT_EQ(before.st_ino, after.st_ino);
+
+    /* Changed contents replace the file, keeping its permissions. */
+    contents.back() ^= 1;
+    ASSERT_TRUE(filesystem.writeAtomically(path, true, false, chunks));
+    ASSERT_EQ(0, ::stat(path.c_str(), &after));
+    EXPECT_NE(before.st_ino, after.st_ino);
+    EXPECT_EQ(0750, after.st_mode & 07777);
+    ASSERT_TRUE(filesystem.read(&written, path));
+    EXPECT_EQ(contents, written);
+
+    /* An abandoned write leaves the old contents, and nothing else. */
+    EXPECT_FALSE(filesystem.writeAtomically(path, false, false, [](Filesystem::Append const &append) -> bool {
+        uint8_t byte = 0;
+        return append(&byte, 1) && false;
+    }));
+    ASSERT_TRUE(filesystem.read(&written, path));
+    EXPECT_EQ(contents, written);
+
+    std::vector<std::string> entries;
+    ASSERT_TRUE(filesystem.readDirectory(root, false, [&entries](std::string const &name) {
+        entries.push_back(name);
+    }));
+    EXPECT_EQ(std::vector<std::string>({ "file" }), entries);
+}
+
+TEST_F(DefaultFilesystemTest, WriteInPlace)
+{
+    /* Pipes are written to, not replaced. */
+    std::string fifo = root + "/fifo";
+    ASSERT_EQ(0, ::mkfifo(fifo.c_str(), 0600));
+    int reader = ::open(fifo.c_str(), O_RDONLY | O_NONBLOCK);
+    ASSERT_GE(reader, 0);
+
+    std::vector<uint8_t> contents = Pattern(1000);
+    EXPECT_TRUE(filesystem.write(contents, fifo));
+
+    std::vector<uint8_t> received = std::vector<uint8_t>(2000);
+    EXPECT_EQ(static_cast<ssize_t>(contents.size()), ::read(reader, received.data(), received.size()));
+    received.resize(contents.size());
+    EXPECT_EQ(contents, received);
+    ::close(reader);
+
+    struct stat st;
+    ASSERT_EQ(0, ::lstat(fifo.c_str(), &st));
+    EXPECT_TRUE(S_ISFIFO(st.st_mode));
+
+    /* As are devices, through links. */
+    ASSERT_TRUE(filesystem.writeSymbolicLink("/dev/null", root + "/null", false));
+    EXPECT_TRUE(filesystem.write(contents, root + "/null"));
+    EXPECT_EQ(Filesystem::Type::SymbolicLink, filesystem.type(root + "/null"));
+    ASSERT_EQ(0, ::stat("/dev/null", &st));
+    EXPECT_TRUE(S_ISCHR(st.st_mode));
+
+    /* Hard links stay linked. */
+    ASSERT_TRUE(filesystem.write(Pattern(10), root + "/file"));
+    ASSERT_EQ(0, ::link((root + "/file").c_str(), (root + "/other").c_str()));
+    EXPECT_TRUE(filesystem.writeAtomically(root + "/file", true, false, [&contents](Filesystem::Append const &append) -> bool {
+        return append(contents.data(), contents.size());
+    }));
+    std::vector<uint8_t> linked;
+    ASSERT_TRUE(filesystem.read(&linked, root + "/other"));
+    EXPECT_EQ(contents, linked);
+}
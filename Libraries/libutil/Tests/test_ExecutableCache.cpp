@@ -0,0 +1,73 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <libutil/ExecutableCache.h>
+#include <libutil/MemoryFilesystem.h>
+
+using libutil::ExecutableCache;
+using libutil::MemoryFilesystem;
+
+static std::vector<uint8_t>
+Contents(std::string const &string)
+{
+    return std::vector<uint8_t>(string.begin(), string.end());
+}
+
+TEST(ExecutableCache, Find)
+{
+    auto filesystem = MemoryFilesystem({
+        MemoryFilesystem::Entry::Directory("bin1", { }),
+        MemoryFilesystem::Entry::Directory("bin2", {
+            MemoryFilesystem::Entry::File("tool", Contents("tool")),
+        }),
+    });
+    std::vector<std::string> paths = { filesystem.path("bin1"), filesystem.path("bin2") };
+
+    ExecutableCache cache;
+    EXPECT_EQ(filesystem.path("bin2/tool"), cache.find(&filesystem, "tool", paths));
+    EXPECT_EQ(ext::nullopt, cache.find(&filesystem, "other", paths));
+
+    /* Results are kept, even if they have changed. */
+    ASSERT_TRUE(filesystem.write(Contents("tool"), filesystem.path("bin1/tool")));
+    ASSERT_TRUE(filesystem.write(Contents("other"), filesystem.path("bin2/other")));
+    EXPECT_EQ(filesystem.path("bin2/tool"), cache.find(&filesystem, "tool", paths));
+    EXPECT_EQ(ext::nullopt, cache.find(&filesystem, "other", paths));
+
+    /* Different search paths are separate. */
+    EXPECT_EQ(filesystem.path("bin1/tool"), cache.find(&filesystem, "tool", { filesystem.path("bin1") }));
+
+    /* Only results that searched a changed directory are forgotten. */
+    cache.invalidate(filesystem.path("bin1"));
+    EXPECT_EQ(filesystem.path("bin1/tool"), cache.find(&filesystem, "tool", paths));
+    EXPECT_EQ(filesystem.path("bin2/other"), cache.find(&filesystem, "other", paths));
+
+    ASSERT_TRUE(filesystem.removeFile(filesystem.path("bin1/tool")));
+    cache.invalidate(filesystem.path("bin3"));
+    EXPECT_EQ(filesystem.path("bin1/tool"), cache.find(&filesystem, "tool", paths));
+    cache.invalidate();
+    EXPECT_EQ(filesystem.path("bin2/tool"), cache.find(&filesystem, "tool", paths));
+}
+
+TEST(ExecutableCache, Missing)
+{
+    auto filesystem = MemoryFilesystem({
+        MemoryFilesystem::Entry::Directory("bin", { }),
+    });
+    std::vector<std::string> paths = { filesystem.path("bin") };
+
+    /* Executables that weren't found are searched for again. */
+    ExecutableCache cache = ExecutableCache(false);
+    EXPECT_EQ(ext::nullopt, cache.find(&filesystem, "tool", paths));
+    ASSERT_TRUE(filesystem.write(Contents("tool"), filesystem.path("bin/tool")));
+    EXPECT_EQ(filesystem.path("bin/tool"), cache.find(&filesystem, "tool", paths));
+
+    /* Found executables are still kept. */
+    ASSERT_TRUE(filesystem.removeFile(filesystem.path("bin/tool")));
+    EXPECT_EQ(filesystem.path("bin/tool"), cache.find(&filesystem, "tool", paths));
+}
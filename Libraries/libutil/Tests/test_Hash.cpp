@@ -0,0 +1,108 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <libutil/Hash.h>
+#include <libutil/DefaultFilesystem.h>
+
+#include <algorithm>
+#include <set>
+#include <vector>
+#include <unistd.h>
+
+using libutil::Hash;
+using libutil::DefaultFilesystem;
+
+static std::vector<uint8_t>
+Pattern(size_t size)
+{
+    std::vector<uint8_t> data;
+    data.reserve(size);
+    for (size_t n = 0; n < size; n++) {
+        data.push_back(static_cast<uint8_t>((n * 131) ^ (n >> 7)));
+    }
+    return data;
+}
+
+TEST(Hash, Streaming)
+{
+    /* Cross stripe and block boundaries with uneven chunks. */
+    std::vector<uint8_t> data = Pattern(5000);
+    Hash::Digest expected = Hash::Data(data.data(), data.size());
+
+    for (size_t chunk : { 1, 7, 63, 64, 65, 1023, 1024, 4999 }) {
+        Hash hash;
+        for (size_t offset = 0; offset < data.size(); offset += chunk) {
+            hash.update(data.data() + offset, std::min(chunk, data.size() - offset));
+        }
+        EXPECT_EQ(expected, hash.digest());
+    }
+}
+
+TEST(Hash, Distinct)
+{
+    std::vector<uint8_t> data = Pattern(2048);
+
+    /* Every prefix, including the empty one, hashes differently. */
+    std::set<std::string> hashes;
+    for (size_t size = 0; size <= data.size(); size++) {
+        hashes.insert(Hash::Data(data.data(), size).hex());
+    }
+    EXPECT_EQ(data.size() + 1, hashes.size());
+
+    /* Trailing zeros are not confused with padding. */
+    uint8_t zeros[2] = { 0, 0 };
+    EXPECT_NE(Hash::Data(zeros, 1), Hash::Data(zeros, 2));
+
+    /* Single bit changes change the hash. */
+    Hash::Digest base = Hash::Data(data.data(), data.size());
+    for (size_t bit = 0; bit < 64; bit++) {
+        std::vector<uint8_t> changed = data;
+        changed[bit * 31] ^= static_cast<uint8_t>(1 << (bit % 8));
+        EXPECT_NE(base, Hash::Data(changed.data(), changed.size()));
+    }
+}
+
+TEST(Hash, Strings)
+{
+    Hash first;
+    first.update(std::string("ab"));
+    first.update(std::string("c"));
+
+    Hash second;
+    second.update(std::string("a"));
+    second.update(std::string("bc"));
+
+    EXPECT_NE(first.digest(), second.digest());
+    EXPECT_EQ(32, first.digest().hex().size());
+}
+
+TEST(Hash, File)
+{
+    char path[] = "/tmp/libutil-hash-XXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+
+    std::vector<uint8_t> data = Pattern(100000);
+    ASSERT_EQ(static_cast<ssize_t>(data.size()), write(fd, data.data(), data.size()));
+    close(fd);
+
+    DefaultFilesystem filesystem;
+    ext::optional<Hash::Digest> digest = Hash::File(&filesystem, path);
+    ASSERT_TRUE(digest);
+    EXPECT_EQ(Hash::Data(data.data(), data.size()), *digest);
+
+    /* Empty files can't be mapped, but still hash. */
+    ASSERT_EQ(0, truncate(path, 0));
+    digest = Hash::File(&filesystem, path);
+    ASSERT_TRUE(digest);
+    EXPECT_EQ(Hash::Data(nullptr, 0), *digest);
+
+    unlink(path);
+    EXPECT_FALSE(Hash::File(&filesystem, path));
+}
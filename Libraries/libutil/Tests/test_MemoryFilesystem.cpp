@@ -60,6 +60,23 @@ TEST(MemoryFilesystem, Type)
     EXPECT_EQ(filesystem.type(filesystem.path("invalid1/invalid2")), ext::nullopt);
 }
 
+TEST(MemoryFilesystem, Metadata)
+{
+    auto filesystem = BasicFilesystem();
+
+    ext::optional<Filesystem::Metadata> file = filesystem.metadata(filesystem.path("dir1/file2"));
+    ASSERT_NE(ext::nullopt, file);
+    EXPECT_EQ(Filesystem::Type::File, file->type);
+    EXPECT_EQ(4, file->size);
+
+    ext::optional<Filesystem::Metadata> directory = filesystem.metadata(filesystem.path("dir2/dir3"));
+    ASSERT_NE(ext::nullopt, directory);
+    EXPECT_EQ(Filesystem::Type::Directory, directory->type);
+
+    EXPECT_EQ(ext::nullopt, filesystem.metadata(filesystem.path("invalid")));
+    EXPECT_EQ(ext::nullopt, filesystem.metadata(filesystem.path("invalid1/invalid2")));
+}
+
 TEST(MemoryFilesystem, IsReadable)
 {
     auto filesystem = BasicFilesystem();
@@ -163,6 +180,19 @@ TEST(MemoryFilesystem, Read)
     EXPECT_EQ(contents, Contents(""));
 }
 
+TEST(MemoryFilesystem, Map)
+{
+    auto filesystem = BasicFilesystem();
+
+    std::unique_ptr<libutil::MappedFile> mapped = filesystem.map(filesystem.path("dir1/file2"));
+    ASSERT_NE(nullptr, mapped);
+    EXPECT_FALSE(mapped->mapped());
+    EXPECT_EQ(Contents("two1"), mapped->copy());
+
+    EXPECT_EQ(nullptr, filesystem.map(filesystem.path("dir1")));
+    EXPECT_EQ(nullptr, filesystem.map(filesystem.path("invalid")));
+}
+
 TEST(MemoryFilesystem, Write)
 {
     auto filesystem = BasicFilesystem();
@@ -195,6 +225,30 @@ TEST(MemoryFilesystem, Write)
     EXPECT_FALSE(filesystem.exists(filesystem.path("invalid/new")));
 }
 
+TEST(MemoryFilesystem, WriteAtomically)
+{
+    auto filesystem = BasicFilesystem();
+
+    auto pieces = [](Filesystem::Append const &append) -> bool {
+        std::vector<uint8_t> first = Contents("new ");
+        std::vector<uint8_t> second = Contents("contents");
+        return append(first.data(), first.size()) && append(second.data(), second.size());
+    };
+
+    std::vector<uint8_t> contents;
+    EXPECT_TRUE(filesystem.writeAtomically(filesystem.path("file1"), true, false, pieces));
+    EXPECT_TRUE(filesystem.read(&contents, filesystem.path("file1")));
+    EXPECT_EQ(contents, Contents("new contents"));
+
+    /* Unchanged or abandoned writes keep the contents. */
+    EXPECT_TRUE(filesystem.writeAtomically(filesystem.path("file1"), true, false, pieces));
+    EXPECT_FALSE(filesystem.writeAtomically(filesystem.path("file1"), false, false, [](Filesystem::Append const &append) -> bool {
+        return false;
+    }));
+    EXPECT_TRUE(filesystem.read(&contents, filesystem.path("file1")));
+    EXPECT_EQ(contents, Contents("new contents"));
+}
+
 TEST(MemoryFilesystem, CopyFile)
 {
     std::vector<uint8_t> contents;
@@ -341,6 +395,37 @@ TEST(MemoryFilesystem, ReadDirectory)
     EXPECT_EQ(files, std::vector<std::string>());
 }
 
+TEST(MemoryFilesystem, EnumerateDirectory)
+{
+    auto filesystem = BasicFilesystem();
+
+    std::vector<Filesystem::DirectoryEntry> entries;
+    auto accumulate = [&entries](Filesystem::DirectoryEntry const &entry) {
+        entries.push_back(entry);
+    };
+
+    /* Same order as reading the directory, with types. */
+    EXPECT_TRUE(filesystem.enumerateDirectory(filesystem.path(""), true, false, accumulate));
+    ASSERT_EQ(6, entries.size());
+    EXPECT_EQ("dir1/file2", entries[1].path);
+    EXPECT_EQ(Filesystem::Type::File, entries[1].type);
+    EXPECT_EQ("dir2/dir3", entries[4].path);
+    EXPECT_EQ(Filesystem::Type::Directory, entries[4].type);
+    EXPECT_FALSE(entries[4].metadata);
+
+    /* Metadata only when asked. */
+    entries.clear();
+    EXPECT_TRUE(filesystem.enumerateDirectory(filesystem.path("dir1"), false, true, accumulate));
+    ASSERT_EQ(1, entries.size());
+    ASSERT_TRUE(entries[0].metadata);
+    EXPECT_EQ(4, entries[0].metadata->size);
+
+    /* Can't enumerate files. */
+    entries.clear();
+    EXPECT_FALSE(filesystem.enumerateDirectory(filesystem.path("file1"), false, false, accumulate));
+    EXPECT_TRUE(entries.empty());
+}
+
 TEST(MemoryFilesystem, CopyDirectory)
 {
     auto filesystem = BasicFilesystem();
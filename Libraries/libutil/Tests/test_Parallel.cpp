@@ -0,0 +1,48 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <libutil/Parallel.h>
+
+#include <vector>
+
+using libutil::Parallel;
+
+TEST(Parallel, ForEach)
+{
+    std::vector<size_t> results = std::vector<size_t>(1000, 0);
+    Parallel::ForEach(results.size(), [&](size_t n) {
+        results[n] += n * 2;
+    }, 4);
+
+    for (size_t n = 0; n < results.size(); n++) {
+        EXPECT_EQ(n * 2, results[n]);
+    }
+}
+
+TEST(Parallel, Serial)
+{
+    std::vector<size_t> order;
+    Parallel::ForEach(10, [&](size_t n) {
+        order.push_back(n);
+    }, 1);
+
+    ASSERT_EQ(10, order.size());
+    for (size_t n = 0; n < order.size(); n++) {
+        EXPECT_EQ(n, order[n]);
+    }
+}
+
+TEST(Parallel, Empty)
+{
+    bool called = false;
+    Parallel::ForEach(0, [&](size_t n) {
+        called = true;
+    });
+    EXPECT_FALSE(called);
+}
@@ -69,13 +69,16 @@ public:
 public:
     /*
      * Creates a build environment from the default configuration
-     * of each of the build environment's subcomponents.
+     * of each of the build environment's subcomponents. If a previous
+     * environment for the same developer root is provided, its
+     * specifications and SDKs are reused instead of loaded again.
      */
     static ext::optional<Environment>
     Default(
         process::User const *user,
         process::Context const *processContext,
-        libutil::Filesystem const *filesystem);
+        libutil::Filesystem *filesystem,
+        Environment const *previous = nullptr);
 };
 
 }
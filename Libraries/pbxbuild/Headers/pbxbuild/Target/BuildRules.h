@@ -11,6 +11,8 @@
 
 #include <pbxbuild/Base.h>
 
+#include <unordered_map>
+
 namespace pbxbuild {
 namespace Target {
 
@@ -55,9 +57,25 @@ private:
     BuildRule::vector _buildRules;
 
 private:
+    /*
+     * The position of the first rule for each file type and each pattern
+     * without wildcards, and the rules with wildcard patterns in order.
+     * The first rule in the list that matches a file is used.
+     */
+    std::unordered_map<pbxspec::PBX::FileType const *, size_t> _fileTypeRules;
+    std::unordered_map<std::string, size_t>                    _literalPatternRules;
+    std::vector<size_t>                                        _wildcardPatternRules;
+
+public:
+    /*
+     * Rules are used in order: the first that matches a file is used.
+     */
     BuildRules(BuildRule::vector const &buildRules);
 
 public:
+    /*
+     * Find the rule to process a file.
+     */
     BuildRule::shared_ptr
     resolve(pbxspec::PBX::FileType::shared_ptr const &fileType, std::string const &filePath) const;
 
@@ -51,12 +51,12 @@ targetEnvironment(Build::Environment const &buildEnvironment, pbxproj::PBX::Targ
 pbxproj::PBX::Target::shared_ptr Build::Context::
 resolveTargetIdentifier(pbxproj::PBX::Project::shared_ptr const &project, std::string const &identifier) const
 {
-    if (project == nullptr) {
+    if (project == nullptr || project->targets() == nullptr) {
         return nullptr;
     }
 
     pbxproj::PBX::Target::shared_ptr foundTarget = nullptr;
-    for (pbxproj::PBX::Target::shared_ptr const &target : project->targets()) {
+    for (pbxproj::PBX::Target::shared_ptr const &target : *project->targets()) {
         if (target->blueprintIdentifier() == identifier) {
             return target;
         }
@@ -68,12 +68,12 @@ resolveTargetIdentifier(pbxproj::PBX::Project::shared_ptr const &project, std::s
 ext::optional<std::pair<pbxproj::PBX::Target::shared_ptr, pbxproj::PBX::FileReference::shared_ptr>> Build::Context::
 resolveProductIdentifier(pbxproj::PBX::Project::shared_ptr const &project, std::string const &identifier) const
 {
-    if (project == nullptr) {
+    if (project == nullptr || project->targets() == nullptr) {
         return ext::nullopt;
     }
 
     pbxproj::PBX::Target::shared_ptr foundTarget = nullptr;
-    for (pbxproj::PBX::Target::shared_ptr const &target : project->targets()) {
+    for (pbxproj::PBX::Target::shared_ptr const &target : *project->targets()) {
         if (target->type() == pbxproj::PBX::Target::Type::Native) {
             pbxproj::PBX::NativeTarget::shared_ptr nativeTarget = std::static_pointer_cast<pbxproj::PBX::NativeTarget>(target);
             if (nativeTarget->productReference() != nullptr && nativeTarget->productReference()->blueprintIdentifier() == identifier) {
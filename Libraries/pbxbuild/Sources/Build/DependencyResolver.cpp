@@ -220,7 +220,12 @@ BuildProductPathsToTargets(WorkspaceContext const &workspaceContext)
      * where the product paths match, but the dependency is not through a container portal.
      */
     for (auto const &pair : workspaceContext.projects()) {
-        for (pbxproj::PBX::Target::shared_ptr const &target : pair.second->targets()) {
+        pbxproj::PBX::Target::vector const *targets = pair.second->targets();
+        if (targets == nullptr) {
+            continue;
+        }
+
+        for (pbxproj::PBX::Target::shared_ptr const &target : *targets) {
             if (target->type() != pbxproj::PBX::Target::Type::Native) {
                 /* Only native targets have products. */
                 continue;
@@ -286,13 +291,19 @@ resolveSchemeDependencies(Build::Context const &context) const
             continue;
         }
 
+        pbxproj::PBX::Target::vector const *projectTargets = project->targets();
+        if (projectTargets == nullptr) {
+            fprintf(stderr, "warning: couldn't load targets of project for build action entry\n");
+            continue;
+        }
+
         pbxproj::PBX::Target::shared_ptr target = context.resolveTargetIdentifier(project, reference->blueprintIdentifier());
         if (target == nullptr) {
             /*
              * If the blueprintIdentifier doesn't match, try the blueprintName. This can happen when a checked-in
              * scheme references a generated project. After regeneration, the scheme's blueprint identifier won't match.
              */
-            for (pbxproj::PBX::Target::shared_ptr const &projectTarget : project->targets()) {
+            for (pbxproj::PBX::Target::shared_ptr const &projectTarget : *projectTargets) {
                 if (reference->blueprintName() == projectTarget->name()) {
                     target = projectTarget;
                     break;
@@ -339,15 +350,21 @@ resolveLegacyDependencies(Build::Context const &context, bool allTargets, ext::o
         return graph;
     }
 
+    pbxproj::PBX::Target::vector const *targets = project->targets();
+    if (targets == nullptr) {
+        fprintf(stderr, "error: cannot resolve legacy dependencies without targets\n");
+        return graph;
+    }
+
     auto productNameToTarget = BuildProductPathsToTargets(context.workspaceContext());
 
     std::unordered_set<pbxproj::PBX::Target::shared_ptr> positional;
-    for (pbxproj::PBX::Target::shared_ptr const &target : project->targets()) {
+    for (pbxproj::PBX::Target::shared_ptr const &target : *targets) {
         if (!allTargets) {
             if (targetNames && std::find(targetNames->begin(), targetNames->end(), target->name()) == targetNames->end()) {
                 /* Building specific targets, and not this one. */
                 continue;
-            } else if (!targetNames && target != project->targets().front()) {
+            } else if (!targetNames && target != targets->front()) {
                 /* No specific target, build whatever the first target is. */
                 continue;
             }
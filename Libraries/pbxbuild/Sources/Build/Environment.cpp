@@ -9,6 +9,7 @@
 #include <pbxbuild/Build/Environment.h>
 #include <xcsdk/Configuration.h>
 #include <xcsdk/Environment.h>
+#include <xcsdk/SDK/Cache.h>
 #include <pbxsetting/DefaultSettings.h>
 #include <pbxsetting/Environment.h>
 #include <process/Context.h>
@@ -31,42 +32,58 @@ Environment(
 {
 }
 
-ext::optional<Build::Environment> Build::Environment::
-Default(process::User const *user, process::Context const *processContext, Filesystem const *filesystem)
+static bool
+LoadManagers(
+    process::User const *user,
+    process::Context const *processContext,
+    Filesystem *filesystem,
+    std::string const &developerRoot,
+    pbxspec::Manager::shared_ptr *specManagerOut,
+    std::shared_ptr<xcsdk::SDK::Manager> *sdkManagerOut)
 {
-    ext::optional<std::string> developerRoot = xcsdk::Environment::DeveloperRoot(user, processContext, filesystem);
-    if (!developerRoot) {
-        fprintf(stderr, "error: couldn't find developer dir\n");
-        return ext::nullopt;
-    }
-
-    auto specManager = pbxspec::Manager::Create();
+    pbxspec::Manager::shared_ptr specManager = pbxspec::Manager::Create();
     if (specManager == nullptr) {
         fprintf(stderr, "error: couldn't create spec manager\n");
-        return ext::nullopt;
+        return false;
     }
 
     /*
      * Register global build rules.
      */
-    std::vector<std::string> buildRules = pbxspec::Manager::DeveloperBuildRules(*developerRoot);
+    std::vector<std::string> buildRules = pbxspec::Manager::DeveloperBuildRules(developerRoot);
     for (std::string const &path : buildRules) {
         if (filesystem->isReadable(path) && !specManager->registerBuildRules(filesystem, path)) {
             fprintf(stderr, "error: couldn't register build rules\n");
-            return ext::nullopt;
+            return false;
         }
     }
 
     /*
      * Register global specifications.
      */
-    specManager->registerDomains(filesystem, pbxspec::Manager::DefaultDomains(*developerRoot));
+    specManager->registerDomains(filesystem, pbxspec::Manager::DefaultDomains(developerRoot));
+
+    /*
+     * Load SDKs, reusing what earlier runs found if it is unchanged. With a
+     * warm cache all SDKs are loaded, so they stay cached; otherwise, only
+     * the SDKs that targets use are loaded.
+     */
+    std::unique_ptr<xcsdk::SDK::Cache> sdkCache;
+    bool sdkCacheWarm = false;
+    if (ext::optional<std::string> sdkCachePath = xcsdk::SDK::Cache::DefaultPath(user, processContext, developerRoot)) {
+        sdkCache = std::unique_ptr<xcsdk::SDK::Cache>(new xcsdk::SDK::Cache(filesystem, *sdkCachePath));
+        sdkCacheWarm = sdkCache->load();
+    }
 
     auto configuration = xcsdk::Configuration::Load(filesystem, xcsdk::Configuration::DefaultPaths(user, processContext));
-    auto sdkManager = xcsdk::SDK::Manager::Open(filesystem, *developerRoot, configuration);
+    std::shared_ptr<xcsdk::SDK::Manager> sdkManager = xcsdk::SDK::Manager::Open(filesystem, developerRoot, configuration, sdkCache.get(), !sdkCacheWarm);
     if (sdkManager == nullptr) {
         fprintf(stderr, "error: couldn't create SDK manager\n");
-        return ext::nullopt;
+        return false;
+    }
+
+    if (sdkCache != nullptr) {
+        sdkCache->store();
     }
 
     /*
@@ -81,7 +98,31 @@ Default(process::User const *user, process::Context const *processContext, Files
     /*
      * Register global specifications, but depend on platform-specific specifications.
      */
-    specManager->registerDomains(filesystem, pbxspec::Manager::PlatformDependentDomains(*developerRoot));
+    specManager->registerDomains(filesystem, pbxspec::Manager::PlatformDependentDomains(developerRoot));
+
+    *specManagerOut = specManager;
+    *sdkManagerOut = sdkManager;
+    return true;
+}
+
+ext::optional<Build::Environment> Build::Environment::
+Default(process::User const *user, process::Context const *processContext, Filesystem *filesystem, Environment const *previous)
+{
+    ext::optional<std::string> developerRoot = xcsdk::Environment::DeveloperRoot(user, processContext, filesystem);
+    if (!developerRoot) {
+        fprintf(stderr, "error: couldn't find developer dir\n");
+        return ext::nullopt;
+    }
+
+    pbxspec::Manager::shared_ptr specManager;
+    std::shared_ptr<xcsdk::SDK::Manager> sdkManager;
+    if (previous != nullptr && previous->sdkManager()->path() == *developerRoot) {
+        /* Specifications and SDKs only depend on the developer root. */
+        specManager = previous->specManager();
+        sdkManager = previous->sdkManager();
+    } else if (!LoadManagers(user, processContext, filesystem, *developerRoot, &specManager, &sdkManager)) {
+        return ext::nullopt;
+    }
 
     pbxspec::PBX::BuildSystem::shared_ptr buildSystem = specManager->buildSystem("com.apple.build-system.core", { "default" });
     if (buildSystem == nullptr) {
@@ -277,15 +277,8 @@ resolve(Phase::Environment const &phaseEnvironment, Phase::Context *phaseContext
     /*
      * Create the product structure.
      */
-    bool isBundle = false;
-    bool isFramework = false;
-    for (pbxspec::PBX::ProductType::shared_ptr productType = _productType; productType != nullptr; productType = productType->base()) {
-        if (productType->identifier() == "com.apple.product-type.framework") {
-            isFramework = true;
-        } else if (productType->identifier() == "com.apple.product-type.bundle") {
-            isBundle = true;
-        }
-    }
+    bool isBundle = (_productType != nullptr && _productType->isKindOf("com.apple.product-type.bundle"));
+    bool isFramework = (_productType != nullptr && _productType->isKindOf("com.apple.product-type.framework"));
     if (isBundle) {
         if (!ResolveBundleStructure(phaseEnvironment, phaseContext)) {
             return false;
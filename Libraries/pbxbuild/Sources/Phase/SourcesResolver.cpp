@@ -53,13 +53,7 @@ CopySwiftModules(Phase::Environment const &phaseEnvironment, Phase::Context *pha
     }
 
     // TODO(grp): Find a better way of finding if this is building a framework.
-    bool isFramework = false;
-    for (pbxspec::PBX::ProductType::shared_ptr productType = targetEnvironment.productType(); productType != nullptr; productType = productType->base()) {
-        if (productType->identifier() == "com.apple.product-type.framework") {
-            isFramework = true;
-            break;
-        }
-    }
+    bool isFramework = (targetEnvironment.productType() != nullptr && targetEnvironment.productType()->isKindOf("com.apple.product-type.framework"));
 
     for (Tool::SwiftModuleInfo &moduleInfo : toolContext->swiftModuleInfo()) {
         moduleInfo.copiedArtifacts().clear();
@@ -34,13 +34,7 @@ ShouldBundleSwiftRuntime(Tool::Context const *toolContext, pbxsetting::Environme
         /* Only check if there isn't embedded content: always need a runtime for embedded content. */
 
         // TODO(grp): Find a better way of finding if this is building a application.
-        bool isApplication = false;
-        for (pbxspec::PBX::ProductType::shared_ptr PT = productType; PT != nullptr; PT = PT->base()) {
-            if (PT->identifier() == "com.apple.product-type.application") {
-                isApplication = true;
-                break;
-            }
-        }
+        bool isApplication = (productType != nullptr && productType->isKindOf("com.apple.product-type.application"));
 
         /*
          * Only applications should bundle Swift libraries; frameworks or plugins will
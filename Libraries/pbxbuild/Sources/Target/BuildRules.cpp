@@ -10,6 +10,8 @@
 #include <libutil/FSUtil.h>
 #include <libutil/Wildcard.h>
 
+#include <algorithm>
+
 namespace Target = pbxbuild::Target;
 using libutil::FSUtil;
 using libutil::Wildcard;
@@ -28,27 +30,60 @@ Target::BuildRules::
 BuildRules(Target::BuildRules::BuildRule::vector const &buildRules) :
     _buildRules(buildRules)
 {
+    for (size_t n = 0; n < _buildRules.size(); n++) {
+        BuildRule::shared_ptr const &buildRule = _buildRules[n];
+
+        if (!buildRule->filePatterns().empty()) {
+            std::string const &pattern = buildRule->filePatterns();
+            if (pattern.find_first_of("*[") == std::string::npos) {
+                _literalPatternRules.insert({ pattern, n });
+            } else {
+                _wildcardPatternRules.push_back(n);
+            }
+        } else {
+            /* Earlier rules take precedence; insert doesn't replace them. */
+            for (pbxspec::PBX::FileType::shared_ptr const &fileType : buildRule->fileTypes()) {
+                _fileTypeRules.insert({ fileType.get(), n });
+            }
+        }
+    }
 }
 
 Target::BuildRules::BuildRule::shared_ptr Target::BuildRules::
 resolve(pbxspec::PBX::FileType::shared_ptr const &fileType, std::string const &filePath) const
 {
-    for (BuildRule::shared_ptr const &buildRule : _buildRules) {
-        if (!buildRule->filePatterns().empty()) {
-            if (Wildcard::Match(buildRule->filePatterns(), FSUtil::GetBaseName(filePath))) {
-                return buildRule;
+    size_t match = _buildRules.size();
+
+    /* A rule for the file type or any type it's based on. */
+    for (pbxspec::PBX::FileType::shared_ptr FT = fileType; FT != nullptr; FT = FT->base()) {
+        auto it = _fileTypeRules.find(FT.get());
+        if (it != _fileTypeRules.end()) {
+            match = std::min(match, it->second);
+        }
+    }
+
+    if (!_literalPatternRules.empty() || !_wildcardPatternRules.empty()) {
+        std::string name = FSUtil::GetBaseName(filePath);
+
+        auto it = _literalPatternRules.find(name);
+        if (it != _literalPatternRules.end()) {
+            match = std::min(match, it->second);
+        }
+
+        /* Only rules before the best match so far could be used instead. */
+        for (size_t n : _wildcardPatternRules) {
+            if (n >= match) {
+                break;
             }
-        } else {
-            pbxspec::PBX::FileType::vector const &fileTypes = buildRule->fileTypes();
-            for (pbxspec::PBX::FileType::shared_ptr FT = fileType; FT != nullptr; FT = FT->base()) {
-                if (std::find(fileTypes.begin(), fileTypes.end(), FT) != fileTypes.end()) {
-                    return buildRule;
-                }
+
+            if (Wildcard::Match(_buildRules[n]->filePatterns(), name)) {
+                match = n;
+                break;
             }
         }
     }
 
-    return nullptr;
+    return (match < _buildRules.size() ? _buildRules[match] : nullptr);
 }
 
 static Target::BuildRules::BuildRule::shared_ptr
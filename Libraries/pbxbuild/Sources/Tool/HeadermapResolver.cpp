@@ -104,6 +104,12 @@ resolve(
 
     pbxproj::PBX::Project::shared_ptr project = target->project();
 
+    /* The target being built is one of these, so they're already parsed. */
+    pbxproj::PBX::Target::vector const *projectTargets = project->targets();
+    if (projectTargets == nullptr) {
+        return;
+    }
+
     std::vector<std::string> headermapSearchPaths = HeadermapSearchPaths(_specManager, compilerEnvironment, target, toolContext->searchPaths(), toolContext->workingDirectory());
     for (std::string const &path : headermapSearchPaths) {
         Filesystem::GetDefaultUNSAFE()->readDirectory(path, false, [&](std::string const &fileName) -> bool {
@@ -134,7 +140,7 @@ resolve(
         }
     }
 
-    for (pbxproj::PBX::Target::shared_ptr const &projectTarget : project->targets()) {
+    for (pbxproj::PBX::Target::shared_ptr const &projectTarget : *projectTargets) {
        for (pbxproj::PBX::BuildPhase::shared_ptr const &buildPhase : projectTarget->buildPhases()) {
             if (buildPhase->type() != pbxproj::PBX::BuildPhase::Type::Headers) {
                 continue;
@@ -13,6 +13,9 @@
 #include <libutil/Filesystem.h>
 #include <libutil/FSUtil.h>
 
+#include <algorithm>
+#include <mutex>
+
 namespace Tool = pbxbuild::Tool;
 using libutil::Filesystem;
 using libutil::FSUtil;
@@ -55,18 +58,32 @@ AppendPaths(std::vector<std::string> *args, pbxsetting::Environment const &envir
             args->push_back(root);
 
             std::string absoluteRoot = FSUtil::ResolveRelativePath(root, workingDirectory);
-            filesystem->readDirectory(absoluteRoot, true, [&](std::string const &relative) -> bool {
+            std::mutex mutex;
+            std::vector<std::string> subdirectories;
+            filesystem->walkDirectory(absoluteRoot, false, [&](Filesystem::DirectoryEntry const &entry) {
                 // TODO(grp): Use build settings for included and excluded recursive paths.
                 // Included: INCLUDED_RECURSIVE_SEARCH_PATH_SUBDIRECTORIES
                 // Excluded: EXCLUDED_RECURSIVE_SEARCH_PATH_SUBDIRECTORIES
                 // Follow: RECURSIVE_SEARCH_PATHS_FOLLOW_SYMLINKS
 
-                std::string absolute = absoluteRoot + "/" + relative;
-                if (filesystem->type(absolute) == Filesystem::Type::Directory) {
-                    args->push_back(root + "/" + relative);
+                if (entry.type == Filesystem::Type::Directory) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    subdirectories.push_back(entry.path);
                 }
-                return true;
             });
+
+            /*
+             * Subdirectories are found in no particular order. Keep the arguments
+             * stable, and shallower directories first, as a serial search would.
+             */
+            std::sort(subdirectories.begin(), subdirectories.end(), [](std::string const &a, std::string const &b) -> bool {
+                size_t adepth = std::count(a.begin(), a.end(), '/');
+                size_t bdepth = std::count(b.begin(), b.end(), '/');
+                return (adepth != bdepth ? adepth < bdepth : a < b);
+            });
+            for (std::string const &subdirectory : subdirectories) {
+                args->push_back(root + "/" + subdirectory);
+            }
         } else {
             args->push_back(path);
         }
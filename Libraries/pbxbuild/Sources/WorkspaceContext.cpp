@@ -10,11 +10,13 @@
 #include <pbxsetting/Environment.h>
 #include <libutil/Filesystem.h>
 #include <libutil/FSUtil.h>
+#include <libutil/Parallel.h>
 
 using pbxbuild::WorkspaceContext;
 using pbxbuild::DerivedDataHash;
 using libutil::Filesystem;
 using libutil::FSUtil;
+using libutil::Parallel;
 
 WorkspaceContext::
 WorkspaceContext(
@@ -135,25 +137,45 @@ IterateWorkspaceFiles(xcworkspace::XC::Workspace::shared_ptr const &workspace, s
 }
 
 static void
-LoadWorkspaceProjects(Filesystem const *filesystem, std::vector<pbxproj::PBX::Project::shared_ptr> *projects, xcworkspace::XC::Workspace::shared_ptr const &workspace)
+LoadProjects(Filesystem const *filesystem, std::vector<pbxproj::PBX::Project::shared_ptr> *projects, std::vector<std::string> const &paths)
 {
     /*
-     * Load all the projects in the workspace.
+     * Each project is independent, so open them concurrently. Add them in
+     * the order of the paths so the result doesn't depend on timing.
      */
-    IterateWorkspaceFiles(workspace, [&](xcworkspace::XC::FileRef::shared_ptr const &ref) {
-        std::string path = ref->resolve(workspace);
+    std::vector<pbxproj::PBX::Project::shared_ptr> opened = std::vector<pbxproj::PBX::Project::shared_ptr>(paths.size());
+    Parallel::ForEach(paths.size(), [&](size_t n) {
+        opened[n] = pbxproj::PBX::Project::Open(filesystem, paths[n]);
+    });
 
-        pbxproj::PBX::Project::shared_ptr project = pbxproj::PBX::Project::Open(filesystem, path);
+    for (pbxproj::PBX::Project::shared_ptr const &project : opened) {
         if (project != nullptr) {
             projects->push_back(project);
         }
+    }
+}
+
+static void
+LoadWorkspaceProjects(Filesystem const *filesystem, std::vector<pbxproj::PBX::Project::shared_ptr> *projects, xcworkspace::XC::Workspace::shared_ptr const &workspace)
+{
+    /*
+     * Find all the projects in the workspace.
+     */
+    std::vector<std::string> paths;
+    IterateWorkspaceFiles(workspace, [&](xcworkspace::XC::FileRef::shared_ptr const &ref) {
+        paths.push_back(ref->resolve(workspace));
     });
+
+    /*
+     * Load all the projects in the workspace.
+     */
+    LoadProjects(filesystem, projects, paths);
 }
 
 static void
 LoadConfigurationFiles(
     Filesystem const *filesystem,
-    std::unordered_map<pbxproj::XC::BuildConfiguration::shared_ptr, pbxsetting::XC::Config> *configs,
+    std::vector<std::pair<pbxproj::XC::BuildConfiguration::shared_ptr, pbxsetting::XC::Config>> *configs,
     pbxsetting::Environment const &environment,
     pbxproj::XC::ConfigurationList::shared_ptr const &configurationList)
 {
@@ -170,7 +192,7 @@ LoadConfigurationFiles(
 
             /* Load the configuration file. */
             if (ext::optional<pbxsetting::XC::Config> configuration = pbxsetting::XC::Config::Load(filesystem, environment, configurationPath)) {
-                configs->insert({ buildConfiguration, *configuration });
+                configs->push_back({ buildConfiguration, *configuration });
             }
         }
     }
@@ -184,12 +206,23 @@ LoadNestedProjects(
     pbxsetting::Environment const &baseEnvironment,
     std::vector<pbxproj::PBX::Project::shared_ptr> const &rootProjects)
 {
-    std::vector<pbxproj::PBX::Project::shared_ptr> nestedProjects;
+    /*
+     * The configuration files and nested project paths found in each project.
+     */
+    struct ProjectContents {
+        std::vector<std::pair<pbxproj::XC::BuildConfiguration::shared_ptr, pbxsetting::XC::Config>> configs;
+        std::vector<std::string> projectPaths;
+    };
 
     /*
-     * Load all nested projects recursively.
+     * Load the configuration files and find the nested projects of each
+     * project. This is independent per project, so runs concurrently.
      */
-    for (pbxproj::PBX::Project::shared_ptr const &project : rootProjects) {
+    std::vector<ProjectContents> contents = std::vector<ProjectContents>(rootProjects.size());
+    Parallel::ForEach(rootProjects.size(), [&](size_t n) {
+        pbxproj::PBX::Project::shared_ptr const &project = rootProjects[n];
+        ProjectContents *projectContents = &contents[n];
+
         /*
          * Determine the settings environment to find the project paths. This may not be complete,
          * but it's unclear exactly what settings are available here. Notably, we don't yet know what
@@ -201,9 +234,11 @@ LoadNestedProjects(
         /*
          * Load project and target configurations.
          */
-        LoadConfigurationFiles(filesystem, configs, environment, project->buildConfigurationList());
-        for (pbxproj::PBX::Target::shared_ptr const &target : project->targets()) {
-            LoadConfigurationFiles(filesystem, configs, environment, target->buildConfigurationList());
+        LoadConfigurationFiles(filesystem, &projectContents->configs, environment, project->buildConfigurationList());
+        if (pbxproj::PBX::Target::vector const *targets = project->targets()) {
+            for (pbxproj::PBX::Target::shared_ptr const &target : *targets) {
+                LoadConfigurationFiles(filesystem, &projectContents->configs, environment, target->buildConfigurationList());
+            }
         }
 
         /*
@@ -211,18 +246,22 @@ LoadNestedProjects(
          */
         for (pbxproj::PBX::Project::ProjectReference const &projectReference : project->projectReferences()) {
             pbxproj::PBX::FileReference::shared_ptr const &projectFileReference = projectReference.projectReference();
-            std::string projectPath = environment.expand(projectFileReference->resolve());
-
-            /*
-             * Load the project.
-             */
-            pbxproj::PBX::Project::shared_ptr project = pbxproj::PBX::Project::Open(filesystem, projectPath);
-            if (project != nullptr) {
-                nestedProjects.push_back(project);
-            }
+            projectContents->projectPaths.push_back(environment.expand(projectFileReference->resolve()));
         }
+    });
+
+    std::vector<std::string> projectPaths;
+    for (ProjectContents const &projectContents : contents) {
+        configs->insert(projectContents.configs.begin(), projectContents.configs.end());
+        projectPaths.insert(projectPaths.end(), projectContents.projectPaths.begin(), projectContents.projectPaths.end());
     }
 
+    /*
+     * Load all of the nested projects at this level together.
+     */
+    std::vector<pbxproj::PBX::Project::shared_ptr> nestedProjects;
+    LoadProjects(filesystem, &nestedProjects, projectPaths);
+
     /*
      * Append the nested projects. This has to be after the loop as `rootProjects` might alias `projects`.
      */
@@ -240,10 +279,17 @@ static void
 LoadProjectSchemes(Filesystem const *filesystem, std::string const &userName, std::vector<xcscheme::SchemeGroup::shared_ptr> *schemeGroups, std::vector<pbxproj::PBX::Project::shared_ptr> const &projects)
 {
     /*
-     * Load the schemes inside the projects.
+     * Load the schemes inside the projects. Each project's schemes are
+     * opened serially, as the projects already run in parallel.
      */
-    for (pbxproj::PBX::Project::shared_ptr const &project : projects) {
-        xcscheme::SchemeGroup::shared_ptr projectGroup = xcscheme::SchemeGroup::Open(filesystem, userName, project->basePath(), project->projectFile(), project->name());
+    std::vector<xcscheme::SchemeGroup::shared_ptr> projectGroups = std::vector<xcscheme::SchemeGroup::shared_ptr>(projects.size());
+    Parallel::ForEach(projects.size(), [&](size_t n) {
+        pbxproj::PBX::Project::shared_ptr const &project = projects[n];
+        size_t threads = (projects.size() > 1 ? 1 : 0);
+        projectGroups[n] = xcscheme::SchemeGroup::Open(filesystem, userName, project->basePath(), project->projectFile(), project->name(), threads);
+    });
+
+    for (xcscheme::SchemeGroup::shared_ptr const &projectGroup : projectGroups) {
         if (projectGroup != nullptr) {
             schemeGroups->push_back(projectGroup);
         }
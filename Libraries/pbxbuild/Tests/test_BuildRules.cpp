@@ -0,0 +1,106 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <pbxbuild/Target/BuildRules.h>
+#include <pbxspec/Manager.h>
+#include <libutil/MemoryFilesystem.h>
+
+namespace Target = pbxbuild::Target;
+using libutil::MemoryFilesystem;
+
+static std::vector<uint8_t>
+Contents(std::string const &string)
+{
+    return std::vector<uint8_t>(string.begin(), string.end());
+}
+
+static pbxspec::Manager::shared_ptr
+FileTypes()
+{
+    auto filesystem = MemoryFilesystem({
+        MemoryFilesystem::Entry::Directory("Specifications", {
+            MemoryFilesystem::Entry::File("Types.xcspec", Contents(
+                "("
+                "    { Type = FileType; Identifier = file; },"
+                "    { Type = FileType; Identifier = text; BasedOn = file; },"
+                "    { Type = FileType; Identifier = sourcecode.c; BasedOn = text; },"
+                "    { Type = FileType; Identifier = image; BasedOn = file; },"
+                ")")),
+        }),
+    });
+
+    pbxspec::Manager::shared_ptr manager = pbxspec::Manager::Create();
+    manager->registerDomains(&filesystem, { { "test", filesystem.path("Specifications") } });
+    return manager;
+}
+
+static Target::BuildRules::BuildRule::shared_ptr
+Rule(std::string const &filePatterns, pbxspec::PBX::FileType::vector const &fileTypes)
+{
+    return std::make_shared<Target::BuildRules::BuildRule>(filePatterns, fileTypes, nullptr, std::string(), std::vector<pbxsetting::Value>());
+}
+
+TEST(BuildRules, ListOrder)
+{
+    pbxspec::Manager::shared_ptr manager = FileTypes();
+    pbxspec::PBX::FileType::shared_ptr text = manager->fileType("text", { "test" });
+    pbxspec::PBX::FileType::shared_ptr source = manager->fileType("sourcecode.c", { "test" });
+    ASSERT_NE(nullptr, text);
+    ASSERT_NE(nullptr, source);
+
+    auto wildcard = Rule("*.c", { });
+    auto literal  = Rule("main.c", { });
+    auto type     = Rule(std::string(), { source });
+    auto later    = Rule(std::string(), { source });
+    auto rules    = Target::BuildRules({ wildcard, literal, type, later });
+
+    /* Each kind of rule wins when it comes first. */
+    EXPECT_EQ(wildcard, rules.resolve(source, "/src/main.c"));
+    EXPECT_EQ(literal, Target::BuildRules({ literal, wildcard, type }).resolve(source, "/src/main.c"));
+    EXPECT_EQ(type, Target::BuildRules({ type, literal, wildcard }).resolve(source, "/src/main.c"));
+    EXPECT_EQ(literal, Target::BuildRules({ later, literal, wildcard }).resolve(text, "/src/main.c"));
+
+    /* Later rules are used when earlier ones don't match. */
+    EXPECT_EQ(type, rules.resolve(source, "/src/main.m"));
+    EXPECT_EQ(nullptr, rules.resolve(text, "/src/main.m"));
+}
+
+TEST(BuildRules, BaseFileType)
+{
+    pbxspec::Manager::shared_ptr manager = FileTypes();
+    pbxspec::PBX::FileType::shared_ptr file = manager->fileType("file", { "test" });
+    pbxspec::PBX::FileType::shared_ptr text = manager->fileType("text", { "test" });
+    pbxspec::PBX::FileType::shared_ptr source = manager->fileType("sourcecode.c", { "test" });
+    pbxspec::PBX::FileType::shared_ptr image = manager->fileType("image", { "test" });
+    ASSERT_NE(nullptr, file);
+    ASSERT_EQ(text, source->base());
+
+    /* A rule for a base type applies, unless an earlier rule is more specific. */
+    auto textRule = Rule(std::string(), { text });
+    auto fileRule = Rule(std::string(), { file });
+    auto rules = Target::BuildRules({ textRule, fileRule });
+    EXPECT_EQ(textRule, rules.resolve(source, "/src/main.c"));
+    EXPECT_EQ(fileRule, rules.resolve(image, "/src/image.png"));
+
+    /* The first rule in the list wins, even for a base type. */
+    rules = Target::BuildRules({ fileRule, textRule });
+    EXPECT_EQ(fileRule, rules.resolve(source, "/src/main.c"));
+}
+
+TEST(BuildRules, UnclosedBracket)
+{
+    /* Without a closing bracket, the bracket is matched literally. */
+    auto bracket = Rule("file[1.c", { });
+    auto closed  = Rule("file[12].c", { });
+    auto rules = Target::BuildRules({ bracket, closed });
+    EXPECT_EQ(bracket, rules.resolve(nullptr, "/src/file[1.c"));
+    EXPECT_EQ(closed, rules.resolve(nullptr, "/src/file2.c"));
+    EXPECT_EQ(closed, rules.resolve(nullptr, "/src/file1.c"));
+    EXPECT_EQ(nullptr, rules.resolve(nullptr, "/src/file3.c"));
+}
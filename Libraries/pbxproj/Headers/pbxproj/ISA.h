@@ -9,6 +9,8 @@
 #ifndef __pbxproj_ISA_h
 #define __pbxproj_ISA_h
 
+#include <string>
+
 namespace pbxproj { namespace ISA {
 
 extern char const * const PBXAggregateTarget;
@@ -35,6 +37,12 @@ extern char const * const XCBuildConfiguration;
 extern char const * const XCConfigurationList;
 extern char const * const XCVersionGroup;
 
+/*
+ * Find the constant for an ISA name, to compare by pointer. Returns null
+ * if the ISA is not known.
+ */
+char const *Find(std::string const &isa);
+
 } }
 
 #endif  // !__pbxproj_ISA_h
@@ -33,7 +33,7 @@ public:
     { return _isSharedContext; }
 
 protected:
-    bool parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check) override;
+    bool parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check) override;
 
 public:
     static inline char const *Isa()
@@ -13,9 +13,9 @@
 
 #include <memory>
 #include <string>
-#include <unordered_set>
 
 namespace plist { class Dictionary; }
+namespace plist { namespace Keys { class Seen; } }
 
 namespace pbxproj { namespace PBX {
 
@@ -34,7 +34,7 @@ public:
     { return _children; }
 
 protected:
-    bool parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check) override;
+    bool parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check) override;
 };
 
 } }
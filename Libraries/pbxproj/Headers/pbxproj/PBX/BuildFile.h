@@ -38,7 +38,7 @@ public:
     { return _attributes; }
 
 protected:
-    bool parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check) override;
+    bool parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check) override;
 
 public:
     static inline char const *Isa()
@@ -69,7 +69,7 @@ public:
     { return _buildActionMask; }
 
 protected:
-    bool parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check) override;
+    bool parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check) override;
 };
 
 } }
@@ -61,7 +61,7 @@ public:
     pbxsetting::Value resolve(void) const;
 
 protected:
-    bool parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check) override;
+    bool parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check) override;
 };
 
 } }
@@ -13,10 +13,10 @@
 
 #include <memory>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
 namespace plist { class Dictionary; }
+namespace plist { namespace Keys { class Seen; } }
 namespace pbxproj { class Context; }
 
 namespace pbxproj { namespace PBX {
@@ -52,7 +52,7 @@ private:
     bool parseObject(Context &context, plist::Dictionary const *dict);
 
 protected:
-    virtual bool parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check);
+    virtual bool parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check);
 
 public:
     template <typename T>
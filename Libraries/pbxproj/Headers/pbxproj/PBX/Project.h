@@ -14,7 +14,10 @@
 #include <pbxproj/PBX/Target.h>
 #include <pbxproj/XC/ConfigurationList.h>
 
+#include <mutex>
+
 namespace libutil { class Filesystem; }
+namespace pbxproj { class DeferredContext; }
 
 namespace pbxproj { namespace PBX {
 
@@ -49,6 +52,7 @@ private:
     std::string                        _basePath;
     std::string                        _name;
     std::unordered_map<std::string, Object::shared_ptr> _blueprints;
+    mutable std::mutex                 _blueprintsMutex;
 
 private:
     XC::ConfigurationList::shared_ptr  _buildConfigurationList;
@@ -61,13 +65,29 @@ private:
     std::string                        _projectDirPath;
     std::string                        _projectRoot;
     std::vector<ProjectReference>      _projectReferences;
-    Target::vector                     _targets;
-    FileReference::vector              _fileReferences;
+
+private:
+    /*
+     * Targets, with their build phases and build files, are most of a
+     * project but aren't needed to open it. If the project was read
+     * lazily, they're parsed when first requested.
+     */
+    mutable Target::vector                            _targets;
+    mutable std::vector<std::string>                  _targetIdentifiers;
+    mutable std::shared_ptr<pbxproj::DeferredContext> _deferred;
+    mutable std::once_flag                            _targetsParsed;
+    mutable bool                                      _targetsValid;
+    mutable FileReference::vector                     _fileReferences;
 
 public:
     Project();
 
 public:
+    /*
+     * Open a project. Project files written by Xcode are read lazily,
+     * parsing each object only when it is used, and the targets only when
+     * they are requested. Other project files are parsed in full.
+     */
     static shared_ptr Open(libutil::Filesystem const *filesystem, std::string const &path);
 
 public:
@@ -109,8 +129,11 @@ public:
     { return _projectReferences; }
 
 public:
-    inline Target::vector const &targets() const
-    { return _targets; }
+    /*
+     * The targets, parsed when first requested if the project was read
+     * lazily. Returns null if they can't be parsed.
+     */
+    Target::vector const *targets() const;
 
 public:
     inline std::string const &name() const
@@ -128,11 +151,18 @@ public:
 protected:
     friend class pbxproj::Context;
     inline void cacheObject(Object::shared_ptr const &object)
-    { _blueprints[object->blueprintIdentifier()] = object; }
+    {
+        /* Targets are added when first requested, maybe from another thread. */
+        std::lock_guard<std::mutex> lock(_blueprintsMutex);
+        _blueprints[object->blueprintIdentifier()] = object;
+    }
 
 public:
-    inline FileReference::vector const &fileReferences() const
-    { return _fileReferences; }
+    /*
+     * The file references, including any only used by targets; so if the
+     * project was read lazily, this parses the targets.
+     */
+    FileReference::vector const &fileReferences() const;
 
 public:
     inline Object::shared_ptr resolveBuildableReference(std::string const &blueprintIdentifier) const
@@ -140,6 +170,10 @@ public:
         if (blueprintIdentifier.empty())
             return Object::shared_ptr();
 
+        /* Targets and what they contain are only found once parsed. */
+        (void)targets();
+
+        std::lock_guard<std::mutex> lock(_blueprintsMutex);
         auto I = _blueprints.find(blueprintIdentifier);
         if (I == _blueprints.end())
             return Object::shared_ptr();
@@ -151,7 +185,10 @@ public:
     pbxsetting::Level settings(void) const;
 
 protected:
-    bool parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check) override;
+    bool parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check) override;
+
+private:
+    static bool ParseTargets(Context &context, std::vector<std::string> const &identifiers, Target::vector *targets);
 
 public:
     static inline char const *Isa()
@@ -9,8 +9,9 @@
 #ifndef __pbxproj_Context_h
 #define __pbxproj_Context_h
 
-#include <pbxproj/PlistHelpers.h>
 #include <pbxproj/ISA.h>
+#include <pbxproj/ObjectReader.h>
+#include <pbxproj/ObjectTable.h>
 #include <plist/Dictionary.h>
 #include <plist/Object.h>
 #include <plist/String.h>
@@ -18,7 +19,7 @@
 
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 namespace pbxproj {
 
@@ -59,103 +60,119 @@ class VersionGroup;
 
 }
 
+class DeferredContext;
+
 class Context {
 public:
     //
-    // Parsing context
+    // Parsing context. Objects come from either a dictionary of all of the
+    // objects, or are read individually as they are used.
     //
     plist::Dictionary const *objects;
+    ObjectReader const      *reader;
+
+    //
+    // Set if an object that is used can't be read, which fails the parse.
+    //
+    bool                     unreadable;
+
+    //
+    // If set, the targets can be parsed later, when first requested.
+    //
+    DeferredContext         *deferred;
 
     //
     // The main project
     //
     std::shared_ptr<PBX::Project> project;
 
+private:
     //
-    // Cached values
+    // Every object, with the objects read but not yet parsed, and the
+    // objects parsed so far.
     //
-    std::unordered_map <std::string, std::shared_ptr <PBX::Project>>               projects;
-    std::unordered_map <std::string, std::shared_ptr <PBX::FileReference>>         fileReferences;
-    std::unordered_map <std::string, std::shared_ptr <PBX::ReferenceProxy>>        referenceProxies;
-    std::unordered_map <std::string, std::shared_ptr <PBX::Group>>                 groups;
-    std::unordered_map <std::string, std::shared_ptr <PBX::VariantGroup>>          variantGroups;
-    std::unordered_map <std::string, std::shared_ptr <PBX::NativeTarget>>          nativeTargets;
-    std::unordered_map <std::string, std::shared_ptr <PBX::AggregateTarget>>       aggregateTargets;
-    std::unordered_map <std::string, std::shared_ptr <PBX::LegacyTarget>>          legacyTargets;
-    std::unordered_map <std::string, std::shared_ptr <PBX::TargetDependency>>      targetDependencies;
-    std::unordered_map <std::string, std::shared_ptr <PBX::ContainerItemProxy>>    containerItemProxies;
-    std::unordered_map <std::string, std::shared_ptr <PBX::BuildFile>>             buildFiles;
-    std::unordered_map <std::string, std::shared_ptr <PBX::BuildRule>>             buildRules;
-    std::unordered_map <std::string, std::shared_ptr <PBX::HeadersBuildPhase>>     headersBuildPhases;
-    std::unordered_map <std::string, std::shared_ptr <PBX::SourcesBuildPhase>>     sourcesBuildPhases;
-    std::unordered_map <std::string, std::shared_ptr <PBX::ResourcesBuildPhase>>   resourcesBuildPhases;
-    std::unordered_map <std::string, std::shared_ptr <PBX::FrameworksBuildPhase>>  frameworksBuildPhases;
-    std::unordered_map <std::string, std::shared_ptr <PBX::CopyFilesBuildPhase>>   copyFilesBuildPhases;
-    std::unordered_map <std::string, std::shared_ptr <PBX::ShellScriptBuildPhase>> shellScriptBuildPhases;
-    std::unordered_map <std::string, std::shared_ptr <PBX::AppleScriptBuildPhase>> appleScriptBuildPhases;
-    std::unordered_map <std::string, std::shared_ptr <PBX::RezBuildPhase>>         rezBuildPhases;
-
-    std::unordered_map <std::string, std::shared_ptr <XC::BuildConfiguration>>     buildConfigurations;
-    std::unordered_map <std::string, std::shared_ptr <XC::ConfigurationList>>      configurationLists;
-    std::unordered_map <std::string, std::shared_ptr <XC::VersionGroup>>           versionGroups;
+    ObjectTable                    _table;
+    plist::Dictionary              _parsed;
 
 public:
     Context()
     {
+        objects = nullptr;
+        reader = nullptr;
+        unreadable = false;
+        deferred = nullptr;
         project = nullptr;
     }
 
-    inline void clear()
+    //
+    // Find the objects, once the source of the objects is set.
+    //
+    void index();
+
+    //
+    // The objects of a type that were parsed.
+    //
+    template <typename T>
+    inline std::vector <std::shared_ptr <T>> parsed()
     {
-        project = nullptr;
-        projects.clear();
-        fileReferences.clear();
-        referenceProxies.clear();
-        groups.clear();
-        variantGroups.clear();
-        nativeTargets.clear();
-        targetDependencies.clear();
-        containerItemProxies.clear();
-        buildFiles.clear();
-        buildRules.clear();
-        headersBuildPhases.clear();
-        sourcesBuildPhases.clear();
-        resourcesBuildPhases.clear();
-        frameworksBuildPhases.clear();
-        copyFilesBuildPhases.clear();
-        shellScriptBuildPhases.clear();
-        appleScriptBuildPhases.clear();
-        rezBuildPhases.clear();
-
-        buildConfigurations.clear();
-        configurationLists.clear();
-        versionGroups.clear();
+        std::vector <std::shared_ptr <T>> result;
+        _table.forEach([&](ObjectTable::Entry &entry) {
+            if (entry.isa == T::Isa() && entry.value != nullptr) {
+                result.push_back(std::static_pointer_cast <T> (entry.value));
+            }
+        });
+        return result;
     }
 
+    //
+    // Drop the project and the objects that contain other objects, keeping
+    // only what targets can refer to. Otherwise, a deferred context would
+    // keep the project that uses it alive.
+    //
+    void clearContainers();
+
     //
     // Helper functions
     //
+public:
+    //
+    // Check if an object exists, regardless of its type.
+    //
+    bool contains(std::string const &key) const;
+
+private:
+    //
+    // Find an object with a specific ISA. Objects that were already parsed
+    // return a placeholder, as only their identifier is needed.
+    //
+    plist::Dictionary const *object(std::string const &key, char const *isa);
+
+    //
+    // Drop an object that was read, once it has been parsed.
+    //
+    void release(ObjectTable::Entry *entry, bool parsed);
+
 private:
     inline plist::Dictionary const *get(std::string const &key,
-                                        std::string const &isa,
-                                        std::string *id = nullptr) const
+                                        char const *isa,
+                                        std::string *id = nullptr)
     {
         if (id != nullptr) {
             *id = key;
         }
-        return PlistDictionaryGetPBXObject(objects, key, isa);
+        return object(key, isa);
     }
 
 public:
     template <typename T>
     inline plist::Dictionary const *get(std::string const &key,
-                                       std::string *id = nullptr) const
+                                       std::string *id = nullptr)
     { return get(key, T::Isa(), id); }
 
 private:
     inline plist::Dictionary const *get(plist::Object const *objectKey,
-                                        std::string const &isa,
-                                        std::string *id = nullptr) const
+                                        char const *isa,
+                                        std::string *id = nullptr)
     {
         plist::String const *key = plist::CastTo <plist::String> (objectKey);
         if (key == nullptr)
@@ -164,72 +181,54 @@ private:
         if (id != nullptr) {
             *id = key->value();
         }
-        return PlistDictionaryGetPBXObject(objects, key->value(), isa);
+        return object(key->value(), isa);
     }
 
 public:
     template <typename T>
     inline plist::Dictionary const *get(plist::Object const *objectKey,
-                                        std::string *id = nullptr) const
+                                        std::string *id = nullptr)
     { return get(objectKey, T::Isa(), id); }
 
 private:
     inline plist::Dictionary const *indirect(plist::Keys::Unpack *unpack,
                                              std::string const &key,
-                                             std::string const &isa,
-                                             std::string *id = nullptr) const
+                                             char const *isa,
+                                             std::string *id = nullptr)
     {
-        return PlistDictionaryGetIndirectPBXObject(objects, unpack, key, isa, id);
+        return get(unpack->cast <plist::String> (key), isa, id);
     }
 
 public:
     template <typename T>
     inline plist::Dictionary const *indirect(plist::Keys::Unpack *unpack,
                                              std::string const &key,
-                                             std::string *id = nullptr) const
+                                             std::string *id = nullptr)
     {
         return indirect(unpack, key, T::Isa(), id);
     }
 
-private:
-    inline plist::Dictionary const *indirect(plist::Keys::Unpack *unpack,
-                                             plist::Object const *objectKey,
-                                             std::string const &isa,
-                                             std::string *id = nullptr) const
-    {
-        plist::String const *key = plist::CastTo <plist::String> (objectKey);
-        if (key == nullptr)
-            return nullptr;
-        else
-            return PlistDictionaryGetIndirectPBXObject(objects, unpack,
-                    key->value(), isa, id);
-    }
-
 public:
     template <typename T>
-    inline plist::Dictionary const *indirect(plist::Keys::Unpack *unpack,
-                                             plist::Object const *objectKey,
-                                             std::string *id = nullptr) const
-    {
-        return indirect(unpack, objectKey, T::Isa(), id);
-    }
-
-public:
-    template <typename T>
-    inline std::shared_ptr <T> parseObject(std::unordered_map <std::string, std::shared_ptr <T>> &cache,
-                                           std::string const &id,
+    inline std::shared_ptr <T> parseObject(std::string const &id,
                                            plist::Dictionary const *dict)
     {
-        auto I = cache.find(id);
-        if (I != cache.end())
-            return I->second;
+        ObjectTable::Entry *entry = _table.find(id);
+        if (entry == nullptr || entry->isa != T::Isa())
+            return nullptr;
+
+        if (entry->value != nullptr)
+            return std::static_pointer_cast <T> (entry->value);
 
         auto O = std::make_shared <T> ();
         cacheObject(O, id); // cache inside the project
-        cache[id] = O; // cache local to the context
+        entry->value = O; // cache local to the context
 
-        if (!O->parseObject(*this, dict)) {
-            cache.erase(id);
+        bool parsed = O->parseObject(*this, dict);
+        release(entry, parsed);
+
+        if (!parsed) {
+            entry->value = nullptr;
             return std::shared_ptr <T> ();
         }
 
@@ -237,21 +236,36 @@ public:
     }
 
     template <typename T>
-    inline std::shared_ptr <T> parseObject(std::unordered_map <std::string, std::shared_ptr <T>> &cache,
-                                           plist::Object const *objectId,
+    inline std::shared_ptr <T> parseObject(plist::Object const *objectId,
                                            plist::Dictionary const *dict)
     {
         plist::String const *id = plist::CastTo <plist::String> (objectId);
         if (id == nullptr)
             return nullptr;
 
-        return parseObject(cache, id->value(), dict);
+        return parseObject <T> (id->value(), dict);
     }
 
 private:
     void cacheObject(std::shared_ptr <PBX::Object> const &O, std::string const &id);
 };
 
+//
+// Keeps the objects of an opened project, for the targets that are parsed
+// when first requested. Kept by the project until then.
+//
+class DeferredContext : public std::enable_shared_from_this<DeferredContext> {
+public:
+    std::unique_ptr<ObjectReader>  reader;
+    Context                        context;
+
+    //
+    // The project, to register objects parsed later in. Not kept alive, as
+    // the project keeps this context.
+    //
+    std::weak_ptr<PBX::Project>    project;
+};
+
 }
 
 #endif  // !__pbxproj_Context_h
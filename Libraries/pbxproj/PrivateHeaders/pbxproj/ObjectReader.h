@@ -0,0 +1,83 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef __pbxproj_ObjectReader_h
+#define __pbxproj_ObjectReader_h
+
+#include <plist/Dictionary.h>
+#include <libutil/MappedFile.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace pbxproj {
+
+/*
+ * Reads project files in the UTF-8 ASCII property list format written by
+ * Xcode, without building a property list for the whole file. Opening the
+ * file scans it once to find the ISA and location of each object; objects
+ * are only parsed into a dictionary when they are read.
+ */
+class ObjectReader {
+public:
+    /*
+     * An object in the project file.
+     */
+    struct Object {
+        std::string isa;
+        size_t      begin;
+        size_t      end;
+    };
+
+private:
+    std::unique_ptr<libutil::MappedFile>    _contents;
+    std::unique_ptr<plist::Dictionary>      _root;
+    std::unordered_map<std::string, Object> _objects;
+
+private:
+    ObjectReader(std::unique_ptr<libutil::MappedFile> &&contents);
+
+public:
+    /*
+     * The top level of the project file, except for the objects.
+     */
+    plist::Dictionary const *root() const
+    { return _root.get(); }
+
+    /*
+     * Find an object by its identifier. Returns null if not found.
+     */
+    Object const *object(std::string const &id) const;
+
+    /*
+     * All objects in the project file, by identifier.
+     */
+    std::unordered_map<std::string, Object> const &objects() const
+    { return _objects; }
+
+public:
+    /*
+     * Parse an object into a dictionary.
+     */
+    std::unique_ptr<plist::Dictionary> read(Object const &object, std::string *error) const;
+
+public:
+    /*
+     * Scan a project file, taking ownership of the contents. Returns null
+     * and leaves the contents if they are not in the format written by
+     * Xcode; they should be parsed as a generic property list instead.
+     */
+    static std::unique_ptr<ObjectReader>
+    Open(std::unique_ptr<libutil::MappedFile> *contents);
+};
+
+}
+
+#endif  // !__pbxproj_ObjectReader_h
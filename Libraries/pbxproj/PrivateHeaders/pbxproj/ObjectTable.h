@@ -0,0 +1,111 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef __pbxproj_ObjectTable_h
+#define __pbxproj_ObjectTable_h
+
+#include <pbxproj/ObjectReader.h>
+#include <plist/Dictionary.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace pbxproj {
+
+namespace PBX { class Object; }
+
+/*
+ * Every object in a project, by identifier. Built once when the project is
+ * opened, so finding an object, checking its ISA, and finding it again once
+ * parsed are a single lookup. Identifiers written by Xcode (24 uppercase hex
+ * digits) are stored as 96-bit keys; any others are stored as strings.
+ */
+class ObjectTable {
+public:
+    struct Entry {
+        /*
+         * The ISA, as one of the constants in `ISA`. Null if not known.
+         */
+        char const                        *isa;
+
+        /*
+         * Where the object comes from: either its dictionary, or its
+         * location in the project file.
+         */
+        plist::Dictionary const           *dictionary;
+        ObjectReader::Object const        *object;
+
+        /*
+         * The object read from the project file but not yet parsed, and if
+         * the object was parsed, the result.
+         */
+        std::unique_ptr<plist::Dictionary> read;
+        bool                               parsed;
+        std::shared_ptr<PBX::Object>       value;
+    };
+
+private:
+    struct Key {
+        uint32_t words[3];
+
+        bool operator==(Key const &other) const
+        { return words[0] == other.words[0] && words[1] == other.words[1] && words[2] == other.words[2]; }
+    };
+
+    struct KeyHash {
+        size_t operator()(Key const &key) const;
+    };
+
+private:
+    std::unordered_map<Key, Entry, KeyHash> _packed;
+    std::unordered_map<std::string, Entry>  _named;
+
+public:
+    /*
+     * Build the table from a dictionary of all of the objects.
+     */
+    void insert(plist::Dictionary const *objects);
+
+    /*
+     * Build the table from the objects found by a reader.
+     */
+    void insert(ObjectReader const *reader);
+
+public:
+    /*
+     * Find an object by its identifier. Returns null if not found.
+     */
+    Entry *find(std::string const &id);
+    Entry const *find(std::string const &id) const;
+
+    /*
+     * Call a function for each object.
+     */
+    template<typename Function>
+    void forEach(Function const &function)
+    {
+        for (auto &entry : _packed) {
+            function(entry.second);
+        }
+        for (auto &entry : _named) {
+            function(entry.second);
+        }
+    }
+
+private:
+    Entry *insert(std::string const &id);
+
+    static bool
+    Pack(std::string const &id, Key *key);
+};
+
+}
+
+#endif  // !__pbxproj_ObjectTable_h
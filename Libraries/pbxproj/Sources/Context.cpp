@@ -25,3 +25,71 @@ cacheObject(PBX::Object::shared_ptr const &O, std::string const &id)
         project->cacheObject(O);
     }
 }
+
+void Context::
+index()
+{
+    if (reader != nullptr) {
+        _table.insert(reader);
+    } else if (objects != nullptr) {
+        _table.insert(objects);
+    }
+}
+
+void Context::
+clearContainers()
+{
+    project = nullptr;
+
+    _table.forEach([](ObjectTable::Entry &entry) {
+        if (entry.isa != ISA::PBXFileReference &&
+            entry.isa != ISA::PBXReferenceProxy &&
+            entry.isa != ISA::PBXGroup &&
+            entry.isa != ISA::PBXVariantGroup &&
+            entry.isa != ISA::XCVersionGroup &&
+            entry.isa != ISA::PBXContainerItemProxy) {
+            entry.value = nullptr;
+        }
+    });
+}
+
+bool Context::
+contains(std::string const &key) const
+{
+    return _table.find(key) != nullptr;
+}
+
+plist::Dictionary const *Context::
+object(std::string const &key, char const *isa)
+{
+    ObjectTable::Entry *entry = _table.find(key);
+    if (entry == nullptr || entry->isa == nullptr || entry->isa != isa) {
+        return nullptr;
+    }
+
+    if (entry->dictionary != nullptr) {
+        return entry->dictionary;
+    } else if (entry->parsed) {
+        return &_parsed;
+    } else if (entry->read != nullptr) {
+        return entry->read.get();
+    }
+
+    std::string error;
+    entry->read = reader->read(*entry->object, &error);
+    if (entry->read == nullptr) {
+        fprintf(stderr, "error: object %s is not parseable: %s\n", key.c_str(), error.c_str());
+        unreadable = true;
+        return nullptr;
+    }
+
+    return entry->read.get();
+}
+
+void Context::
+release(ObjectTable::Entry *entry, bool parsed)
+{
+    /* Parsed objects are kept as a placeholder, as only their identifier is needed. */
+    entry->read.reset();
+    entry->parsed = parsed;
+}
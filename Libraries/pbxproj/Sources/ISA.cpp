@@ -8,6 +8,8 @@
 
 #include <pbxproj/ISA.h>
 
+#include <unordered_map>
+
 namespace pbxproj { namespace ISA {
 
 char const * const PBXAggregateTarget = "PBXAggregateTarget";
@@ -34,4 +36,27 @@ char const * const XCBuildConfiguration = "XCBuildConfiguration";
 char const * const XCConfigurationList = "XCConfigurationList";
 char const * const XCVersionGroup = "XCVersionGroup";
 
+char const *
+Find(std::string const &isa)
+{
+    static std::unordered_map<std::string, char const *> const names = [] {
+        std::unordered_map<std::string, char const *> names;
+        for (char const *name : {
+            PBXAggregateTarget, PBXAppleScriptBuildPhase, PBXBuildFile, PBXBuildRule,
+            PBXContainerItemProxy, PBXCopyFilesBuildPhase, PBXFileReference,
+            PBXFrameworksBuildPhase, PBXGroup, PBXHeadersBuildPhase, PBXLegacyTarget,
+            PBXNativeTarget, PBXProject, PBXReferenceProxy, PBXResourcesBuildPhase,
+            PBXRezBuildPhase, PBXShellScriptBuildPhase, PBXSourcesBuildPhase,
+            PBXTargetDependency, PBXVariantGroup, XCBuildConfiguration,
+            XCConfigurationList, XCVersionGroup,
+        }) {
+            names.insert({ name, name });
+        }
+        return names;
+    }();
+
+    auto it = names.find(isa);
+    return (it != names.end() ? it->second : nullptr);
+}
+
 } }
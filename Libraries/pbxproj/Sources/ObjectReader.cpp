@@ -0,0 +1,539 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <pbxproj/ObjectReader.h>
+#include <plist/Array.h>
+#include <plist/Data.h>
+#include <plist/String.h>
+#include <plist/Format/ASCII.h>
+
+#include <algorithm>
+#include <cstring>
+
+using pbxproj::ObjectReader;
+
+/*
+ * The first line of every project file written by Xcode.
+ */
+static char const UTF8Header[] = "// !$*UTF8*$!";
+
+/*
+ * Position in the contents being read.
+ */
+struct Cursor {
+    char const  *begin;
+    char const  *p;
+    char const  *end;
+    std::string *error;
+};
+
+static bool
+Fail(Cursor *c, std::string const &message)
+{
+    if (c->error != nullptr) {
+        size_t line = 1 + std::count(c->begin, c->p, '\n');
+        *c->error = "[line " + std::to_string(line) + "] " + message;
+    }
+    return false;
+}
+
+/*
+ * Skip whitespace and comments.
+ */
+static bool
+SkipSpace(Cursor *c)
+{
+    while (c->p < c->end) {
+        char ch = *c->p;
+        if (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r') {
+            c->p++;
+        } else if (ch == '/' && c->p + 1 < c->end && c->p[1] == '/') {
+            char const *eol = static_cast<char const *>(memchr(c->p, '\n', c->end - c->p));
+            c->p = (eol != nullptr ? eol + 1 : c->end);
+        } else if (ch == '/' && c->p + 1 < c->end && c->p[1] == '*') {
+            char const *p = c->p + 2;
+            while (p + 1 < c->end && !(p[0] == '*' && p[1] == '/')) {
+                p++;
+            }
+            if (p + 1 >= c->end) {
+                return Fail(c, "Encountered unterminated long comment");
+            }
+            c->p = p + 2;
+        } else {
+            break;
+        }
+    }
+
+    return true;
+}
+
+static bool
+Expect(Cursor *c, char ch)
+{
+    if (!SkipSpace(c)) {
+        return false;
+    }
+
+    if (c->p >= c->end || *c->p != ch) {
+        return Fail(c, std::string("Expected '") + ch + "'");
+    }
+
+    c->p++;
+    return true;
+}
+
+/*
+ * Check the next character without consuming it. Returns zero at the end.
+ */
+static bool
+Peek(Cursor *c, char *ch)
+{
+    if (!SkipSpace(c)) {
+        return false;
+    }
+
+    *ch = (c->p < c->end ? *c->p : '\0');
+    return true;
+}
+
+static inline bool
+IsUnquotedCharacter(char ch)
+{
+    switch (ch) {
+        case ' ': case '\t': case '\n': case '\r':
+        case ',': case ';': case '=': case '"':
+        case '(': case ')': case '{': case '}': case '<': case '>':
+            return false;
+        default:
+            return true;
+    }
+}
+
+static inline int
+HexValue(char ch)
+{
+    if (ch >= '0' && ch <= '9') {
+        return ch - '0';
+    } else if (ch >= 'a' && ch <= 'f') {
+        return ch - 'a' + 10;
+    } else if (ch >= 'A' && ch <= 'F') {
+        return ch - 'A' + 10;
+    } else {
+        return -1;
+    }
+}
+
+/*
+ * Find the extent of a quoted or unquoted string. Quoted strings include
+ * the quotes, and may contain escapes.
+ */
+static bool
+ScanString(Cursor *c, char const **begin, char const **end, bool *quoted)
+{
+    if (!SkipSpace(c)) {
+        return false;
+    }
+
+    if (c->p < c->end && *c->p == '"') {
+        char const *p = c->p + 1;
+        while (p < c->end && *p != '"') {
+            p += (*p == '\\' ? 2 : 1);
+        }
+        if (p >= c->end) {
+            return Fail(c, "Encountered unterminated quoted string");
+        }
+
+        *begin = c->p + 1;
+        *end = p;
+        *quoted = true;
+        c->p = p + 1;
+        return true;
+    } else {
+        char const *p = c->p;
+        while (p < c->end && IsUnquotedCharacter(*p)) {
+            p++;
+        }
+        if (p == c->p) {
+            return Fail(c, "Encountered invalid token");
+        }
+
+        *begin = c->p;
+        *end = p;
+        *quoted = false;
+        c->p = p;
+        return true;
+    }
+}
+
+static bool
+ReadString(Cursor *c, std::string *value)
+{
+    char const *begin;
+    char const *end;
+    bool quoted;
+    if (!ScanString(c, &begin, &end, &quoted)) {
+        return false;
+    }
+
+    if (quoted && memchr(begin, '\\', end - begin) != nullptr) {
+        /* Escapes are rare; decode them the same way as the parser. */
+        *value = plist::Format::ASCII::UnescapeString(begin, end - begin);
+    } else {
+        value->assign(begin, end - begin);
+    }
+    return true;
+}
+
+static std::unique_ptr<plist::Object>
+ReadValue(Cursor *c);
+
+static std::unique_ptr<plist::Dictionary>
+ReadDictionary(Cursor *c)
+{
+    if (!Expect(c, '{')) {
+        return nullptr;
+    }
+
+    std::unique_ptr<plist::Dictionary> dictionary = plist::Dictionary::New();
+
+    std::string key;
+    for (;;) {
+        char ch;
+        if (!Peek(c, &ch)) {
+            return nullptr;
+        }
+        if (ch == '}') {
+            c->p++;
+            break;
+        }
+
+        if (!ReadString(c, &key) || !Expect(c, '=')) {
+            return nullptr;
+        }
+
+        std::unique_ptr<plist::Object> value = ReadValue(c);
+        if (value == nullptr || !Expect(c, ';')) {
+            return nullptr;
+        }
+
+        dictionary->set(key, std::move(value));
+    }
+
+    return dictionary;
+}
+
+static std::unique_ptr<plist::Array>
+ReadArray(Cursor *c)
+{
+    if (!Expect(c, '(')) {
+        return nullptr;
+    }
+
+    std::unique_ptr<plist::Array> array = plist::Array::New();
+
+    for (;;) {
+        char ch;
+        if (!Peek(c, &ch)) {
+            return nullptr;
+        }
+        if (ch == ')') {
+            c->p++;
+            break;
+        }
+
+        std::unique_ptr<plist::Object> value = ReadValue(c);
+        if (value == nullptr) {
+            return nullptr;
+        }
+        array->append(std::move(value));
+
+        /* Arrays do not require a final separator. */
+        if (!Peek(c, &ch)) {
+            return nullptr;
+        }
+        if (ch == ',') {
+            c->p++;
+        } else if (ch != ')') {
+            Fail(c, "Expected ',' or ')'");
+            return nullptr;
+        }
+    }
+
+    return array;
+}
+
+static std::unique_ptr<plist::Data>
+ReadData(Cursor *c)
+{
+    if (!Expect(c, '<')) {
+        return nullptr;
+    }
+
+    std::vector<uint8_t> bytes;
+    int high = -1;
+    for (; c->p < c->end && *c->p != '>'; c->p++) {
+        int value = HexValue(*c->p);
+        if (value < 0) {
+            if (*c->p == ' ' || *c->p == '\t' || *c->p == '\n' || *c->p == '\r') {
+                continue;
+            }
+            Fail(c, "Encountered invalid data");
+            return nullptr;
+        }
+
+        if (high < 0) {
+            high = value;
+        } else {
+            bytes.push_back(static_cast<uint8_t>((high << 4) | value));
+            high = -1;
+        }
+    }
+
+    if (c->p >= c->end) {
+        Fail(c, "Encountered unterminated data");
+        return nullptr;
+    }
+    c->p++;
+
+    return plist::Data::New(std::move(bytes));
+}
+
+static std::unique_ptr<plist::Object>
+ReadValue(Cursor *c)
+{
+    char ch;
+    if (!Peek(c, &ch)) {
+        return nullptr;
+    }
+
+    switch (ch) {
+        case '{':
+            return ReadDictionary(c);
+        case '(':
+            return ReadArray(c);
+        case '<':
+            return ReadData(c);
+        default: {
+            std::string value;
+            if (!ReadString(c, &value)) {
+                return nullptr;
+            }
+            return plist::String::New(std::move(value));
+        }
+    }
+}
+
+/*
+ * Skip over a value without building it. Used to index objects.
+ */
+static bool
+SkipValue(Cursor *c)
+{
+    char ch;
+    if (!Peek(c, &ch)) {
+        return false;
+    }
+
+    if (ch == '{' || ch == '(') {
+        /* Nested containers are skipped by depth. */
+        int depth = 0;
+        do {
+            if (!Peek(c, &ch)) {
+                return false;
+            }
+
+            if (ch == '{' || ch == '(') {
+                depth++;
+                c->p++;
+            } else if (ch == '}' || ch == ')') {
+                depth--;
+                c->p++;
+            } else if (ch == '=' || ch == ';' || ch == ',') {
+                c->p++;
+            } else if (ch == '<') {
+                char const *close = static_cast<char const *>(memchr(c->p, '>', c->end - c->p));
+                if (close == nullptr) {
+                    return Fail(c, "Encountered unterminated data");
+                }
+                c->p = close + 1;
+            } else if (ch == '\0') {
+                return Fail(c, "Encountered premature EOF");
+            } else {
+                char const *begin;
+                char const *end;
+                bool quoted;
+                if (!ScanString(c, &begin, &end, &quoted)) {
+                    return false;
+                }
+            }
+        } while (depth > 0);
+
+        return true;
+    } else if (ch == '<') {
+        return ReadData(c) != nullptr;
+    } else {
+        char const *begin;
+        char const *end;
+        bool quoted;
+        return ScanString(c, &begin, &end, &quoted);
+    }
+}
+
+/*
+ * Skip over an object, finding its ISA.
+ */
+static bool
+ScanObject(Cursor *c, std::string *isa)
+{
+    if (!Expect(c, '{')) {
+        return false;
+    }
+
+    std::string key;
+    for (;;) {
+        char ch;
+        if (!Peek(c, &ch)) {
+            return false;
+        }
+        if (ch == '}') {
+            c->p++;
+            break;
+        }
+
+        if (!ReadString(c, &key) || !Expect(c, '=')) {
+            return false;
+        }
+
+        if (key == "isa") {
+            if (!ReadString(c, isa)) {
+                return false;
+            }
+        } else if (!SkipValue(c)) {
+            return false;
+        }
+
+        if (!Expect(c, ';')) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+ObjectReader::
+ObjectReader(std::unique_ptr<libutil::MappedFile> &&contents) :
+    _contents(std::move(contents))
+{
+}
+
+ObjectReader::Object const *ObjectReader::
+object(std::string const &id) const
+{
+    auto it = _objects.find(id);
+    return (it != _objects.end() ? &it->second : nullptr);
+}
+
+std::unique_ptr<plist::Dictionary> ObjectReader::
+read(Object const &object, std::string *error) const
+{
+    char const *contents = reinterpret_cast<char const *>(_contents->data());
+    Cursor c = { contents, contents + object.begin, contents + object.end, error };
+    return ReadDictionary(&c);
+}
+
+std::unique_ptr<ObjectReader> ObjectReader::
+Open(std::unique_ptr<libutil::MappedFile> *contents)
+{
+    size_t headerLength = sizeof(UTF8Header) - 1;
+    if ((*contents)->size() < headerLength || memcmp((*contents)->data(), UTF8Header, headerLength) != 0) {
+        return nullptr;
+    }
+
+    std::unique_ptr<plist::Dictionary> root = plist::Dictionary::New();
+    std::unordered_map<std::string, Object> objects;
+
+    char const *begin = reinterpret_cast<char const *>((*contents)->data());
+    Cursor c = { begin, begin, begin + (*contents)->size(), nullptr };
+
+    if (!Expect(&c, '{')) {
+        return nullptr;
+    }
+
+    std::string key;
+    for (;;) {
+        char ch;
+        if (!Peek(&c, &ch)) {
+            return nullptr;
+        }
+        if (ch == '}') {
+            c.p++;
+            break;
+        }
+
+        if (!ReadString(&c, &key) || !Expect(&c, '=')) {
+            return nullptr;
+        }
+
+        if (key == "objects") {
+            /*
+             * Only record where each object is. They are parsed when used.
+             */
+            if (!Expect(&c, '{')) {
+                return nullptr;
+            }
+
+            std::string id;
+            for (;;) {
+                if (!Peek(&c, &ch)) {
+                    return nullptr;
+                }
+                if (ch == '}') {
+                    c.p++;
+                    break;
+                }
+
+                if (!ReadString(&c, &id) || !Expect(&c, '=') || !SkipSpace(&c)) {
+                    return nullptr;
+                }
+
+                Object object;
+                object.begin = c.p - begin;
+                if (!ScanObject(&c, &object.isa)) {
+                    return nullptr;
+                }
+                object.end = c.p - begin;
+
+                if (!Expect(&c, ';')) {
+                    return nullptr;
+                }
+
+                objects[id] = std::move(object);
+            }
+        } else {
+            std::unique_ptr<plist::Object> value = ReadValue(&c);
+            if (value == nullptr) {
+                return nullptr;
+            }
+            root->set(key, std::move(value));
+        }
+
+        if (!Expect(&c, ';')) {
+            return nullptr;
+        }
+    }
+
+    if (!SkipSpace(&c) || c.p != c.end) {
+        return nullptr;
+    }
+
+    /* Offsets remain valid, as ownership of the contents moves rather than the contents. */
+    std::unique_ptr<ObjectReader> reader = std::unique_ptr<ObjectReader>(new ObjectReader(std::move(*contents)));
+    reader->_root = std::move(root);
+    reader->_objects = std::move(objects);
+    return reader;
+}
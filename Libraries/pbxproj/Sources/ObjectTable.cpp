@@ -0,0 +1,113 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <pbxproj/ObjectTable.h>
+#include <pbxproj/ISA.h>
+#include <plist/String.h>
+
+using pbxproj::ObjectTable;
+
+size_t ObjectTable::KeyHash::
+operator()(Key const &key) const
+{
+    uint64_t hash = (static_cast<uint64_t>(key.words[0]) << 32) | key.words[1];
+    hash ^= key.words[2] * 0x9E3779B97F4A7C15ULL;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    return static_cast<size_t>(hash);
+}
+
+bool ObjectTable::
+Pack(std::string const &id, Key *key)
+{
+    if (id.size() != 24) {
+        return false;
+    }
+
+    /* Only uppercase, so the key maps back to exactly one identifier. */
+    for (size_t n = 0; n < 24; n++) {
+        char c = id[n];
+        uint32_t digit;
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else {
+            return false;
+        }
+
+        uint32_t &word = key->words[n / 8];
+        word = (n % 8 == 0 ? 0 : word << 4) | digit;
+    }
+
+    return true;
+}
+
+ObjectTable::Entry *ObjectTable::
+insert(std::string const &id)
+{
+    Entry entry = { nullptr, nullptr, nullptr, nullptr, false, nullptr };
+
+    Key key;
+    if (Pack(id, &key)) {
+        return &_packed.insert({ key, std::move(entry) }).first->second;
+    } else {
+        return &_named.insert({ id, std::move(entry) }).first->second;
+    }
+}
+
+void ObjectTable::
+insert(plist::Dictionary const *objects)
+{
+    _packed.reserve(_packed.size() + objects->count());
+
+    for (size_t n = 0; n < objects->count(); n++) {
+        plist::Dictionary const *object = objects->value <plist::Dictionary> (n);
+        if (object == nullptr) {
+            continue;
+        }
+
+        Entry *entry = insert(objects->key(n));
+        entry->dictionary = object;
+
+        if (plist::String const *isa = object->value <plist::String> ("isa")) {
+            entry->isa = ISA::Find(isa->value());
+        }
+    }
+}
+
+void ObjectTable::
+insert(ObjectReader const *reader)
+{
+    _packed.reserve(_packed.size() + reader->objects().size());
+
+    for (auto const &object : reader->objects()) {
+        Entry *entry = insert(object.first);
+        entry->object = &object.second;
+        entry->isa = ISA::Find(object.second.isa);
+    }
+}
+
+ObjectTable::Entry *ObjectTable::
+find(std::string const &id)
+{
+    Key key;
+    if (Pack(id, &key)) {
+        auto it = _packed.find(key);
+        return (it != _packed.end() ? &it->second : nullptr);
+    } else {
+        auto it = _named.find(id);
+        return (it != _named.end() ? &it->second : nullptr);
+    }
+}
+
+ObjectTable::Entry const *ObjectTable::
+find(std::string const &id) const
+{
+    return const_cast<ObjectTable *>(this)->find(id);
+}
@@ -21,7 +21,7 @@ AggregateTarget() :
 }
 
 bool AggregateTarget::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Target::parse(context, dict, seen, false)) {
         return false;
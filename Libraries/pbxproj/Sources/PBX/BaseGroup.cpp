@@ -28,7 +28,7 @@ BaseGroup(std::string const &isa, GroupItem::Type type) :
 }
 
 bool BaseGroup::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!GroupItem::parse(context, dict, seen, false)) {
         return false;
@@ -50,7 +50,7 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
             }
 
             if (auto C = context.get <Group> (ID)) {
-                auto O = context.parseObject(context.groups, ID->value(), C);
+                auto O = context.parseObject <Group> (ID->value(), C);
                 if (!O) {
                     return false;
                 }
@@ -58,7 +58,7 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
                 O->_parent = this;
                 _children.push_back(O);
             } else if (auto C = context.get <VariantGroup> (ID)) {
-                auto O = context.parseObject(context.variantGroups, ID->value(), C);
+                auto O = context.parseObject <VariantGroup> (ID->value(), C);
                 if (!O) {
                     return false;
                 }
@@ -66,7 +66,7 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
                 O->_parent = this;
                 _children.push_back(O);
             } else if (auto C = context.get <XC::VersionGroup> (ID)) {
-                auto O = context.parseObject(context.versionGroups, ID->value(), C);
+                auto O = context.parseObject <XC::VersionGroup> (ID->value(), C);
                 if (!O) {
                     return false;
                 }
@@ -74,7 +74,7 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
                 O->_parent = this;
                 _children.push_back(O);
             } else if (auto C = context.get <FileReference> (ID)) {
-                auto O = context.parseObject(context.fileReferences, ID->value(), C);
+                auto O = context.parseObject <FileReference> (ID->value(), C);
                 if (!O) {
                     return false;
                 }
@@ -82,14 +82,14 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
                 O->_parent = this;
                 _children.push_back(O);
             } else if (auto C = context.get <ReferenceProxy> (ID)) {
-                auto O = context.parseObject(context.referenceProxies, ID->value(), C);
+                auto O = context.parseObject <ReferenceProxy> (ID->value(), C);
                 if (!O) {
                     return false;
                 }
 
                 O->_parent = this;
                 _children.push_back(O);
-            } else if (context.objects->value(ID->value()) != nullptr) {
+            } else if (context.contains(ID->value())) {
                 fprintf(stderr, "warning: group '%s' contains unsupported child reference to '%s'\n",
                         _name.c_str(), ID->value().c_str());
             }
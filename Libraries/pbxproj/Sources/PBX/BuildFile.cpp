@@ -34,7 +34,7 @@ BuildFile::
 }
 
 bool BuildFile::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Object::parse(context, dict, seen, false)) {
         return false;
@@ -60,19 +60,19 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
     }
 
     if (FR != nullptr) {
-        FileReference::shared_ptr fileReference = context.parseObject(context.fileReferences, FRID, FR);
+        FileReference::shared_ptr fileReference = context.parseObject <FileReference> (FRID, FR);
         _fileRef = std::static_pointer_cast <GroupItem> (fileReference);
     } else if (RP != nullptr) {
-        ReferenceProxy::shared_ptr referenceProxy = context.parseObject(context.referenceProxies, RPID, RP);
+        ReferenceProxy::shared_ptr referenceProxy = context.parseObject <ReferenceProxy> (RPID, RP);
         _fileRef = std::static_pointer_cast <GroupItem> (referenceProxy);
     } else if (G != nullptr) {
-        Group::shared_ptr group = context.parseObject(context.groups, GID, G);
+        Group::shared_ptr group = context.parseObject <Group> (GID, G);
         _fileRef = std::static_pointer_cast <GroupItem> (group);
     } else if (VaG != nullptr) {
-        VariantGroup::shared_ptr variantGroup = context.parseObject(context.variantGroups, VaGID, VaG);
+        VariantGroup::shared_ptr variantGroup = context.parseObject <VariantGroup> (VaGID, VaG);
         _fileRef = std::static_pointer_cast <GroupItem> (variantGroup);
     } else if (VrG != nullptr) {
-        XC::VersionGroup::shared_ptr versionGroup = context.parseObject(context.versionGroups, VrGID, VrG);
+        XC::VersionGroup::shared_ptr versionGroup = context.parseObject <XC::VersionGroup> (VrGID, VrG);
         _fileRef = std::static_pointer_cast <GroupItem> (versionGroup);
     }
 
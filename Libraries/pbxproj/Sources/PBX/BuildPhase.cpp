@@ -28,7 +28,7 @@ BuildPhase(std::string const &isa, Type type) :
 }
 
 bool BuildPhase::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Object::parse(context, dict, seen, false)) {
         return false;
@@ -54,7 +54,7 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
             std::string FID;
             auto F = context.get <BuildFile> (Fs->value(n), &FID);
             if (F != nullptr) {
-                auto BF = context.parseObject(context.buildFiles, FID, F);
+                auto BF = context.parseObject <BuildFile> (FID, F);
                 if (!BF)
                     return false;
 
@@ -23,7 +23,7 @@ ContainerItemProxy() :
 }
 
 bool ContainerItemProxy::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Object::parse(context, dict, seen, false)) {
         return false;
@@ -43,7 +43,7 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
     }
 
     if (CP != nullptr) {
-        auto portal = context.parseObject(context.fileReferences, CPID, CP);
+        auto portal = context.parseObject <FileReference> (CPID, CP);
         if (!portal) {
             return false;
         }
@@ -24,7 +24,7 @@ CopyFilesBuildPhase() :
 }
 
 bool CopyFilesBuildPhase::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!BuildPhase::parse(context, dict, seen, false)) {
         return false;
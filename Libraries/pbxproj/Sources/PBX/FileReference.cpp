@@ -26,7 +26,7 @@ FileReference() :
 }
 
 bool FileReference::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!GroupItem::parse(context, dict, seen, false)) {
         return false;
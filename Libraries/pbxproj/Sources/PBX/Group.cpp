@@ -23,7 +23,7 @@ Group() :
 }
 
 bool Group::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!BaseGroup::parse(context, dict, seen, false)) {
         return false;
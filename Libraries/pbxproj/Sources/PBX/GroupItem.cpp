@@ -45,7 +45,7 @@ resolve(void) const
 }
 
 bool GroupItem::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Object::parse(context, dict, seen, false)) {
         return false;
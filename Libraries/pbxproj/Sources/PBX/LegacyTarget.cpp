@@ -25,7 +25,7 @@ LegacyTarget() :
 }
 
 bool LegacyTarget::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Target::parse(context, dict, seen, false))
         return false;
@@ -23,7 +23,7 @@ NativeTarget() :
 }
 
 bool NativeTarget::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Target::parse(context, dict, seen, false)) {
         return false;
@@ -47,7 +47,7 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
     }
 
     if (PR != nullptr) {
-        _productReference = context.parseObject(context.fileReferences, PRID, PR);
+        _productReference = context.parseObject <FileReference> (PRID, PR);
         if (!_productReference) {
             return false;
         }
@@ -62,7 +62,7 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
             std::string BRID;
             auto BRd = context.get <BuildRule> (BRs->value(n), &BRID);
             if (BRd != nullptr) {
-                auto BR = context.parseObject(context.buildRules, BRID, BRd);
+                auto BR = context.parseObject <BuildRule> (BRID, BRd);
                 if (!BR) {
                     return false;
                 }
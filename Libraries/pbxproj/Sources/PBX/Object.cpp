@@ -23,12 +23,12 @@ Object(std::string const &isa) :
 bool Object::
 parseObject(Context &context, plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     return parse(context, dict, &seen, true);
 }
 
 bool Object::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     auto unpack = plist::Keys::Unpack("Object", dict, seen);
 
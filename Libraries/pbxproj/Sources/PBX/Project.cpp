@@ -11,6 +11,7 @@
 #include <pbxproj/PBX/LegacyTarget.h>
 #include <pbxproj/PBX/NativeTarget.h>
 #include <pbxproj/Context.h>
+#include <pbxproj/ObjectReader.h>
 #include <plist/Array.h>
 #include <plist/Boolean.h>
 #include <plist/Integer.h>
@@ -29,7 +30,8 @@ using libutil::FSUtil;
 Project::
 Project() :
     Object                 (Isa()),
-    _hasScannedForEncodings(false)
+    _hasScannedForEncodings(false),
+    _targetsValid          (true)
 {
 }
 
@@ -48,6 +50,73 @@ settings(void) const
     return pbxsetting::Level(settings);
 }
 
+pbxproj::PBX::Target::vector const *Project::
+targets() const
+{
+    std::call_once(_targetsParsed, [this] {
+        if (_deferred == nullptr) {
+            return;
+        }
+
+        Context &context = _deferred->context;
+
+        /* Register the targets and what they contain in the project. */
+        context.project = _deferred->project.lock();
+        _targetsValid = (ParseTargets(context, _targetIdentifiers, &_targets) && !context.unreadable);
+        if (!_targetsValid) {
+            fprintf(stderr, "error: unable to parse targets of project %s\n", _name.c_str());
+        }
+
+        /* Some file references are only used by targets. */
+        _fileReferences = context.parsed <FileReference> ();
+        context.project = nullptr;
+
+        /* Nothing else is parsed later, so the context can be freed. */
+        _deferred.reset();
+        _targetIdentifiers.clear();
+    });
+
+    return (_targetsValid ? &_targets : nullptr);
+}
+
+pbxproj::PBX::FileReference::vector const &Project::
+fileReferences() const
+{
+    (void)targets();
+    return _fileReferences;
+}
+
+bool Project::
+ParseTargets(Context &context, std::vector<std::string> const &identifiers, Target::vector *targets)
+{
+    for (std::string const &TID : identifiers) {
+        if (auto Td = context.get <NativeTarget> (TID)) {
+            auto T = context.parseObject <NativeTarget> (TID, Td);
+            if (!T) {
+                return false;
+            }
+
+            targets->push_back(T);
+        } else if (auto Td = context.get <LegacyTarget> (TID)) {
+            auto T = context.parseObject <LegacyTarget> (TID, Td);
+            if (!T) {
+                return false;
+            }
+
+            targets->push_back(T);
+        } else if (auto Td = context.get <AggregateTarget> (TID)) {
+            auto T = context.parseObject <AggregateTarget> (TID, Td);
+            if (!T) {
+                return false;
+            }
+
+            targets->push_back(T);
+        }
+    }
+
+    return true;
+}
+
 std::string Project::
 sourceRoot() const
 {
@@ -59,7 +128,7 @@ sourceRoot() const
 }
 
 bool Project::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Object::parse(context, dict, seen, false)) {
         return false;
@@ -89,7 +158,7 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
     }
 
     if (BCL != nullptr) {
-        _buildConfigurationList = context.parseObject(context.configurationLists, BCLID, BCL);
+        _buildConfigurationList = context.parseObject <XC::ConfigurationList> (BCLID, BCL);
         if (!_buildConfigurationList) {
             return false;
         }
@@ -122,14 +191,14 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
     }
 
     if (MG != nullptr) {
-        _mainGroup = context.parseObject(context.groups, MGID, MG);
+        _mainGroup = context.parseObject <Group> (MGID, MG);
         if (!_mainGroup) {
             return false;
         }
     }
 
     if (PRG != nullptr) {
-        _productRefGroup = context.parseObject(context.groups, PRGID, PRG);
+        _productRefGroup = context.parseObject <Group> (PRGID, PRG);
     }
 
     if (PDP != nullptr) {
@@ -154,29 +223,18 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
 
     if (Ts != nullptr) {
         for (size_t n = 0; n < Ts->count(); n++) {
-            std::string TID;
-            if (auto Td = context.get <NativeTarget> (Ts->value(n), &TID)) {
-                auto T = context.parseObject(context.nativeTargets, TID, Td);
-                if (!T) {
-                    return false;
-                }
-
-                _targets.push_back(T);
-            } else if (auto Td = context.get <LegacyTarget> (Ts->value(n), &TID)) {
-                auto T = context.parseObject(context.legacyTargets, TID, Td);
-                if (!T) {
-                    return false;
-                }
-
-                _targets.push_back(T);
-            } else if (auto Td = context.get <AggregateTarget> (Ts->value(n), &TID)) {
-                auto T = context.parseObject(context.aggregateTargets, TID, Td);
-                if (!T) {
-                    return false;
-                }
+            if (auto TID = Ts->value <plist::String> (n)) {
+                _targetIdentifiers.push_back(TID->value());
+            }
+        }
 
-                _targets.push_back(T);
+        if (context.deferred != nullptr) {
+            _deferred = context.deferred->shared_from_this();
+        } else {
+            if (!ParseTargets(context, _targetIdentifiers, &_targets)) {
+                return false;
             }
+            _targetIdentifiers.clear();
         }
     }
 
@@ -203,22 +261,35 @@ Open(Filesystem const *filesystem, std::string const &path)
         return nullptr;
     }
 
-    std::vector<uint8_t> contents;
-    if (!filesystem->read(&contents, realPath)) {
+    //
+    // Read the file into memory rather than mapping it. Parts of the project
+    // are parsed after it is opened, and a mapping would change under them
+    // if the file is edited in place.
+    //
+    std::vector<uint8_t> buffer;
+    if (!filesystem->read(&buffer, realPath)) {
         fprintf(stderr, "error: project file %s is not readable\n", projectFileName.c_str());
         return nullptr;
     }
+    std::unique_ptr<libutil::MappedFile> contents = std::unique_ptr<libutil::MappedFile>(new libutil::MappedFile(std::move(buffer)));
 
     //
-    // Parse property list
+    // Read project files written by Xcode directly, parsing each object
+    // only when it is used. Parse anything else as a property list.
     //
-    auto result = plist::Format::Any::Deserialize(contents);
-    if (result.first == nullptr) {
-        fprintf(stderr, "error: project file %s is not parseable: %s\n", projectFileName.c_str(), result.second.c_str());
-        return nullptr;
+    std::unique_ptr<plist::Object> root;
+    std::unique_ptr<ObjectReader> reader = ObjectReader::Open(&contents);
+    if (reader == nullptr) {
+        auto result = plist::Format::Any::Deserialize(contents->copy());
+        if (result.first == nullptr) {
+            fprintf(stderr, "error: project file %s is not parseable: %s\n", projectFileName.c_str(), result.second.c_str());
+            return nullptr;
+        }
+
+        root = std::move(result.first);
     }
 
-    plist::Dictionary *plist = plist::CastTo<plist::Dictionary>(result.first.get());
+    plist::Dictionary const *plist = (reader != nullptr ? reader->root() : plist::CastTo<plist::Dictionary>(root.get()));
     if (plist == nullptr) {
         fprintf(stderr, "error: project file %s is not a dictionary\n", projectFileName.c_str());
         return nullptr;
@@ -227,7 +298,7 @@ Open(Filesystem const *filesystem, std::string const &path)
     //
     // Fetch basic objects
     //
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("Root", plist, &seen);
 
     auto AV = unpack.coerce <plist::Integer> ("archiveVersion");
@@ -262,15 +333,24 @@ Open(Filesystem const *filesystem, std::string const &path)
         fprintf(stderr, "warning: non-empty classes may be unsupported\n");
     }
 
-    if (Os == nullptr) {
-        return nullptr;
-    }
-
     //
-    // Initialize context
+    // Initialize context. When objects are read as they are used, it
+    // outlives opening the project, for the targets that are parsed when
+    // first requested. Otherwise, everything is parsed now, so the property
+    // list can be freed once the project is open.
     //
-    Context context;
-    context.objects = Os;
+    std::shared_ptr<DeferredContext> deferred = std::make_shared<DeferredContext>();
+    Context &context = deferred->context;
+    if (reader != nullptr) {
+        context.reader = reader.get();
+        context.deferred = deferred.get();
+    } else if (Os != nullptr) {
+        context.objects = Os;
+    } else {
+        return nullptr;
+    }
+    context.index();
+    deferred->reader = std::move(reader);
 
     //
     // Fetch the project dictionary (root object)
@@ -292,7 +372,11 @@ Open(Filesystem const *filesystem, std::string const &path)
     //
     // Parse the project dictionary and create the project object.
     //
-    auto project = context.parseObject(context.projects, PID, P);
+    auto project = context.parseObject <Project> (PID, P);
+    if (project == nullptr || context.unreadable) {
+        fprintf(stderr, "error: unable to parse project\n");
+        return nullptr;
+    }
 
     //
     // Save some useful info
@@ -302,12 +386,20 @@ Open(Filesystem const *filesystem, std::string const &path)
     project->_basePath    = FSUtil::GetDirectoryName(project->_projectFile);
     project->_name        = FSUtil::GetBaseNameWithoutExtension(project->_projectFile);
 
+    //
+    // Targets parsed later are still found in the project.
+    //
+    deferred->project = project;
+
     //
     // Transfer all file references from cache.
     //
-    for (auto const &I : context.fileReferences) {
-        project->_fileReferences.push_back(I.second);
-    }
+    project->_fileReferences = context.parsed <FileReference> ();
+
+    //
+    // Only keep what the targets can refer to.
+    //
+    context.clearContainers();
 
     return project;
 }
@@ -320,7 +412,7 @@ ProjectReference()
 bool Project::ProjectReference::
 parse(Context &context, plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
 
     auto unpack = plist::Keys::Unpack("ProjectReference", dict, &seen);
 
@@ -335,14 +427,14 @@ parse(Context &context, plist::Dictionary const *dict)
     }
 
     if (PG != nullptr) {
-        _productGroup = context.parseObject(context.groups, PGID, PG);
+        _productGroup = context.parseObject <Group> (PGID, PG);
         if (_productGroup == nullptr) {
             return false;
         }
     }
 
     if (PR != nullptr) {
-        _projectReference = context.parseObject(context.fileReferences, PRID, PR);
+        _projectReference = context.parseObject <FileReference> (PRID, PR);
         if (_projectReference == nullptr) {
             return false;
         }
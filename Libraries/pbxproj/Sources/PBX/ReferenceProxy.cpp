@@ -19,7 +19,7 @@ ReferenceProxy() :
 }
 
 bool ReferenceProxy::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!GroupItem::parse(context, dict, seen, false)) {
         return false;
@@ -37,7 +37,7 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
     }
 
     if (RR != nullptr) {
-        _remoteRef = context.parseObject(context.containerItemProxies, RRID, RR);
+        _remoteRef = context.parseObject <ContainerItemProxy> (RRID, RR);
         if (_remoteRef == nullptr) {
             return false;
         }
@@ -46,7 +46,7 @@ settings(void) const
 }
 
 bool Target::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Object::parse(context, dict, seen, false)) {
         return false;
@@ -77,7 +77,7 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
     }
 
     if (BCL != nullptr) {
-        _buildConfigurationList = context.parseObject(context.configurationLists, BCLID, BCL);
+        _buildConfigurationList = context.parseObject <XC::ConfigurationList> (BCLID, BCL);
         if (!_buildConfigurationList) {
             return false;
         }
@@ -91,56 +91,56 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
             }
 
             if (auto BPd = context.get <HeadersBuildPhase> (ID)) {
-                auto O = context.parseObject(context.headersBuildPhases, ID->value(), BPd);
+                auto O = context.parseObject <HeadersBuildPhase> (ID->value(), BPd);
                 if (!O) {
                     return false;
                 }
 
                 _buildPhases.push_back(O);
             } else if (auto BPd = context.get <SourcesBuildPhase> (ID)) {
-                auto O = context.parseObject(context.sourcesBuildPhases, ID->value(), BPd);
+                auto O = context.parseObject <SourcesBuildPhase> (ID->value(), BPd);
                 if (!O) {
                     return false;
                 }
 
                 _buildPhases.push_back(O);
             } else if (auto BPd = context.get <ResourcesBuildPhase> (ID)) {
-                auto O = context.parseObject(context.resourcesBuildPhases, ID->value(), BPd);
+                auto O = context.parseObject <ResourcesBuildPhase> (ID->value(), BPd);
                 if (!O) {
                     return false;
                 }
 
                 _buildPhases.push_back(O);
             } else if (auto BPd = context.get <FrameworksBuildPhase> (ID)) {
-                auto O = context.parseObject(context.frameworksBuildPhases, ID->value(), BPd);
+                auto O = context.parseObject <FrameworksBuildPhase> (ID->value(), BPd);
                 if (!O) {
                     return false;
                 }
 
                 _buildPhases.push_back(O);
             } else if (auto BPd = context.get <CopyFilesBuildPhase> (ID)) {
-                auto O = context.parseObject(context.copyFilesBuildPhases, ID->value(), BPd);
+                auto O = context.parseObject <CopyFilesBuildPhase> (ID->value(), BPd);
                 if (!O) {
                     return false;
                 }
 
                 _buildPhases.push_back(O);
             } else if (auto BPd = context.get <ShellScriptBuildPhase> (ID)) {
-                auto O = context.parseObject(context.shellScriptBuildPhases, ID->value(), BPd);
+                auto O = context.parseObject <ShellScriptBuildPhase> (ID->value(), BPd);
                 if (!O) {
                     return false;
                 }
 
                 _buildPhases.push_back(O);
             } else if (auto BPd = context.get <AppleScriptBuildPhase> (ID)) {
-                auto O = context.parseObject(context.appleScriptBuildPhases, ID->value(), BPd);
+                auto O = context.parseObject <AppleScriptBuildPhase> (ID->value(), BPd);
                 if (!O) {
                     return false;
                 }
 
                 _buildPhases.push_back(O);
             } else if (auto BPd = context.get <RezBuildPhase> (ID)) {
-                auto O = context.parseObject(context.rezBuildPhases, ID->value(), BPd);
+                auto O = context.parseObject <RezBuildPhase> (ID->value(), BPd);
                 if (!O) {
                     return false;
                 }
@@ -158,7 +158,7 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
             std::string DID;
             auto D = context.get <TargetDependency> (Ds->value(n), &DID);
             if (D != nullptr) {
-                auto TD = context.parseObject(context.targetDependencies, DID, D);
+                auto TD = context.parseObject <TargetDependency> (DID, D);
                 if (!TD) {
                     return false;
                 }
@@ -23,7 +23,7 @@ TargetDependency() :
 }
 
 bool TargetDependency::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Object::parse(context, dict, seen, false)) {
         return false;
@@ -38,17 +38,17 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
     auto TP = context.indirect <ContainerItemProxy> (&unpack, "targetProxy", &TPID);
 
     if (auto T = context.indirect <NativeTarget> (&unpack, "target", &TID)) {
-        _target = context.parseObject(context.nativeTargets, TID, T);
+        _target = context.parseObject <NativeTarget> (TID, T);
         if (!_target) {
             return false;
         }
     } else if (auto T = context.indirect <AggregateTarget> (&unpack, "target", &TID)) {
-        _target = context.parseObject(context.aggregateTargets, TID, T);
+        _target = context.parseObject <AggregateTarget> (TID, T);
         if (!_target) {
             return false;
         }
     } else if (auto T = context.indirect <LegacyTarget> (&unpack, "target", &TID)) {
-        _target = context.parseObject(context.legacyTargets, TID, T);
+        _target = context.parseObject <LegacyTarget> (TID, T);
         if (!_target) {
             return false;
         }
@@ -63,7 +63,7 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
     }
 
     if (TP != nullptr) {
-        _targetProxy = context.parseObject(context.containerItemProxies, TPID, TP);
+        _targetProxy = context.parseObject <ContainerItemProxy> (TPID, TP);
         if (!_targetProxy) {
             return false;
         }
@@ -24,7 +24,7 @@ BuildConfiguration::~BuildConfiguration()
 }
 
 bool BuildConfiguration::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Object::parse(context, dict, seen, false)) {
         return false;
@@ -44,7 +44,7 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
 
     if (BCR != nullptr) {
         _baseConfigurationReference =
-          context.parseObject(context.fileReferences, BCRID, BCR);
+          context.parseObject <PBX::FileReference> (BCRID, BCR);
         if (!_baseConfigurationReference)
             return false;
     }
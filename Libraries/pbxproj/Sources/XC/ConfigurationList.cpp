@@ -27,7 +27,7 @@ ConfigurationList() :
 }
 
 bool ConfigurationList::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Object::parse(context, dict, seen, false)) {
         return false;
@@ -58,7 +58,7 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
             auto BCd = context.get <BuildConfiguration> (BCs->value(n), &BCID);
             assert(BCd != nullptr);
 
-            auto BC = context.parseObject(context.buildConfigurations, BCID, BCd);
+            auto BC = context.parseObject <BuildConfiguration> (BCID, BCd);
             if (!BC)
                 return false;
 
@@ -20,7 +20,7 @@ VersionGroup() :
 }
 
 bool VersionGroup::
-parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context &context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!BaseGroup::parse(context, dict, seen, false)) {
         return false;
@@ -38,7 +38,7 @@ parse(Context &context, plist::Dictionary const *dict, std::unordered_set<std::s
     }
 
     if (CV != nullptr) {
-        _currentVersion = context.parseObject(context.fileReferences, CVID, CV);
+        _currentVersion = context.parseObject <PBX::FileReference> (CVID, CV);
         if (!_currentVersion)
             return false;
     }
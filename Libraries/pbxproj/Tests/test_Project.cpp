@@ -0,0 +1,334 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <pbxproj/pbxproj.h>
+#include <libutil/DefaultFilesystem.h>
+#include <libutil/MemoryFilesystem.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <ftw.h>
+
+using pbxproj::PBX::Project;
+using libutil::DefaultFilesystem;
+using libutil::MemoryFilesystem;
+
+static std::string const ProjectContents = R"PROJECT(// !$*UTF8*$!
+{
+	archiveVersion = 1;
+	classes = {
+	};
+	objectVersion = 46;
+	objects = {
+
+/* Begin PBXBuildFile section */
+		B10000000000000000000001 /* main.c in Sources */ = {isa = PBXBuildFile; fileRef = F10000000000000000000001 /* main.c */; settings = {COMPILER_FLAGS = "-Wall"; }; };
+/* End PBXBuildFile section */
+
+/* Begin PBXFileReference section */
+		F10000000000000000000001 /* main.c */ = {isa = PBXFileReference; lastKnownFileType = sourcecode.c.c; path = main.c; sourceTree = "<group>"; };
+		F10000000000000000000002 /* Tool */ = {isa = PBXFileReference; explicitFileType = "compiled.mach-o.executable"; path = Tool; sourceTree = BUILT_PRODUCTS_DIR; };
+/* End PBXFileReference section */
+
+/* Begin PBXGroup section */
+		G10000000000000000000001 = {
+			isa = PBXGroup;
+			children = (
+				F10000000000000000000001 /* main.c */,
+				G10000000000000000000002 /* Products */,
+			);
+			sourceTree = "<group>";
+		};
+		G10000000000000000000002 /* Products */ = {
+			isa = PBXGroup;
+			children = (
+				F10000000000000000000002 /* Tool */,
+			);
+			name = "Pr\U00f6grams \"1\"";
+			sourceTree = "<group>";
+		};
+/* End PBXGroup section */
+
+/* Begin PBXNativeTarget section */
+		T10000000000000000000001 /* Tool */ = {
+			isa = PBXNativeTarget;
+			buildConfigurationList = L10000000000000000000002;
+			buildPhases = (
+				S10000000000000000000001 /* Sources */,
+			);
+			buildRules = (
+			);
+			dependencies = (
+			);
+			name = Tool;
+			productName = Tool;
+			productReference = F10000000000000000000002 /* Tool */;
+			productType = "com.apple.product-type.tool";
+		};
+/* End PBXNativeTarget section */
+
+/* Begin PBXProject section */
+		P10000000000000000000001 /* Project object */ = {
+			isa = PBXProject;
+			buildConfigurationList = L10000000000000000000001;
+			compatibilityVersion = "Xcode 3.2";
+			mainGroup = G10000000000000000000001;
+			productRefGroup = G10000000000000000000002 /* Products */;
+			projectDirPath = "";
+			projectRoot = "";
+			targets = (
+				T10000000000000000000001 /* Tool */,
+			);
+		};
+/* End PBXProject section */
+
+/* Begin PBXSourcesBuildPhase section */
+		S10000000000000000000001 /* Sources */ = {
+			isa = PBXSourcesBuildPhase;
+			buildActionMask = 2147483647;
+			files = (
+				B10000000000000000000001 /* main.c in Sources */,
+			);
+			runOnlyForDeploymentPostprocessing = 0;
+		};
+/* End PBXSourcesBuildPhase section */
+
+/* Begin XCBuildConfiguration section */
+		C10000000000000000000001 /* Debug */ = {
+			isa = XCBuildConfiguration;
+			buildSettings = {
+				GCC_PREPROCESSOR_DEFINITIONS = (
+					"DEBUG=1",
+					"$(inherited)",
+				);
+			};
+			name = Debug;
+		};
+		C10000000000000000000002 /* Debug */ = {
+			isa = XCBuildConfiguration;
+			buildSettings = {
+				PRODUCT_NAME = "$(TARGET_NAME)";
+			};
+			name = Debug;
+		};
+/* End XCBuildConfiguration section */
+
+/* Begin XCConfigurationList section */
+		L10000000000000000000001 = {
+			isa = XCConfigurationList;
+			buildConfigurations = (
+				C10000000000000000000001 /* Debug */,
+			);
+			defaultConfigurationIsVisible = 0;
+			defaultConfigurationName = Debug;
+		};
+		L10000000000000000000002 = {
+			isa = XCConfigurationList;
+			buildConfigurations = (
+				C10000000000000000000002 /* Debug */,
+			);
+			defaultConfigurationIsVisible = 0;
+			defaultConfigurationName = Debug;
+		};
+/* End XCConfigurationList section */
+	};
+	rootObject = P10000000000000000000001 /* Project object */;
+}
+)PROJECT";
+
+static int
+RemoveEntry(char const *path, struct stat const *st, int flag, struct FTW *ftw)
+{
+    return ::remove(path);
+}
+
+static MemoryFilesystem
+ProjectFilesystem(std::string const &contents)
+{
+    return MemoryFilesystem({
+        MemoryFilesystem::Entry::Directory("Tool.xcodeproj", {
+            MemoryFilesystem::Entry::File("project.pbxproj", std::vector<uint8_t>(contents.begin(), contents.end())),
+        }),
+    });
+}
+
+static void
+ExpectProject(Project::shared_ptr const &project)
+{
+    ASSERT_NE(nullptr, project);
+    EXPECT_EQ("Tool", project->name());
+    EXPECT_EQ(2, project->fileReferences().size());
+
+    ASSERT_NE(nullptr, project->mainGroup());
+    ASSERT_EQ(2, project->mainGroup()->children().size());
+    EXPECT_EQ("main.c", project->mainGroup()->children()[0]->path());
+    EXPECT_EQ("Pr\xc3\xb6" "grams \"1\"", project->mainGroup()->children()[1]->name());
+
+    ASSERT_NE(nullptr, project->targets());
+    ASSERT_EQ(1, project->targets()->size());
+    pbxproj::PBX::Target::shared_ptr const &target = project->targets()->front();
+    EXPECT_EQ("Tool", target->name());
+    ASSERT_EQ(1, target->buildPhases().size());
+    ASSERT_EQ(1, target->buildPhases().front()->files().size());
+
+    pbxproj::PBX::BuildFile::shared_ptr const &buildFile = target->buildPhases().front()->files().front();
+    EXPECT_EQ(project->mainGroup()->children()[0], buildFile->fileRef());
+    EXPECT_EQ(std::vector<std::string>({ "-Wall" }), buildFile->compilerFlags());
+}
+
+TEST(Project, Open)
+{
+    auto filesystem = ProjectFilesystem(ProjectContents);
+    ExpectProject(Project::Open(&filesystem, filesystem.path("Tool.xcodeproj")));
+}
+
+TEST(Project, OpenPropertyList)
+{
+    /* Without the header written by Xcode, the file is parsed as any property list. */
+    auto filesystem = ProjectFilesystem(ProjectContents.substr(ProjectContents.find('\n') + 1));
+    ExpectProject(Project::Open(&filesystem, filesystem.path("Tool.xcodeproj")));
+}
+
+TEST(Project, OpenHexIdentifiers)
+{
+    /* Identifiers written by Xcode are hex, but others can still be mixed in. */
+    std::string contents = ProjectContents;
+    for (auto const &prefix : std::vector<std::pair<std::string, std::string>>({ { "G1", "A1" }, { "T1", "91" }, { "P1", "D1" }, { "S1", "e1" } })) {
+        for (size_t offset = 0; (offset = contents.find(prefix.first + "0000000000", offset)) != std::string::npos;) {
+            contents.replace(offset, prefix.second.size(), prefix.second);
+        }
+    }
+
+    auto filesystem = ProjectFilesystem(contents);
+    ExpectProject(Project::Open(&filesystem, filesystem.path("Tool.xcodeproj")));
+
+    auto propertyList = ProjectFilesystem(contents.substr(contents.find('\n') + 1));
+    ExpectProject(Project::Open(&propertyList, propertyList.path("Tool.xcodeproj")));
+}
+
+TEST(Project, OpenEscapes)
+{
+    /* Escapes are decoded the same way whichever way the file is read. */
+    for (std::string const &name : std::vector<std::string>({ "\\v\\a\\t", "\\1\\07\\101", "a\\0b", "\\x41\\u00e9\\\\", "line\\\ncontinued" })) {
+        std::string contents = ProjectContents;
+        std::string original = "name = \"Pr\\U00f6grams \\\"1\\\"\";";
+        contents.replace(contents.find(original), original.size(), "name = \"" + name + "\";");
+
+        auto filesystem = ProjectFilesystem(contents);
+        Project::shared_ptr project = Project::Open(&filesystem, filesystem.path("Tool.xcodeproj"));
+        ASSERT_NE(nullptr, project);
+
+        auto propertyList = ProjectFilesystem(contents.substr(contents.find('\n') + 1));
+        Project::shared_ptr expected = Project::Open(&propertyList, propertyList.path("Tool.xcodeproj"));
+        ASSERT_NE(nullptr, expected);
+
+        EXPECT_EQ(expected->mainGroup()->children()[1]->name(), project->mainGroup()->children()[1]->name());
+    }
+}
+
+TEST(Project, OpenUnusedObjects)
+{
+    /* An object nothing refers to, which can't be parsed. */
+    std::string contents = ProjectContents;
+    std::string section = "/* Begin PBXFileReference section */\n";
+    contents.insert(contents.find(section) + section.size(), "\t\tF10000000000000000000003 = {isa = PBXFileReference; path = unused.c; sourceTree = \"<group>\"; settings = {DATA = <zz>; }; };\n");
+
+    auto propertyList = ProjectFilesystem(contents.substr(contents.find('\n') + 1));
+    EXPECT_EQ(nullptr, Project::Open(&propertyList, propertyList.path("Tool.xcodeproj")));
+
+    /* Objects are only parsed when used. */
+    auto filesystem = ProjectFilesystem(contents);
+    ExpectProject(Project::Open(&filesystem, filesystem.path("Tool.xcodeproj")));
+}
+
+TEST(Project, DeferredTargets)
+{
+    /* A build file that can't be parsed. */
+    std::string contents = ProjectContents;
+    std::string original = "settings = {COMPILER_FLAGS = \"-Wall\"; };";
+    contents.replace(contents.find(original), original.size(), "settings = {DATA = <zz>; };");
+
+    auto propertyList = ProjectFilesystem(contents.substr(contents.find('\n') + 1));
+    EXPECT_EQ(nullptr, Project::Open(&propertyList, propertyList.path("Tool.xcodeproj")));
+
+    /* Targets are only parsed when requested, and report the failure then. */
+    auto filesystem = ProjectFilesystem(contents);
+    Project::shared_ptr project = Project::Open(&filesystem, filesystem.path("Tool.xcodeproj"));
+    ASSERT_NE(nullptr, project);
+    ASSERT_NE(nullptr, project->mainGroup());
+    EXPECT_EQ(nullptr, project->targets());
+    EXPECT_EQ(nullptr, project->targets());
+}
+
+TEST(Project, DeferredTargetsReleased)
+{
+    auto filesystem = ProjectFilesystem(ProjectContents);
+
+    /* Projects are released whether or not their targets were parsed. */
+    for (bool parse : { false, true }) {
+        Project::shared_ptr project = Project::Open(&filesystem, filesystem.path("Tool.xcodeproj"));
+        ASSERT_NE(nullptr, project);
+        std::weak_ptr<Project> weakProject = project;
+
+        if (parse) {
+            ASSERT_NE(nullptr, project->targets());
+        }
+
+        project.reset();
+        EXPECT_TRUE(weakProject.expired());
+    }
+}
+
+TEST(Project, DeferredTargetBlueprints)
+{
+    auto filesystem = ProjectFilesystem(ProjectContents);
+
+    Project::shared_ptr project = Project::Open(&filesystem, filesystem.path("Tool.xcodeproj"));
+    ASSERT_NE(nullptr, project);
+
+    /* Targets and what they contain can be found before they're requested. */
+    pbxproj::PBX::Object::shared_ptr buildFile = project->resolveBuildableReference("B10000000000000000000001");
+    ASSERT_NE(nullptr, buildFile);
+    ASSERT_NE(nullptr, project->targets());
+
+    pbxproj::PBX::Target::shared_ptr const &target = project->targets()->front();
+    EXPECT_EQ(target, project->resolveBuildableReference("T10000000000000000000001"));
+    ASSERT_EQ(1, target->buildPhases().front()->files().size());
+    EXPECT_EQ(target->buildPhases().front()->files().front(), buildFile);
+}
+
+TEST(Project, DeferredTargetsEdited)
+{
+    char path[] = "/tmp/pbxproj-project-XXXXXX";
+    ASSERT_NE(nullptr, ::mkdtemp(path));
+    std::string root = path;
+
+    DefaultFilesystem filesystem;
+    ASSERT_TRUE(filesystem.createDirectory(root + "/Tool.xcodeproj", false));
+    ASSERT_TRUE(filesystem.write(std::vector<uint8_t>(ProjectContents.begin(), ProjectContents.end()), root + "/Tool.xcodeproj/project.pbxproj"));
+
+    Project::shared_ptr project = Project::Open(&filesystem, root + "/Tool.xcodeproj");
+    ASSERT_NE(nullptr, project);
+
+    /* Overwrite the file in place, before the targets are parsed. */
+    FILE *fp = fopen((root + "/Tool.xcodeproj/project.pbxproj").c_str(), "r+b");
+    ASSERT_NE(nullptr, fp);
+    std::string replaced = std::string(ProjectContents.size(), ' ');
+    fwrite(replaced.data(), 1, replaced.size(), fp);
+    fclose(fp);
+
+    /* The project is still parsed as it was opened. */
+    ASSERT_NE(nullptr, project->targets());
+    pbxproj::PBX::BuildPhase::shared_ptr buildPhase = project->targets()->front()->buildPhases().front();
+    ASSERT_EQ(1, buildPhase->files().size());
+    ASSERT_NE(nullptr, buildPhase->files().front()->fileRef());
+    EXPECT_EQ("main.c", buildPhase->files().front()->fileRef()->path());
+
+    ::nftw(root.c_str(), &RemoveEntry, 16, FTW_DEPTH | FTW_PHYS);
+}
@@ -102,7 +102,7 @@ void
 GetSourceFileReferences(PBX::Project::shared_ptr const &project,
         std::string const &target, PBX::FileReference::vector &refs)
 {
-    for (auto const &I : project->targets()) {
+    for (auto const &I : *project->targets()) {
         if (I->name() != target)
             continue;
 
@@ -146,7 +146,7 @@ void
 GetHeaderFileReferences(PBX::Project::shared_ptr const &project,
         std::string const &target, PBX::FileReference::vector &refs)
 {
-    for (auto const &I : project->targets()) {
+    for (auto const &I : *project->targets()) {
         if (I->name() != target)
             continue;
 
@@ -215,7 +215,7 @@ CompleteDump(process::User const *user, Filesystem const *filesystem, PBX::Proje
     }
 
     printf("Target List:\n");
-    for (auto I : project->targets()) {
+    for (auto I : *project->targets()) {
         printf("\t%s\n", I->name().c_str());
         printf("\t\tProduct Name = %s\n", I->productName().c_str());
         if (I->type() == PBX::Target::Type::Native) {
@@ -415,14 +415,19 @@ main(int argc, char **argv)
         return -1;
     }
 
+    if (!project->targets()) {
+        fprintf(stderr, "error loading targets of project\n");
+        return -1;
+    }
+
     CompleteDump(&user, &filesystem, project);
 
     printf("Information about project \"%s\":\n",
             project->name().c_str());
 
-    if (!project->targets().empty()) {
+    if (!project->targets()->empty()) {
         printf("%4sTargets:\n", "");
-        for (auto target : project->targets()) {
+        for (auto target : *project->targets()) {
             printf("%8s%s\n", "", target->name().c_str());
         }
     } else {
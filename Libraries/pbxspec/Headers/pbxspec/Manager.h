@@ -27,6 +27,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
@@ -43,6 +44,14 @@ private:
     std::map<std::string, std::map<SpecificationType, PBX::Specification::vector>> _specifications;
     PBX::BuildRule::vector                                                         _buildRules;
 
+private:
+    /*
+     * Specifications by type, then identifier, then domain. Domains are
+     * sorted, so the first is the one found when searching any domain.
+     */
+    typedef std::map<std::string, PBX::Specification::shared_ptr>                  DomainSpecifications;
+    std::map<SpecificationType, std::unordered_map<std::string, DomainSpecifications>> _identifiers;
+
 public:
     Manager();
     ~Manager();
@@ -34,7 +34,7 @@ public:
 
 protected:
     friend class Specification;
-    bool parse(Context *context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check) override;
+    bool parse(Context *context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check) override;
 
 protected:
     bool inherit(Specification::shared_ptr const &base) override;
@@ -11,6 +11,7 @@
 
 #include <pbxspec/PBX/Specification.h>
 #include <pbxspec/PBX/PropertyOption.h>
+#include <pbxsetting/Level.h>
 
 #include <memory>
 #include <string>
@@ -18,7 +19,6 @@
 #include <vector>
 #include <ext/optional>
 
-namespace pbxsetting { class Level; }
 
 namespace pbxspec { namespace PBX {
 
@@ -34,6 +34,9 @@ protected:
     PropertyOption::used_map                       _propertiesUsed;
     ext::optional<std::unordered_set<std::string>> _deletedProperties;
 
+protected:
+    ext::optional<pbxsetting::Level>               _defaultSettings;
+
 protected:
     BuildSystem();
 
@@ -61,15 +64,20 @@ public:
     { return _deletedProperties; }
 
 public:
+    /*
+     * Default values of the properties and options. Shared by everything
+     * using the build system.
+     */
     pbxsetting::Level defaultSettings(void) const;
 
 protected:
     friend class Specification;
-    bool parse(Context *context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check) override;
+    bool parse(Context *context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check) override;
 
 protected:
     bool inherit(Specification::shared_ptr const &base) override;
     virtual bool inherit(BuildSystem::shared_ptr const &base);
+    void complete() override;
 
 protected:
     static BuildSystem::shared_ptr Parse(Context *context, plist::Dictionary const *dict);
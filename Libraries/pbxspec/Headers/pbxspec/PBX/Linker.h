@@ -60,7 +60,7 @@ protected:
 
 protected:
     friend class Specification;
-    bool parse(Context *context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check) override;
+    bool parse(Context *context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check) override;
 
 protected:
     static Linker::shared_ptr Parse(Context *context, plist::Dictionary const *dict);
@@ -19,6 +19,7 @@
 
 namespace libutil { class Filesystem; }
 namespace plist { class Dictionary; }
+namespace plist { namespace Keys { class Seen; } }
 namespace pbxspec { class Manager; }
 namespace pbxspec { class Context; }
 
@@ -42,6 +43,9 @@ protected:
     ext::optional<std::string> _vendor;
     ext::optional<std::string> _version;
 
+protected:
+    std::unordered_set<std::string> _lineage;
+
 protected:
     Specification();
 
@@ -56,6 +60,12 @@ public:
     inline Specification::shared_ptr base() const
     { return _base; }
 
+    /*
+     * If this specification has an identifier, or inherits from one that
+     * does, without walking the chain of bases.
+     */
+    bool isKindOf(std::string const &identifier) const;
+
 public:
     inline ext::optional<std::string> const &basedOnIdentifier() const
     { return _basedOnIdentifier; }
@@ -87,12 +97,18 @@ public:
     { return _version; }
 
 protected:
-    virtual bool parse(Context *context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check);
+    virtual bool parse(Context *context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check);
 
 protected:
     friend class pbxspec::Manager;
     virtual bool inherit(Specification::shared_ptr const &base);
 
+    /*
+     * Compute values derived from the inherited values. Called once, after
+     * all inheritance is done.
+     */
+    virtual void complete();
+
 protected:
     static bool ParseType(Context *context, plist::Dictionary const *dict, SpecificationType expectedType);
 
@@ -11,6 +11,7 @@
 
 #include <pbxspec/PBX/Specification.h>
 #include <pbxspec/PBX/PropertyOption.h>
+#include <pbxsetting/Level.h>
 #include <pbxsetting/Value.h>
 
 #include <memory>
@@ -20,7 +21,6 @@
 #include <vector>
 #include <ext/optional>
 
-namespace pbxsetting { class Level; }
 
 namespace pbxspec { namespace PBX {
 
@@ -67,6 +67,9 @@ protected:
     ext::optional<PropertyOption::vector>          _options;
     PropertyOption::used_map                       _optionsUsed;
 
+protected:
+    ext::optional<pbxsetting::Level>               _defaultSettings;
+
 protected:
     Tool();
 
@@ -212,15 +215,19 @@ public:
     { return _deletedProperties; }
 
 public:
+    /*
+     * Default values of the options. Shared by everything using the tool.
+     */
     pbxsetting::Level defaultSettings(void) const;
 
 protected:
     friend class Specification;
-    bool parse(Context *context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check) override;
+    bool parse(Context *context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check) override;
 
 protected:
     bool inherit(Specification::shared_ptr const &base) override;
     virtual bool inherit(Tool::shared_ptr const &base);
+    void complete() override;
 
 protected:
     static Tool::shared_ptr Parse(Context *context, plist::Dictionary const *dict);
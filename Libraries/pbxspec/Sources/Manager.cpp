@@ -14,6 +14,7 @@
 #include <plist/Format/Any.h>
 #include <libutil/Filesystem.h>
 #include <libutil/FSUtil.h>
+#include <libutil/Parallel.h>
 
 using pbxspec::Manager;
 using pbxspec::Context;
@@ -22,6 +23,7 @@ using pbxspec::SpecificationTypes;
 namespace PBX = pbxspec::PBX;
 using libutil::Filesystem;
 using libutil::FSUtil;
+using libutil::Parallel;
 
 Manager::
 Manager()
@@ -69,14 +71,29 @@ template <typename T>
 typename T::shared_ptr Manager::
 findSpecification(std::vector<std::string> const &domains, std::string const &identifier, SpecificationType type) const
 {
-    typename T::vector vector = findSpecifications <T> (domains, type);
+    auto const &tit = _identifiers.find(type);
+    if (tit == _identifiers.end()) {
+        return nullptr;
+    }
 
-    auto I = std::find_if(vector.begin(), vector.end(), [&identifier](PBX::Specification::shared_ptr const &spec) -> bool {
-        return identifier == spec->identifier();
-    });
+    auto const &iit = tit->second.find(identifier);
+    if (iit == tit->second.end()) {
+        return nullptr;
+    }
 
-    if (I != vector.end()) {
-        return *I;
+    /* Search the domains in order, as if they were searched in full. */
+    DomainSpecifications const &specifications = iit->second;
+    for (std::string const &domain : domains) {
+        if (domain == AnyDomain()) {
+            if (!specifications.empty()) {
+                return std::static_pointer_cast<T>(specifications.begin()->second);
+            }
+        } else {
+            auto const &it = specifications.find(domain);
+            if (it != specifications.end()) {
+                return std::static_pointer_cast<T>(it->second);
+            }
+        }
     }
 
     return nullptr;
@@ -281,6 +298,7 @@ addSpecification(PBX::Specification::shared_ptr const &spec)
             spec->type(), spec->domain().c_str(), spec->identifier().c_str());
 #endif
     _specifications[spec->domain()][spec->type()].push_back(spec);
+    _identifiers[spec->type()][spec->identifier()].insert({ spec->domain(), spec });
 }
 
 bool Manager::
@@ -363,7 +381,16 @@ inheritSpecification(PBX::Specification::shared_ptr const &specification, std::v
 void Manager::
 registerDomains(Filesystem const *filesystem, std::vector<std::pair<std::string, std::string>> const &domains)
 {
-    PBX::Specification::vector specifications;
+    /*
+     * Find the specification files first, so they can be parsed in parallel.
+     */
+    struct File {
+        Context                                   context;
+        std::string                               path;
+        ext::optional<SpecificationType>          defaultType;
+        ext::optional<PBX::Specification::vector> specifications;
+    };
+    std::vector<File> files;
 
     for (auto const &domain : domains) {
         /*
@@ -388,12 +415,12 @@ registerDomains(Filesystem const *filesystem, std::vector<std::pair<std::string,
 
         switch (*type) {
             case Filesystem::Type::Directory: {
-                filesystem->readDirectory(realPath, true, [&](std::string const &filename) -> bool {
-                    std::string path = realPath + "/" + filename;
+                filesystem->enumerateDirectory(realPath, true, false, [&](Filesystem::DirectoryEntry const &entry) {
+                    std::string path = realPath + "/" + entry.path;
 
                     /* Support both *.xcspec and *.pbfilespec as a few of the latter remain in use. */
                     if (FSUtil::GetFileExtension(path) != "xcspec" && FSUtil::GetFileExtension(path) != "pbfilespec") {
-                        return true;
+                        return;
                     }
 
                     /* For *.pbfilespec files, default to FileType specifications. */
@@ -402,38 +429,40 @@ registerDomains(Filesystem const *filesystem, std::vector<std::pair<std::string,
                         defaultType = SpecificationType::FileType;
                     }
 
-                    if (filesystem->type(path) != Filesystem::Type::Directory) {
-#if 0
-                        fprintf(stderr, "importing specification '%s'\n", path.c_str());
-#endif
-
-                        ext::optional<PBX::Specification::vector> fileSpecifications = PBX::Specification::Open(filesystem, &context, path, defaultType);
-                        if (fileSpecifications) {
-                            specifications.insert(specifications.end(), fileSpecifications->begin(), fileSpecifications->end());
-                        } else {
-                            fprintf(stderr, "warning: failed to import specification '%s'\n", path.c_str());
-                        }
+                    if (entry.type != Filesystem::Type::Directory) {
+                        files.push_back({ context, path, defaultType, ext::nullopt });
                     }
-                    return true;
                 });
                 break;
             }
             case Filesystem::Type::SymbolicLink:
             case Filesystem::Type::File: {
-#if 0
-                fprintf(stderr, "importing specification '%s'\n", realPath.c_str());
-#endif
-                ext::optional<PBX::Specification::vector> fileSpecifications = PBX::Specification::Open(filesystem, &context, realPath);
-                if (fileSpecifications) {
-                    specifications.insert(specifications.end(), fileSpecifications->begin(), fileSpecifications->end());
-                } else {
-                    fprintf(stderr, "warning: failed to import specification '%s'\n", realPath.c_str());
-                }
+                files.push_back({ context, realPath, ext::nullopt, ext::nullopt });
                 break;
             }
         }
     }
 
+    /*
+     * Parsing each file is independent; everything after is done in order.
+     */
+    Parallel::ForEach(files.size(), [&](size_t n) {
+        File &file = files[n];
+#if 0
+        fprintf(stderr, "importing specification '%s'\n", file.path.c_str());
+#endif
+        file.specifications = PBX::Specification::Open(filesystem, &file.context, file.path, file.defaultType);
+    });
+
+    PBX::Specification::vector specifications;
+    for (File const &file : files) {
+        if (file.specifications) {
+            specifications.insert(specifications.end(), file.specifications->begin(), file.specifications->end());
+        } else {
+            fprintf(stderr, "warning: failed to import specification '%s'\n", file.path.c_str());
+        }
+    }
+
     /*
      * Mark all of the domains regsitered. This is after all of the inputs so the
      * same domain can be registered multiple times (loaded from multiple paths)
@@ -461,6 +490,14 @@ registerDomains(Filesystem const *filesystem, std::vector<std::pair<std::string,
             continue;
         }
     }
+
+    /*
+     * Compute what depends on inherited values once, rather than each time
+     * it's used.
+     */
+    for (PBX::Specification::shared_ptr const &specification : specifications) {
+        specification->complete();
+    }
 }
 
 bool Manager::
@@ -51,7 +51,7 @@ Parse(Context *context, plist::Dictionary const *dict)
     Architecture::shared_ptr result;
     result.reset(new Architecture());
 
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     if (!result->parse(context, dict, &seen, true))
         return nullptr;
 
@@ -59,7 +59,7 @@ Parse(Context *context, plist::Dictionary const *dict)
 }
 
 bool Architecture::
-parse(Context *context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context *context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Specification::parse(context, dict, seen, false))
         return false;
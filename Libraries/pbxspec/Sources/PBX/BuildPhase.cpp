@@ -34,7 +34,7 @@ Parse(Context *context, plist::Dictionary const *dict)
     BuildPhase::shared_ptr result;
     result.reset(new BuildPhase());
 
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     if (!result->parse(context, dict, &seen, true))
         return nullptr;
 
@@ -42,7 +42,7 @@ Parse(Context *context, plist::Dictionary const *dict)
 }
 
 bool BuildPhase::
-parse(Context *context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context *context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Specification::parse(context, dict, seen, false))
         return false;
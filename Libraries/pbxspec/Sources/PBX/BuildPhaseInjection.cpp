@@ -23,7 +23,7 @@ BuildPhaseInjection()
 bool BuildPhaseInjection::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("BuildPhaseInjection", dict, &seen);
 
     auto BP     = unpack.cast <plist::String> ("BuildPhase");
@@ -29,7 +29,7 @@ BuildRule(std::vector<std::string> const &fileTypes, std::string const &compiler
 bool BuildRule::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("BuildRule", dict, &seen);
 
     auto N  = unpack.cast <plist::String> ("Name");
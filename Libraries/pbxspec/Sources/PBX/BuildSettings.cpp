@@ -36,7 +36,7 @@ Parse(Context *context, plist::Dictionary const *dict)
     BuildSettings::shared_ptr result;
     result.reset(new BuildSettings());
 
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     if (!result->parse(context, dict, &seen, true))
         return nullptr;
 
@@ -44,7 +44,7 @@ Parse(Context *context, plist::Dictionary const *dict)
 }
 
 bool BuildSettings::
-parse(Context *context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context *context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Specification::parse(context, dict, seen, false))
         return false;
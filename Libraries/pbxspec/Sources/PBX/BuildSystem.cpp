@@ -30,6 +30,10 @@ BuildSystem::
 pbxsetting::Level BuildSystem::
 defaultSettings(void) const
 {
+    if (_defaultSettings) {
+        return *_defaultSettings;
+    }
+
     std::vector<pbxsetting::Setting> settings;
     if (_properties) {
         for (PBX::PropertyOption::shared_ptr const &option : *_properties) {
@@ -48,6 +52,15 @@ defaultSettings(void) const
     return pbxsetting::Level(settings);
 }
 
+void BuildSystem::
+complete()
+{
+    Specification::complete();
+
+    _defaultSettings = ext::nullopt;
+    _defaultSettings = defaultSettings();
+}
+
 BuildSystem::shared_ptr BuildSystem::
 Parse(Context *context, plist::Dictionary const *dict)
 {
@@ -58,7 +71,7 @@ Parse(Context *context, plist::Dictionary const *dict)
     BuildSystem::shared_ptr result;
     result.reset(new BuildSystem());
 
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     if (!result->parse(context, dict, &seen, true))
         return nullptr;
 
@@ -66,7 +79,7 @@ Parse(Context *context, plist::Dictionary const *dict)
 }
 
 bool BuildSystem::
-parse(Context *context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context *context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Specification::parse(context, dict, seen, false))
         return false;
@@ -108,7 +108,7 @@ Parse(Context *context, plist::Dictionary const *dict)
     Compiler::shared_ptr result;
     result.reset(new Compiler());
 
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     if (!result->parse(context, dict, &seen, true))
         return nullptr;
 
@@ -116,7 +116,7 @@ Parse(Context *context, plist::Dictionary const *dict)
 }
 
 bool Compiler::
-parse(Context *context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context *context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Tool::parse(context, dict, seen, false))
         return false;
@@ -108,7 +108,7 @@ Parse(Context *context, plist::Dictionary const *dict)
     FileType::shared_ptr result;
     result.reset(new FileType());
 
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     if (!result->parse(context, dict, &seen, true))
         return nullptr;
 
@@ -116,7 +116,7 @@ Parse(Context *context, plist::Dictionary const *dict)
 }
 
 bool FileType::
-parse(Context *context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context *context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Specification::parse(context, dict, seen, false))
         return false;
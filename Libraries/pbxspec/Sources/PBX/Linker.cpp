@@ -71,7 +71,7 @@ Parse(Context *context, plist::Dictionary const *dict)
     Linker::shared_ptr result;
     result.reset(new Linker());
 
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     if (!result->parse(context, dict, &seen, true))
         return nullptr;
 
@@ -79,7 +79,7 @@ Parse(Context *context, plist::Dictionary const *dict)
 }
 
 bool Linker::
-parse(Context *context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context *context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Tool::parse(context, dict, seen, false))
         return false;
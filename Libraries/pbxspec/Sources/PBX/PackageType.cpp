@@ -39,7 +39,7 @@ Parse(Context *context, plist::Dictionary const *dict)
     PackageType::shared_ptr result;
     result.reset(new PackageType());
 
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     if (!result->parse(context, dict, &seen, true))
         return nullptr;
 
@@ -47,7 +47,7 @@ Parse(Context *context, plist::Dictionary const *dict)
 }
 
 bool PackageType::
-parse(Context *context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context *context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Specification::parse(context, dict, seen, false))
         return false;
@@ -116,7 +116,7 @@ ProductReference()
 bool PackageType::ProductReference::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("ProductReference", dict, &seen);
 
     auto N  = unpack.cast <plist::String> ("Name");
@@ -40,7 +40,7 @@ Parse(Context *context, plist::Dictionary const *dict)
     ProductType::shared_ptr result;
     result.reset(new ProductType());
 
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     if (!result->parse(context, dict, &seen, true))
         return nullptr;
 
@@ -48,7 +48,7 @@ Parse(Context *context, plist::Dictionary const *dict)
 }
 
 bool ProductType::
-parse(Context *context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context *context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Specification::parse(context, dict, seen, false))
         return false;
@@ -334,7 +334,7 @@ Validation()
 bool ProductType::Validation::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("Validation", dict, &seen);
 
     auto VTS = unpack.cast <plist::String> ("ValidationToolSpec");
@@ -376,7 +376,7 @@ FileReference()
 bool ProductType::FileReference::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("FileReference", dict, &seen);
 
     auto RVN = unpack.cast <plist::String> ("RegionVariantName");
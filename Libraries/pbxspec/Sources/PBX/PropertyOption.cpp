@@ -63,7 +63,7 @@ defaultSetting(void) const
 bool PropertyOption::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("Property/Option", dict, &seen);
 
     auto N      = unpack.cast <plist::String> ("Name");
@@ -66,7 +66,33 @@ inherit(Specification::shared_ptr const &base)
 }
 
 bool Specification::
-parse(Context *context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+isKindOf(std::string const &identifier) const
+{
+    if (!_lineage.empty()) {
+        return _lineage.find(identifier) != _lineage.end();
+    }
+
+    /* Not completed yet. */
+    for (Specification const *specification = this; specification != nullptr; specification = specification->_base.get()) {
+        if (specification->_identifier == identifier) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Specification::
+complete()
+{
+    _lineage.clear();
+    for (Specification const *specification = this; specification != nullptr; specification = specification->_base.get()) {
+        _lineage.insert(specification->_identifier);
+    }
+}
+
+bool Specification::
+parse(Context *context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     auto unpack = plist::Keys::Unpack("Specification", dict, seen);
 
@@ -37,6 +37,10 @@ Tool::~Tool()
 pbxsetting::Level Tool::
 defaultSettings(void) const
 {
+    if (_defaultSettings) {
+        return *_defaultSettings;
+    }
+
     std::vector<pbxsetting::Setting> settings;
     if (_options) {
         for (PBX::PropertyOption::shared_ptr const &option : *_options) {
@@ -48,6 +52,15 @@ defaultSettings(void) const
     return pbxsetting::Level(settings);
 }
 
+void Tool::
+complete()
+{
+    Specification::complete();
+
+    _defaultSettings = ext::nullopt;
+    _defaultSettings = defaultSettings();
+}
+
 Tool::shared_ptr Tool::
 Parse(Context *context, plist::Dictionary const *dict)
 {
@@ -58,7 +71,7 @@ Parse(Context *context, plist::Dictionary const *dict)
     Tool::shared_ptr result;
     result.reset(new Tool());
 
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     if (!result->parse(context, dict, &seen, true))
         return nullptr;
 
@@ -66,7 +79,7 @@ Parse(Context *context, plist::Dictionary const *dict)
 }
 
 bool Tool::
-parse(Context *context, plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(Context *context, plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Specification::parse(context, dict, seen, false))
         return false;
@@ -0,0 +1,92 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <plist/Format/JSON.h>
+#include <plist/Objects.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using plist::Format::JSON;
+using plist::Object;
+using plist::String;
+using plist::Boolean;
+using plist::Integer;
+using plist::Real;
+using plist::Dictionary;
+using plist::Array;
+
+/*
+ * Build a document shaped like a large output file map: a dictionary of
+ * per-file dictionaries, with some numbers mixed in.
+ */
+static std::unique_ptr<Object>
+CreateDocument(size_t files)
+{
+    auto root = Dictionary::New();
+
+    for (size_t n = 0; n < files; n++) {
+        std::string base = "/Users/build/Project/Sources/Module" + std::to_string(n % 97) + "/File" + std::to_string(n);
+
+        auto entry = Dictionary::New();
+        entry->set("object", String::New(base + ".o"));
+        entry->set("swiftmodule", String::New(base + "~partial.swiftmodule"));
+        entry->set("swift-dependencies", String::New(base + ".swiftdeps"));
+        entry->set("diagnostics", String::New(base + ".dia \"quoted\"\tand\\escaped"));
+        entry->set("index", Integer::New(static_cast<int64_t>(n) * 7919));
+        entry->set("weight", Real::New(static_cast<double>(n) / 3.0));
+        entry->set("enabled", Boolean::New((n % 2) == 0));
+
+        root->set(base + ".swift", std::move(entry));
+    }
+
+    return plist::static_unique_pointer_cast<Object>(std::move(root));
+}
+
+int
+main(int argc, char **argv)
+{
+    size_t files = (argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 100000);
+    int iterations = (argc > 2 ? std::atoi(argv[2]) : 5);
+
+    std::unique_ptr<Object> document = CreateDocument(files);
+
+    std::vector<uint8_t> contents;
+    std::chrono::duration<double> serialize = std::chrono::duration<double>::zero();
+    std::chrono::duration<double> deserialize = std::chrono::duration<double>::zero();
+
+    for (int i = 0; i < iterations; i++) {
+        auto start = std::chrono::steady_clock::now();
+        auto result = JSON::Serialize(document.get(), JSON::Create());
+        serialize += std::chrono::steady_clock::now() - start;
+
+        if (result.first == nullptr) {
+            fprintf(stderr, "error: %s\n", result.second.c_str());
+            return 1;
+        }
+        contents = std::move(*result.first);
+
+        start = std::chrono::steady_clock::now();
+        auto parsed = JSON::Deserialize(contents, JSON::Create());
+        deserialize += std::chrono::steady_clock::now() - start;
+
+        if (parsed.first == nullptr) {
+            fprintf(stderr, "error: %s\n", parsed.second.c_str());
+            return 1;
+        }
+    }
+
+    double megabytes = static_cast<double>(contents.size()) * iterations / (1024.0 * 1024.0);
+    printf("document: %zu files, %zu bytes\n", files, contents.size());
+    printf("serialize: %.3f s, %.1f MB/s\n", serialize.count(), megabytes / serialize.count());
+    printf("deserialize: %.3f s, %.1f MB/s\n", deserialize.count(), megabytes / deserialize.count());
+
+    return 0;
+}
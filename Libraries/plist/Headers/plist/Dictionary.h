@@ -20,8 +20,9 @@ namespace plist {
 
 class Dictionary : public Object {
 private:
-    std::vector<std::string>                                 _keys;
-    std::unordered_map<std::string, std::unique_ptr<Object>> _map;
+    std::vector<std::string>                _keys;
+    std::vector<std::unique_ptr<Object>>    _values;
+    std::unordered_map<std::string, size_t> _map;
 
 public:
     Dictionary()
@@ -54,12 +55,12 @@ public:
 
     inline Object const *value(size_t index) const
     {
-        return (index < _keys.size()) ? value(_keys[index]) : nullptr;
+        return (index < _values.size()) ? _values[index].get() : nullptr;
     }
 
     inline Object *value(size_t index)
     {
-        return (index < _keys.size()) ? value(_keys[index]) : nullptr;
+        return (index < _values.size()) ? _values[index].get() : nullptr;
     }
 
     template <typename T>
@@ -77,13 +78,28 @@ public:
     inline Object const *value(std::string const &key) const
     {
         auto it = _map.find(key);
-        return (it != _map.end() ? it->second.get() : nullptr);
+        return (it != _map.end() ? _values[it->second].get() : nullptr);
     }
 
     inline Object *value(std::string const &key)
     {
         auto it = _map.find(key);
-        return (it != _map.end() ? it->second.get() : nullptr);
+        return (it != _map.end() ? _values[it->second].get() : nullptr);
+    }
+
+    /*
+     * Find the index of a key, for use with the index-based accessors.
+     * Returns false if the key is not in the dictionary.
+     */
+    inline bool index(std::string const &key, size_t *index) const
+    {
+        auto it = _map.find(key);
+        if (it == _map.end()) {
+            return false;
+        }
+
+        *index = it->second;
+        return true;
     }
 
     template <typename T>
@@ -102,6 +118,7 @@ public:
     inline void clear()
     {
         _keys.clear();
+        _values.clear();
         _map.clear();
     }
 
@@ -109,8 +126,9 @@ public:
     inline void set(std::string const &key, std::unique_ptr<Object> obj)
     {
         remove(key);
+        _map.insert(std::make_pair(key, _keys.size()));
         _keys.push_back(key);
-        _map.insert(std::make_pair(key, std::move(obj)));
+        _values.push_back(std::move(obj));
     }
 
     inline void remove(std::string const &key)
@@ -118,8 +136,15 @@ public:
         auto it = _map.find(key);
 
         if (it != _map.end()) {
+            size_t index = it->second;
             _map.erase(it);
-            _keys.erase(std::find(_keys.begin(), _keys.end(), key));
+            _keys.erase(_keys.begin() + index);
+            _values.erase(_values.begin() + index);
+
+            /* Shift down the indexes of the keys after the removed one. */
+            for (size_t n = index; n < _keys.size(); n++) {
+                _map[_keys[n]] = n;
+            }
         }
     }
 
@@ -173,8 +198,8 @@ public:
         if (count() != obj->count())
             return false;
 
-        for (auto const &it : _map) {
-            if (!value(it.first)->equals(obj->value(it.first)))
+        for (size_t n = 0; n < _keys.size(); n++) {
+            if (!_values[n]->equals(obj->value(_keys[n])))
                 return false;
         }
 
@@ -13,6 +13,8 @@
 #include <plist/Format/Type.h>
 #include <plist/Format/Encoding.h>
 
+#include <string>
+
 namespace plist {
 namespace Format {
 
@@ -35,6 +37,13 @@ public:
 
 public:
     static ASCII Create(bool strings, Encoding encoding);
+
+public:
+    /*
+     * Decode the escapes in the contents of a quoted string, exactly as
+     * the parser does. For readers of the same format outside the parser.
+     */
+    static std::string UnescapeString(char const *contents, size_t length);
 };
 
 }
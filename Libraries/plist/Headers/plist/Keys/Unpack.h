@@ -13,30 +13,77 @@
 #include <plist/Object.h>
 #include <plist/Dictionary.h>
 
+#include <cstdint>
 #include <string>
 #include <vector>
-#include <unordered_set>
 
 namespace plist {
 namespace Keys {
 
+/*
+ * Tracks which keys of a dictionary have been unpacked. Keys are recorded by
+ * their index in the dictionary, so shared across the unpacks for each level
+ * of a type hierarchy without copying key strings.
+ */
+class Seen {
+private:
+    uint64_t              _inline;
+    std::vector<uint64_t> _overflow;
+
+public:
+    Seen() :
+        _inline(0)
+    {
+    }
+
+public:
+    /*
+     * Mark the key at an index as seen.
+     */
+    inline void insert(size_t index)
+    {
+        if (index < 64) {
+            _inline |= (UINT64_C(1) << index);
+        } else {
+            size_t word = (index - 64) / 64;
+            if (word >= _overflow.size()) {
+                _overflow.resize(word + 1, 0);
+            }
+            _overflow[word] |= (UINT64_C(1) << ((index - 64) % 64));
+        }
+    }
+
+    /*
+     * If the key at an index has been seen.
+     */
+    inline bool contains(size_t index) const
+    {
+        if (index < 64) {
+            return (_inline & (UINT64_C(1) << index)) != 0;
+        } else {
+            size_t word = (index - 64) / 64;
+            return word < _overflow.size() && (_overflow[word] & (UINT64_C(1) << ((index - 64) % 64))) != 0;
+        }
+    }
+};
+
 /*
  * Unpack values from a dictionary with validation. Warn about unknown keys and
  * incorrect types, and support separate parsing for subtype-based parsing.
  */
 class Unpack {
 private:
-    std::string                      _name;
-    Dictionary const                *_dict;
-    std::unordered_set<std::string> *_seen;
-    std::vector<std::string>         _errors;
+    std::string               _name;
+    Dictionary const         *_dict;
+    Seen                     *_seen;
+    std::vector<std::string>  _errors;
 
 public:
     /*
      * Create an unpack for a type with the specified name, unpacking the given
      * dictionary. The seen set is keys that have and will be unpacked from it.
      */
-    Unpack(std::string const &name, Dictionary const *dict, std::unordered_set<std::string> *seen);
+    Unpack(std::string const &name, Dictionary const *dict, Seen *seen);
 
 public:
     /*
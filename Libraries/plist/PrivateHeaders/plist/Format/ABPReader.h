@@ -12,14 +12,13 @@
 #include <plist/Format/ABPContext.h>
 #include <plist/Objects.h>
 
+#include <memory>
 #include <string>
-#include <unordered_set>
 
 class ABPReader : public ABPContext {
 public:
-    plist::Object                       **_objects;
-    std::unordered_set<plist::Object *>   _seen;
-    std::string                           _error;
+    plist::Object **_objects;
+    std::string     _error;
 
 public:
     ABPReader(std::vector<uint8_t> const *contents);
@@ -32,6 +31,12 @@ public:
     plist::Object *readTopLevelObject();
     plist::Object *readObject(uint64_t reference);
 
+    /*
+     * Read an object owned by the caller.
+     */
+    std::unique_ptr<plist::Object> takeTopLevelObject();
+    std::unique_ptr<plist::Object> takeObject(uint64_t reference);
+
 public:
     std::string const &error() const
     { return _error; }
@@ -26,7 +26,9 @@ public:
     ~JSONWriter();
 
 public:
-    std::vector<uint8_t> contents() const
+    std::vector<uint8_t> const &contents() const
+    { return _contents; }
+    std::vector<uint8_t> &contents()
     { return _contents; }
 
 public:
@@ -34,10 +36,13 @@ public:
 
 private:
     bool primitiveWriteString(std::string const &string);
+    bool primitiveWriteString(char const *string, size_t length);
     bool primitiveWriteEscapedString(std::string const &string);
 
 private:
+    bool writeIndent();
     bool writeString(std::string const &string, bool final);
+    bool writeString(char const *string, size_t length, bool final);
     bool writeEscapedString(std::string const &string, bool final);
 
 private:
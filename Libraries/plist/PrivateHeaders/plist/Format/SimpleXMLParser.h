@@ -27,6 +27,9 @@ public:
 public:
     Dictionary *parse(std::vector<uint8_t> const &contents);
 
+private:
+    bool parseSimple(std::vector<uint8_t> const &contents);
+
 private:
     virtual void onBeginParse();
     virtual void onEndParse(bool success);
@@ -0,0 +1,94 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef __plist_Format_XMLTokenizer_h
+#define __plist_Format_XMLTokenizer_h
+
+#include <plist/Base.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace plist {
+namespace Format {
+
+/*
+ * Splits a UTF-8 XML document into element tokens. Only handles the subset
+ * of XML used by simple documents like schemes and workspaces: elements,
+ * attributes, the predefined and numeric entities, comments, processing
+ * instructions and a DOCTYPE without an internal subset. Anything else is
+ * reported as invalid, so the document can be parsed by a full XML parser.
+ */
+class XMLTokenizer {
+public:
+    enum class Token {
+        StartElement,
+        EndElement,
+        End,
+        Invalid,
+    };
+
+private:
+    uint8_t const                                *_current;
+    uint8_t const                                *_end;
+
+private:
+    std::string                                   _name;
+    std::unordered_map<std::string, std::string>  _attributes;
+    size_t                                        _depth;
+    bool                                          _empty;
+    std::vector<std::string>                      _open;
+    bool                                          _rooted;
+
+public:
+    XMLTokenizer(std::vector<uint8_t> const &contents);
+
+public:
+    /*
+     * Read the next token. An empty element is read as a start element,
+     * with empty() set, followed by its end element.
+     */
+    Token next();
+
+public:
+    /*
+     * The name of the current element.
+     */
+    std::string const &name() const
+    { return _name; }
+
+    /*
+     * The attributes of the current start element, with entities replaced.
+     */
+    std::unordered_map<std::string, std::string> const &attributes() const
+    { return _attributes; }
+
+    /*
+     * If the current start element is empty.
+     */
+    bool empty() const
+    { return _empty; }
+
+    /*
+     * The depth of the current element; the root element is zero.
+     */
+    size_t depth() const
+    { return _depth; }
+
+private:
+    bool skipText();
+    bool skipMarkup();
+    bool readName(std::string *name);
+    bool readAttributeValue(std::string *value);
+};
+
+}
+}
+
+#endif  // !__plist_Format_XMLTokenizer_h
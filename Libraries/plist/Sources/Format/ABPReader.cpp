@@ -247,21 +247,12 @@ readArray(size_t nitems)
     array = plist::Array::New();
     for (size_t n = 0; n < nitems; n++) {
         uint64_t objref = objrefs[n];
-        auto object = this->readObject(objref);
+        auto object = this->takeObject(objref);
         if (object == nullptr) {
             goto fail;
         }
 
-        //
-        // Due to the memory layout of the `plist' objects,
-        // we must always copy objects.
-        //
-        if (this->_seen.find(object) != this->_seen.end()) {
-            this->_seen.insert(object);
-        }
-        object = object->copy().release();
-
-        array->append(std::unique_ptr<plist::Object>(object));
+        array->append(std::move(object));
     }
 
 fail:
@@ -311,7 +302,7 @@ readDictionary(size_t nitems)
             goto fail;
         }
 
-        auto object = this->readObject(kvrefs[n * 2 + 1]);
+        auto object = this->takeObject(kvrefs[n * 2 + 1]);
         if (object == nullptr) {
             goto fail;
         }
@@ -324,16 +315,7 @@ readDictionary(size_t nitems)
             goto fail;
         }
 
-        //
-        // Due to the memory layout of the `plist' objects,
-        // we must always copy objects.
-        //
-        if (this->_seen.find(object) != this->_seen.end()) {
-            this->_seen.insert(object);
-        }
-        object = object->copy().release();
-
-        dict->set(keyString->value(), std::unique_ptr<plist::Object>(object));
+        dict->set(keyString->value(), std::move(object));
     }
 
 fail:
@@ -494,6 +476,52 @@ readTopLevelObject()
     return this->readObject(this->_trailer.topLevelObject);
 }
 
+std::unique_ptr<plist::Object> ABPReader::
+takeObject(uint64_t reference)
+{
+    /* Fail if complete, or not opened. */
+    if ((this->_flags & kABPContextComplete) != 0 ||
+        (this->_flags & kABPContextOpened) == 0)
+        return nullptr;
+
+    if (reference >= this->_trailer.objectsCount) {
+        this->error("reference out of range");
+        return nullptr;
+    }
+
+    if (this->_objects[reference] != NULL) {
+        return this->_objects[reference]->copy();
+    }
+
+    if (this->seek(static_cast<size_t>(this->_offsets[reference]), SEEK_SET) < 0) {
+        this->error("object reference's offset out of range");
+        return nullptr;
+    }
+
+    auto object = std::unique_ptr<plist::Object>(this->_readObject());
+    if (object == nullptr) {
+        this->error("failed to create object");
+        return nullptr;
+    }
+
+    //
+    // Containers are read again for each reference rather than cached, so
+    // they can be moved into their parent instead of copied at each level.
+    //
+    if (object->type() == plist::Array::Type() || object->type() == plist::Dictionary::Type()) {
+        return object;
+    }
+
+    this->_objects[reference] = object.release();
+    return this->_objects[reference]->copy();
+}
+
+std::unique_ptr<plist::Object> ABPReader::
+takeTopLevelObject()
+{
+    return this->takeObject(this->_trailer.topLevelObject);
+}
+
 int ABPReader::
 read(void *data, size_t length)
 {
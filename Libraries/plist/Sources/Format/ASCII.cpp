@@ -266,3 +266,22 @@ Create(bool strings, Encoding encoding)
 {
     return ASCII(strings, encoding);
 }
+
+std::string ASCII::
+UnescapeString(char const *contents, size_t length)
+{
+    ASCIIPListLexer lexer;
+    ASCIIPListLexerInit(&lexer, contents, length, kASCIIPListLexerStyleASCII);
+    lexer.tokenBegin = 0;
+    lexer.tokenLength = length;
+
+    /* Same loss byte as the parser; the result is also cut at any null. */
+    char *unescaped = ASCIIPListCopyUnquotedString(&lexer, '?');
+    if (unescaped == nullptr) {
+        return std::string();
+    }
+
+    std::string string = std::string(unescaped);
+    free(unescaped);
+    return string;
+}
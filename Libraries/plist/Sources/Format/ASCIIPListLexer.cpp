@@ -602,9 +602,10 @@ deunicodify(char **pp, int avail, int *eat)
     if (codepoint >= 0x110000)
         codepoint = 0xfffe;
 
-    if (codepoint <= 0x7f)
-        *rep = codepoint;
-    else if (codepoint <= 0x7ff) {
+    if (codepoint <= 0x7f) {
+        *rep++ = codepoint;
+        (*eat) -= 1;
+    } else if (codepoint <= 0x7ff) {
         *rep++ = 0xc0 | (codepoint >> 6);
         *rep++ = 0x80 | (codepoint & 0x3f);
         (*eat) -= 2;
@@ -286,6 +286,13 @@ parse(std::vector<uint8_t> const &contents)
 
     return (ret == S_FALSE);
 #else
+    /*
+     * Initialize libxml2 once before parsing, as parsers can be used from
+     * multiple threads and lazy initialization inside libxml2 is not safe.
+     */
+    static bool initialized = (::xmlInitParser(), true);
+    (void)initialized;
+
     _parser = ::xmlReaderForMemory(reinterpret_cast<char const *>(contents.data()), contents.size(), nullptr, nullptr, XML_PARSE_NOENT | XML_PARSE_NONET);
     if (_parser == nullptr) {
         return false;
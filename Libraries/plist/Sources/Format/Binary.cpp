@@ -58,10 +58,7 @@ Deserialize(std::vector<uint8_t> const &contents, Binary const &format)
 
     std::unique_ptr<Object> object = nullptr;
     if (reader.open()) {
-        Object *topObject = reader.readTopLevelObject();
-        if (topObject != nullptr) {
-            object = topObject->copy();
-        }
+        object = reader.takeTopLevelObject();
         reader.close();
     }
 
@@ -67,7 +67,7 @@ Serialize(Object const *object, JSON const &format)
         return std::make_pair(nullptr, "serialization failed");
     }
 
-    return std::make_pair(std::unique_ptr<std::vector<uint8_t>>(new std::vector<uint8_t>(writer.contents())), std::string());
+    return std::make_pair(std::unique_ptr<std::vector<uint8_t>>(new std::vector<uint8_t>(std::move(writer.contents()))), std::string());
 }
 
 } }
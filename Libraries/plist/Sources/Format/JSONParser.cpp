@@ -10,6 +10,8 @@
 #include <plist/Objects.h>
 
 #include <cstdlib>
+#include <cstring>
+#include <limits>
 
 using plist::Format::JSONParser;
 using plist::Object;
@@ -26,6 +28,112 @@ using plist::Dictionary;
 #define JSONDebug(...)
 #endif
 
+/*
+ * Parse a lexed JSON integer token without copying it. Values that overflow
+ * saturate, matching strtoll().
+ */
+static long long
+ParseInteger(char const *p, size_t length)
+{
+    char const *end = p + length;
+
+    bool negative = (p != end && *p == '-');
+    if (negative) {
+        p++;
+    }
+
+    uint64_t limit = (negative ? static_cast<uint64_t>(std::numeric_limits<long long>::max()) + 1 : static_cast<uint64_t>(std::numeric_limits<long long>::max()));
+    uint64_t value = 0;
+    for (; p != end; ++p) {
+        uint64_t digit = static_cast<uint64_t>(*p - '0');
+        if (value > (limit - digit) / 10) {
+            return (negative ? std::numeric_limits<long long>::min() : std::numeric_limits<long long>::max());
+        }
+        value = value * 10 + digit;
+    }
+
+    return (negative ? static_cast<long long>(0 - value) : static_cast<long long>(value));
+}
+
+/*
+ * Parse a lexed JSON real token. Values with few enough digits to be exact
+ * as a double, and a small exponent, are computed directly with a single
+ * correctly rounded multiply or divide; others fall back to strtod().
+ */
+static double
+ParseReal(char const *p, size_t length)
+{
+    static double const powers[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+
+    char const *begin = p;
+    char const *end = p + length;
+
+    bool negative = (p != end && *p == '-');
+    if (negative) {
+        p++;
+    }
+
+    /* Accumulate significant digits, tracking the implied decimal exponent. */
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool fraction = false;
+    for (; p != end && *p != 'e' && *p != 'E'; ++p) {
+        if (*p == '.') {
+            fraction = true;
+            continue;
+        }
+
+        if (mantissa == 0 && *p == '0') {
+            /* Leading zeros are not significant. */
+        } else {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(*p - '0');
+            if (++digits > 15) {
+                break;
+            }
+        }
+
+        if (fraction) {
+            exponent--;
+        }
+    }
+
+    if (digits <= 15 && p != end) {
+        /* Exponent part. */
+        p++;
+        bool negativeExponent = (*p == '-');
+        if (*p == '+' || *p == '-') {
+            p++;
+        }
+
+        int value = 0;
+        for (; p != end && value < 10000; ++p) {
+            value = value * 10 + (*p - '0');
+        }
+        exponent += (negativeExponent ? -value : value);
+    }
+
+    if (digits <= 15 && p == end && exponent >= -22 && exponent <= 22) {
+        double value = static_cast<double>(mantissa);
+        value = (exponent < 0 ? value / powers[-exponent] : value * powers[exponent]);
+        return (negative ? -value : value);
+    }
+
+    /* Slow path: strtod() needs a NUL-terminated string. */
+    char buffer[64];
+    if (length < sizeof(buffer)) {
+        memcpy(buffer, begin, length);
+        buffer[length] = '\0';
+        return ::strtod(buffer, NULL);
+    } else {
+        std::string copy = std::string(begin, length);
+        return ::strtod(copy.c_str(), NULL);
+    }
+}
+
 JSONParser::
 JSONParser() :
     _root(nullptr),
@@ -476,21 +584,11 @@ parse(ASCIIPListLexer *lexer)
                             return false;
                         }
 
-                        char *end = NULL;
-                        char *contents = ASCIIPListCopyUnquotedString(lexer, '?');
-                        long long value = ::strtoll(contents, &end, 0);
-                        bool success = (end != contents);
-                        free(contents);
+                        long long value = ParseInteger(lexer->inputBuffer + lexer->tokenBegin, lexer->tokenLength);
+                        std::unique_ptr<Integer> integer = Integer::New(value);
 
-                        if (success) {
-                            std::unique_ptr<Integer> integer = Integer::New(value);
-
-                            JSONDebug("Storing integer");
-                            if (!storeValue(std::move(integer))) {
-                                return false;
-                            }
-                        } else {
-                            abort("Unable to parse integer");
+                        JSONDebug("Storing integer");
+                        if (!storeValue(std::move(integer))) {
                             return false;
                         }
                     } else if (token == kASCIIPListLexerTokenNumberReal) {
@@ -499,31 +597,29 @@ parse(ASCIIPListLexer *lexer)
                             return false;
                         }
 
-                        char *end = NULL;
-                        char *contents = ASCIIPListCopyUnquotedString(lexer, '?');
-                        double value = ::strtod(contents, &end);
-                        bool success = (end != contents);
-                        free(contents);
+                        double value = ParseReal(lexer->inputBuffer + lexer->tokenBegin, lexer->tokenLength);
+                        std::unique_ptr<Real> real = Real::New(value);
 
-                        if (success) {
-                            std::unique_ptr<Real> real = Real::New(value);
-
-                            JSONDebug("Storing real");
-                            if (!storeValue(std::move(real))) {
-                                return false;
-                            }
-                        } else {
-                            abort("Unable to parse real");
+                        JSONDebug("Storing real");
+                        if (!storeValue(std::move(real))) {
                             return false;
                         }
                     } else if (token == kASCIIPListLexerTokenQuotedString) {
-                        char *contents = ASCIIPListCopyUnquotedString(lexer, '?');
-                        std::unique_ptr<String> string = String::New(std::string(contents));
-                        free(contents);
+                        char const *begin = lexer->inputBuffer + lexer->tokenBegin;
+                        std::unique_ptr<String> string;
 
-                        if (string == NULL) {
-                            abort("OOM when copying string");
-                            return false;
+                        if (memchr(begin, '\\', lexer->tokenLength) == NULL) {
+                            /* No escapes: construct the string in place. */
+                            string = String::New(std::string(begin, lexer->tokenLength));
+                        } else {
+                            char *contents = ASCIIPListCopyUnquotedString(lexer, '?');
+                            if (contents == NULL) {
+                                abort("OOM when copying string");
+                                return false;
+                            }
+
+                            string = String::New(std::string(contents));
+                            free(contents);
                         }
 
                         /* Container context */
@@ -9,8 +9,14 @@
 #include <plist/Format/JSONWriter.h>
 #include <plist/Objects.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cfloat>
 #include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 
 using plist::Format::JSONWriter;
 using plist::Object;
@@ -25,6 +31,174 @@ using plist::UID;
 using plist::Dictionary;
 using plist::CastTo;
 
+/*
+ * Format an integer in decimal. Returns the length written, not including
+ * the terminating NUL; the buffer must hold at least 21 characters.
+ */
+static size_t
+FormatInteger(int64_t value, char *buf, size_t size)
+{
+    assert(size >= 21);
+    (void)size;
+
+    /* Negate as unsigned so the minimum value does not overflow. */
+    uint64_t magnitude = (value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value));
+
+    char digits[20];
+    size_t count = 0;
+    do {
+        digits[count++] = '0' + static_cast<char>(magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    size_t length = 0;
+    if (value < 0) {
+        buf[length++] = '-';
+    }
+    while (count != 0) {
+        buf[length++] = digits[--count];
+    }
+    buf[length] = '\0';
+
+    return length;
+}
+
+/*
+ * Format a real in the style of "%g" from its significant digits, where the
+ * first digit is at the given power of ten. Returns the length written.
+ */
+static size_t
+FormatRealDigits(bool negative, char const *digits, int count, int exponent, int precision, char *buf, size_t size)
+{
+    /* Trailing zeros are never written. */
+    while (count > 1 && digits[count - 1] == '0') {
+        count--;
+    }
+
+    size_t length = 0;
+    if (negative) {
+        buf[length++] = '-';
+    }
+
+    if (exponent < -4 || exponent >= precision) {
+        buf[length++] = digits[0];
+        if (count > 1) {
+            buf[length++] = '.';
+            memcpy(buf + length, digits + 1, count - 1);
+            length += count - 1;
+        }
+        length += snprintf(buf + length, size - length, "e%+03d", exponent);
+    } else if (exponent < 0) {
+        buf[length++] = '0';
+        buf[length++] = '.';
+        for (int n = exponent + 1; n < 0; n++) {
+            buf[length++] = '0';
+        }
+        memcpy(buf + length, digits, count);
+        length += count;
+    } else {
+        for (int n = 0; n <= exponent; n++) {
+            buf[length++] = (n < count ? digits[n] : '0');
+        }
+        if (count > exponent + 1) {
+            buf[length++] = '.';
+            memcpy(buf + length, digits + exponent + 1, count - exponent - 1);
+            length += count - exponent - 1;
+        }
+    }
+
+    assert(length < size);
+    buf[length] = '\0';
+    return length;
+}
+
+/*
+ * Check if significant digits, with the first at the given power of ten,
+ * parse back to a value.
+ */
+static bool
+RealDigitsEqual(char const *digits, int count, int exponent, double value)
+{
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%c.%.*se%d", digits[0], count - 1, digits + 1, exponent);
+    return ::strtod(buf, NULL) == std::fabs(value);
+}
+
+/*
+ * Format a real with the fewest significant digits that parse back to the
+ * same value. Returns the length written, not including the terminating NUL.
+ *
+ * A normal value that needs 15 or fewer significant digits is written that
+ * way by "%.15g", so that's tried first. Otherwise, each longer precision is
+ * tried in turn, starting from one digit for subnormal values, which have
+ * less precision. Where the gap between values changes, the nearest digits
+ * might not parse back when their neighbor on the other side of the value
+ * does, so both are tried.
+ */
+static size_t
+FormatReal(double value, char *buf, size_t size)
+{
+    int rc = snprintf(buf, size, "%.15g", value);
+    assert(rc > 0 && rc < (int)size);
+
+    if (!std::isfinite(value) || (::strtod(buf, NULL) == value && (value == 0 || std::fabs(value) >= DBL_MIN))) {
+        return static_cast<size_t>(rc);
+    }
+
+    int first = (std::fabs(value) >= DBL_MIN ? 16 : 1);
+    for (int precision = first; precision <= 17; precision++) {
+        /* Split "d.ddde+x" into its digits and exponent. */
+        char scientific[40];
+        snprintf(scientific, sizeof(scientific), "%.*e", precision - 1, std::fabs(value));
+
+        char digits[20];
+        int count = 0;
+        char const *c = scientific;
+        for (; *c != 'e'; c++) {
+            if (*c != '.') {
+                digits[count++] = *c;
+            }
+        }
+        int exponent = atoi(c + 1);
+
+        double nearest = ::strtod(scientific, NULL);
+        if (nearest == std::fabs(value)) {
+            return FormatRealDigits(value < 0, digits, count, exponent, precision, buf, size);
+        }
+
+        /* Step the last digit toward the value. */
+        if (nearest < std::fabs(value)) {
+            int n = count - 1;
+            for (; n >= 0 && digits[n] == '9'; n--) {
+                digits[n] = '0';
+            }
+            if (n >= 0) {
+                digits[n]++;
+            } else {
+                digits[0] = '1';
+                exponent++;
+            }
+        } else {
+            int n = count - 1;
+            for (; n > 0 && digits[n] == '0'; n--) {
+                digits[n] = '9';
+            }
+            digits[n]--;
+            if (digits[0] == '0') {
+                std::fill(digits, digits + count, '9');
+                exponent--;
+            }
+        }
+
+        if (RealDigitsEqual(digits, count, exponent, value)) {
+            return FormatRealDigits(value < 0, digits, count, exponent, precision, buf, size);
+        }
+    }
+
+    /* Seventeen digits always parse back to the same value. */
+    abort();
+}
+
 JSONWriter::
 JSONWriter(Object const *root) :
     _root   (root),
@@ -59,63 +233,91 @@ primitiveWriteString(std::string const &string)
     return true;
 }
 
+bool JSONWriter::
+primitiveWriteString(char const *string, size_t length)
+{
+    _contents.insert(_contents.end(), string, string + length);
+    return true;
+}
+
 bool JSONWriter::
 primitiveWriteEscapedString(std::string const &string)
 {
-    _contents.reserve(_contents.size() + string.size());
+    static char const hex[] = "0123456789abcdef";
 
-    if (!primitiveWriteString("\"")) {
-        return false;
-    }
+    _contents.push_back('"');
 
-    for (char c : string) {
-        if (c < 0x20) {
-            char buf[64];
-            int rc = snprintf(buf, sizeof(buf), "\\%04x", c);
-            assert(rc < (int)sizeof(buf));
-            (void)rc;
+    /* Copy runs of characters that don't need escaping directly. */
+    char const *begin = string.data();
+    char const *end = begin + string.size();
+    char const *run = begin;
 
-            if (!primitiveWriteString(buf)) {
-                return false;
-            }
-        } else {
-            switch (c) {
-                case '"':  if (!primitiveWriteString("\\\"")) { return false; } break;
-                case '\\': if (!primitiveWriteString("\\"))   { return false; } break;
-                default: _contents.push_back(c); break;
+    for (char const *p = begin; p != end; ++p) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        _contents.insert(_contents.end(), run, p);
+        run = p + 1;
+
+        switch (c) {
+            case '"':  _contents.push_back('\\'); _contents.push_back('"'); break;
+            case '\\': _contents.push_back('\\'); _contents.push_back('\\'); break;
+            case '\n': _contents.push_back('\\'); _contents.push_back('n'); break;
+            case '\r': _contents.push_back('\\'); _contents.push_back('r'); break;
+            case '\t': _contents.push_back('\\'); _contents.push_back('t'); break;
+            default: {
+                uint8_t escape[6] = { '\\', 'u', '0', '0', static_cast<uint8_t>(hex[c >> 4]), static_cast<uint8_t>(hex[c & 0xf]) };
+                _contents.insert(_contents.end(), escape, escape + sizeof(escape));
+                break;
             }
         }
     }
 
-    if (!primitiveWriteString("\"")) {
-        return false;
-    }
+    _contents.insert(_contents.end(), run, end);
+    _contents.push_back('"');
 
     return true;
 }
 
+bool JSONWriter::
+writeIndent()
+{
+    _contents.insert(_contents.end(), _indent, '\t');
+    return true;
+}
+
 bool JSONWriter::
 writeString(std::string const &string, bool final)
 {
     if (final) {
-        for (int n = 0; n < _indent; n++) {
-            if (!primitiveWriteString("\t")) {
-                return false;
-            }
+        if (!writeIndent()) {
+            return false;
         }
     }
 
     return primitiveWriteString(string);
 }
 
+bool JSONWriter::
+writeString(char const *string, size_t length, bool final)
+{
+    if (final) {
+        if (!writeIndent()) {
+            return false;
+        }
+    }
+
+    return primitiveWriteString(string, length);
+}
+
 bool JSONWriter::
 writeEscapedString(std::string const &string, bool final)
 {
     if (final) {
-        for (int n = 0; n < _indent; n++) {
-            if (!primitiveWriteString("\t")) {
-                return false;
-            }
+        if (!writeIndent()) {
+            return false;
         }
     }
 
@@ -287,16 +489,12 @@ handleData(Data const *data, bool root)
 
     _lastKey = false;
 
-    std::vector<uint8_t> const &value = data->value();
-    for (auto it : value) {
-        char buf[3];
-        int rc = snprintf(buf, sizeof(buf), "%02x", it);
-        assert(rc < (int)sizeof(buf));
-        (void)rc;
+    static char const hex[] = "0123456789abcdef";
 
-        if (!writeString(buf, false)) {
-            return false;
-        }
+    std::vector<uint8_t> const &value = data->value();
+    for (uint8_t byte : value) {
+        _contents.push_back(hex[byte >> 4]);
+        _contents.push_back(hex[byte & 0xf]);
     }
 
     return writeString("\"", false);
@@ -305,12 +503,10 @@ handleData(Data const *data, bool root)
 bool JSONWriter::
 handleReal(Real const *real, bool root)
 {
-    char buf[64];
-    int rc = snprintf(buf, sizeof(buf), "%g", real->value());
-    assert(rc < (int)sizeof(buf));
-    (void)rc;
+    char buf[32];
+    size_t length = FormatReal(real->value(), buf, sizeof(buf));
 
-    if (!writeString(buf, !_lastKey)) {
+    if (!writeString(buf, length, !_lastKey)) {
         return false;
     }
 
@@ -322,14 +518,10 @@ handleReal(Real const *real, bool root)
 bool JSONWriter::
 handleInteger(Integer const *integer, bool root)
 {
-    int               rc;
-    char              buf[32];
-
-    rc = snprintf(buf, sizeof(buf), "%" PRId64, integer->value());
-    assert(rc < (int)sizeof(buf));
-    (void)rc;
+    char buf[24];
+    size_t length = FormatInteger(integer->value(), buf, sizeof(buf));
 
-    if (!writeString(buf, !_lastKey)) {
+    if (!writeString(buf, length, !_lastKey)) {
         return false;
     }
 
@@ -7,10 +7,12 @@
  */
 
 #include <plist/Format/SimpleXMLParser.h>
+#include <plist/Format/XMLTokenizer.h>
 
 #include <plist/Objects.h>
 
 using plist::Format::SimpleXMLParser;
+using plist::Format::XMLTokenizer;
 using plist::Dictionary;
 
 SimpleXMLParser::SimpleXMLParser() :
@@ -26,12 +28,45 @@ parse(std::vector<uint8_t> const &contents)
     if (_root != nullptr)
         return nullptr;
 
+    /*
+     * Most documents only use simple XML, which can be tokenized much
+     * faster in-tree. Anything else goes through the full XML parser.
+     */
+    if (parseSimple(contents))
+        return _root;
+
     if (!BaseXMLParser::parse(contents))
         return nullptr;
 
     return _root;
 }
 
+bool SimpleXMLParser::
+parseSimple(std::vector<uint8_t> const &contents)
+{
+    XMLTokenizer tokenizer = XMLTokenizer(contents);
+
+    onBeginParse();
+
+    for (;;) {
+        switch (tokenizer.next()) {
+            case XMLTokenizer::Token::StartElement:
+                onStartElement(tokenizer.name(), tokenizer.attributes(), tokenizer.depth());
+                break;
+            case XMLTokenizer::Token::EndElement:
+                onEndElement(tokenizer.name(), tokenizer.depth());
+                break;
+            case XMLTokenizer::Token::End:
+                onEndParse(true);
+                return true;
+            case XMLTokenizer::Token::Invalid:
+                onEndParse(false);
+                _stack.clear();
+                return false;
+        }
+    }
+}
+
 void SimpleXMLParser::
 onBeginParse()
 {
@@ -0,0 +1,395 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <plist/Format/XMLTokenizer.h>
+
+#include <cstring>
+
+using plist::Format::XMLTokenizer;
+
+static inline bool
+IsSpace(uint8_t c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static inline bool
+IsNameStart(uint8_t c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == ':' || c >= 0x80;
+}
+
+static inline bool
+IsName(uint8_t c)
+{
+    return IsNameStart(c) || (c >= '0' && c <= '9') || c == '-' || c == '.';
+}
+
+static bool
+StartsWith(uint8_t const *p, uint8_t const *end, char const *prefix)
+{
+    size_t length = ::strlen(prefix);
+    return static_cast<size_t>(end - p) >= length && ::memcmp(p, prefix, length) == 0;
+}
+
+static uint8_t const *
+Find(uint8_t const *p, uint8_t const *end, char const *needle)
+{
+    for (; p != end; p++) {
+        if (StartsWith(p, end, needle)) {
+            return p;
+        }
+    }
+
+    return nullptr;
+}
+
+static void
+AppendUTF8(std::string *out, uint32_t c)
+{
+    if (c < 0x80) {
+        out->push_back(static_cast<char>(c));
+    } else if (c < 0x800) {
+        out->push_back(static_cast<char>(0xc0 | (c >> 6)));
+        out->push_back(static_cast<char>(0x80 | (c & 0x3f)));
+    } else if (c < 0x10000) {
+        out->push_back(static_cast<char>(0xe0 | (c >> 12)));
+        out->push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3f)));
+        out->push_back(static_cast<char>(0x80 | (c & 0x3f)));
+    } else {
+        out->push_back(static_cast<char>(0xf0 | (c >> 18)));
+        out->push_back(static_cast<char>(0x80 | ((c >> 12) & 0x3f)));
+        out->push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3f)));
+        out->push_back(static_cast<char>(0x80 | (c & 0x3f)));
+    }
+}
+
+/*
+ * Read an entity reference starting at the '&'. Only the predefined
+ * entities and character references are supported.
+ */
+static bool
+ReadEntity(uint8_t const **p, uint8_t const *end, std::string *out)
+{
+    uint8_t const *semicolon = *p;
+    while (semicolon != end && *semicolon != ';') {
+        semicolon++;
+    }
+    if (semicolon == end) {
+        return false;
+    }
+
+    std::string entity = std::string(reinterpret_cast<char const *>(*p + 1), semicolon - (*p + 1));
+    if (entity == "lt") {
+        out->push_back('<');
+    } else if (entity == "gt") {
+        out->push_back('>');
+    } else if (entity == "amp") {
+        out->push_back('&');
+    } else if (entity == "quot") {
+        out->push_back('"');
+    } else if (entity == "apos") {
+        out->push_back('\'');
+    } else if (entity.size() > 1 && entity[0] == '#') {
+        bool hex = (entity[1] == 'x');
+        size_t start = (hex ? 2 : 1);
+        if (start == entity.size() || entity.size() - start > 8) {
+            return false;
+        }
+
+        uint32_t c = 0;
+        for (size_t i = start; i < entity.size(); i++) {
+            char d = entity[i];
+            if (d >= '0' && d <= '9') {
+                c = c * (hex ? 16 : 10) + (d - '0');
+            } else if (hex && d >= 'a' && d <= 'f') {
+                c = c * 16 + (d - 'a' + 10);
+            } else if (hex && d >= 'A' && d <= 'F') {
+                c = c * 16 + (d - 'A' + 10);
+            } else {
+                return false;
+            }
+        }
+
+        if (c == 0 || c > 0x10ffff || (c >= 0xd800 && c <= 0xdfff)) {
+            return false;
+        }
+        AppendUTF8(out, c);
+    } else {
+        return false;
+    }
+
+    *p = semicolon + 1;
+    return true;
+}
+
+XMLTokenizer::
+XMLTokenizer(std::vector<uint8_t> const &contents) :
+    _current(contents.data()),
+    _end    (contents.data() + contents.size()),
+    _depth  (0),
+    _empty  (false),
+    _rooted (false)
+{
+    /* Skip a UTF-8 byte order mark. */
+    if (StartsWith(_current, _end, "\xef\xbb\xbf")) {
+        _current += 3;
+    }
+}
+
+bool XMLTokenizer::
+skipText()
+{
+    std::string scratch;
+
+    while (_current != _end && *_current != '<') {
+        if (_open.empty()) {
+            /* Only whitespace is allowed outside of the root element. */
+            if (!IsSpace(*_current)) {
+                return false;
+            }
+            _current++;
+        } else if (*_current == '&') {
+            if (!ReadEntity(&_current, _end, &scratch)) {
+                return false;
+            }
+        } else {
+            _current++;
+        }
+    }
+
+    return true;
+}
+
+bool XMLTokenizer::
+skipMarkup()
+{
+    if (StartsWith(_current, _end, "<?")) {
+        uint8_t const *close = Find(_current + 2, _end, "?>");
+        if (close == nullptr) {
+            return false;
+        }
+        _current = close + 2;
+        return true;
+    } else if (StartsWith(_current, _end, "<!--")) {
+        uint8_t const *close = Find(_current + 4, _end, "-->");
+        if (close == nullptr) {
+            return false;
+        }
+        _current = close + 3;
+        return true;
+    } else if (StartsWith(_current, _end, "<![CDATA[")) {
+        if (_open.empty()) {
+            return false;
+        }
+        uint8_t const *close = Find(_current + 9, _end, "]]>");
+        if (close == nullptr) {
+            return false;
+        }
+        _current = close + 3;
+        return true;
+    } else if (StartsWith(_current, _end, "<!DOCTYPE")) {
+        if (_rooted) {
+            return false;
+        }
+
+        /* Internal subsets can declare entities, which are not supported. */
+        uint8_t quote = '\0';
+        for (_current += 9; _current != _end; _current++) {
+            if (quote != '\0') {
+                if (*_current == quote) {
+                    quote = '\0';
+                }
+            } else if (*_current == '"' || *_current == '\'') {
+                quote = *_current;
+            } else if (*_current == '[') {
+                return false;
+            } else if (*_current == '>') {
+                _current++;
+                return true;
+            }
+        }
+        return false;
+    } else {
+        return false;
+    }
+}
+
+bool XMLTokenizer::
+readName(std::string *name)
+{
+    uint8_t const *start = _current;
+    if (_current == _end || !IsNameStart(*_current)) {
+        return false;
+    }
+
+    while (_current != _end && IsName(*_current)) {
+        _current++;
+    }
+
+    name->assign(reinterpret_cast<char const *>(start), _current - start);
+    return true;
+}
+
+bool XMLTokenizer::
+readAttributeValue(std::string *value)
+{
+    if (_current == _end || (*_current != '"' && *_current != '\'')) {
+        return false;
+    }
+    uint8_t quote = *_current++;
+
+    value->clear();
+    while (_current != _end && *_current != quote) {
+        uint8_t c = *_current;
+        if (c == '<') {
+            return false;
+        } else if (c == '&') {
+            if (!ReadEntity(&_current, _end, value)) {
+                return false;
+            }
+        } else if (c == '\r') {
+            /* Line endings and whitespace are normalized to a space. */
+            value->push_back(' ');
+            _current++;
+            if (_current != _end && *_current == '\n') {
+                _current++;
+            }
+        } else if (c == '\n' || c == '\t') {
+            value->push_back(' ');
+            _current++;
+        } else {
+            value->push_back(static_cast<char>(c));
+            _current++;
+        }
+    }
+
+    if (_current == _end) {
+        return false;
+    }
+
+    _current++;
+    return true;
+}
+
+XMLTokenizer::Token XMLTokenizer::
+next()
+{
+    if (_empty) {
+        _empty = false;
+        return Token::EndElement;
+    }
+
+    for (;;) {
+        if (!skipText()) {
+            return Token::Invalid;
+        }
+
+        if (_current == _end) {
+            return (_rooted && _open.empty() ? Token::End : Token::Invalid);
+        }
+
+        if (StartsWith(_current, _end, "<?") || StartsWith(_current, _end, "<!")) {
+            if (!skipMarkup()) {
+                return Token::Invalid;
+            }
+            continue;
+        }
+
+        _current++;
+
+        if (_current != _end && *_current == '/') {
+            _current++;
+
+            if (!readName(&_name)) {
+                return Token::Invalid;
+            }
+            while (_current != _end && IsSpace(*_current)) {
+                _current++;
+            }
+            if (_current == _end || *_current != '>') {
+                return Token::Invalid;
+            }
+            _current++;
+
+            if (_open.empty() || _open.back() != _name) {
+                return Token::Invalid;
+            }
+            _open.pop_back();
+
+            _depth = _open.size();
+            return Token::EndElement;
+        }
+
+        /* Only one root element is allowed. */
+        if (_open.empty() && _rooted) {
+            return Token::Invalid;
+        }
+
+        if (!readName(&_name)) {
+            return Token::Invalid;
+        }
+
+        _attributes.clear();
+        for (;;) {
+            bool space = false;
+            while (_current != _end && IsSpace(*_current)) {
+                space = true;
+                _current++;
+            }
+
+            if (_current == _end) {
+                return Token::Invalid;
+            } else if (*_current == '>') {
+                _current++;
+                _empty = false;
+                break;
+            } else if (*_current == '/') {
+                _current++;
+                if (_current == _end || *_current != '>') {
+                    return Token::Invalid;
+                }
+                _current++;
+                _empty = true;
+                break;
+            } else if (!space) {
+                return Token::Invalid;
+            }
+
+            std::string name;
+            if (!readName(&name)) {
+                return Token::Invalid;
+            }
+            while (_current != _end && IsSpace(*_current)) {
+                _current++;
+            }
+            if (_current == _end || *_current != '=') {
+                return Token::Invalid;
+            }
+            _current++;
+            while (_current != _end && IsSpace(*_current)) {
+                _current++;
+            }
+
+            std::string value;
+            if (!readAttributeValue(&value)) {
+                return Token::Invalid;
+            }
+            if (!_attributes.insert({ std::move(name), std::move(value) }).second) {
+                return Token::Invalid;
+            }
+        }
+
+        _rooted = true;
+        _depth = _open.size();
+        if (!_empty) {
+            _open.push_back(_name);
+        }
+        return Token::StartElement;
+    }
+}
@@ -9,11 +9,12 @@
 #include <plist/Keys/Unpack.h>
 
 using plist::Keys::Unpack;
+using plist::Keys::Seen;
 using plist::Object;
 using plist::Dictionary;
 
 Unpack::
-Unpack(std::string const &name, Dictionary const *dict, std::unordered_set<std::string> *seen) :
+Unpack(std::string const &name, Dictionary const *dict, Seen *seen) :
     _name(name),
     _dict(dict),
     _seen(seen)
@@ -23,8 +24,13 @@ Unpack(std::string const &name, Dictionary const *dict, std::unordered_set<std::
 Object const *Unpack::
 value(std::string const &key)
 {
-    _seen->insert(key);
-    return _dict->value(key);
+    size_t index;
+    if (!_dict->index(key, &index)) {
+        return nullptr;
+    }
+
+    _seen->insert(index);
+    return _dict->value(index);
 }
 
 bool Unpack::
@@ -32,9 +38,8 @@ complete(bool check)
 {
     if (check) {
         for (size_t n = 0; n < _dict->count(); n++) {
-            std::string const &key = _dict->key(n);
-            if (_seen->find(key) == _seen->end()) {
-                _errors.push_back("unhandled " + _name + " key " + key);
+            if (!_seen->contains(n)) {
+                _errors.push_back("unhandled " + _name + " key " + _dict->key(n));
             }
         }
     }
@@ -56,3 +56,27 @@ TEST(Binary, UnicodeString)
     EXPECT_EQ(*serialize.first, contents);
 }
 
+TEST(Binary, NestedContainers)
+{
+    /* Nested and repeated containers and values survive a round trip. */
+    auto leaf = Dictionary::New();
+    leaf->set("Name", String::New("leaf"));
+    leaf->set("Count", plist::Integer::New(3));
+
+    auto array = plist::Array::New();
+    array->append(leaf->copy());
+    array->append(leaf->copy());
+    array->append(String::New("leaf"));
+
+    auto root = Dictionary::New();
+    root->set("Items", array->copy());
+    root->set("Nested", Dictionary::New());
+    root->value <Dictionary> ("Nested")->set("Items", std::move(array));
+
+    auto serialize = Binary::Serialize(root.get(), Binary::Create());
+    ASSERT_NE(serialize.first, nullptr);
+
+    auto deserialize = Binary::Deserialize(*serialize.first, Binary::Create());
+    ASSERT_NE(deserialize.first, nullptr);
+    EXPECT_TRUE(deserialize.first->equals(root.get()));
+}
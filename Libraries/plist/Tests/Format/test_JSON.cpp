@@ -10,6 +10,8 @@
 #include <plist/Format/JSON.h>
 #include <plist/Objects.h>
 
+#include <cmath>
+
 using plist::Format::JSON;
 using plist::Format::Encoding;
 using plist::String;
@@ -137,3 +139,84 @@ TEST(JSON, Number)
     auto deserialize6 = JSON::Deserialize(contents6, JSON::Create());
     EXPECT_EQ(deserialize6.first, nullptr);
 }
+
+TEST(JSON, Integer)
+{
+    auto contents = Contents("[\n\t0,\n\t-1,\n\t9223372036854775807,\n\t-9223372036854775808\n]");
+
+    auto deserialize = JSON::Deserialize(contents, JSON::Create());
+    ASSERT_NE(deserialize.first, nullptr);
+
+    auto array = Array::New();
+    array->append(Integer::New(0));
+    array->append(Integer::New(-1));
+    array->append(Integer::New(INT64_MAX));
+    array->append(Integer::New(INT64_MIN));
+    EXPECT_TRUE(deserialize.first->equals(array.get()));
+
+    auto serialize = JSON::Serialize(array.get(), JSON::Create());
+    ASSERT_NE(serialize.first, nullptr);
+    EXPECT_EQ(*serialize.first, contents);
+}
+
+TEST(JSON, Real)
+{
+    double values[] = { 0.1, 0.5, -2.75, 1.0 / 3.0, 1e-7, 6.02214076e23, 1.7976931348623157e308, 5e-324, 123456789.12345678 };
+
+    auto array = Array::New();
+    for (double value : values) {
+        array->append(Real::New(value));
+    }
+
+    auto serialize = JSON::Serialize(array.get(), JSON::Create());
+    ASSERT_NE(serialize.first, nullptr);
+
+    /* Reals round trip exactly. */
+    auto deserialize = JSON::Deserialize(*serialize.first, JSON::Create());
+    ASSERT_NE(deserialize.first, nullptr);
+    EXPECT_TRUE(deserialize.first->equals(array.get()));
+
+    /* And are written with the fewest digits needed. */
+    auto short1 = Real::New(0.1);
+    auto serialize1 = JSON::Serialize(short1.get(), JSON::Create());
+    ASSERT_NE(serialize1.first, nullptr);
+    EXPECT_EQ(*serialize1.first, Contents("0.1"));
+
+    /* Including subnormal values, and where the gap between values changes. */
+    auto short2 = Array::New();
+    short2->append(Real::New(5e-324));
+    short2->append(Real::New(std::ldexp(1.0, -1017)));
+    short2->append(Real::New(-1e23));
+    auto serialize2 = JSON::Serialize(short2.get(), JSON::Create());
+    ASSERT_NE(serialize2.first, nullptr);
+    EXPECT_EQ(*serialize2.first, Contents("[\n\t5e-324,\n\t7.120236347223045e-307,\n\t-1e+23\n]"));
+}
+
+TEST(JSON, RealSlowPath)
+{
+    /* Too many digits for an exact fast path. */
+    auto contents = Contents("[ 3.14159265358979323846, 1.5e300, 2.5E-300, 100000000000000000000000000.0 ]");
+
+    auto deserialize = JSON::Deserialize(contents, JSON::Create());
+    ASSERT_NE(deserialize.first, nullptr);
+
+    auto array = Array::New();
+    array->append(Real::New(3.14159265358979323846));
+    array->append(Real::New(1.5e300));
+    array->append(Real::New(2.5e-300));
+    array->append(Real::New(1e26));
+    EXPECT_TRUE(deserialize.first->equals(array.get()));
+}
+
+TEST(JSON, Escape)
+{
+    auto string = String::New("quote \" backslash \\ newline \n tab \t control \x01 unicode \xc3\xa9");
+
+    auto serialize = JSON::Serialize(string.get(), JSON::Create());
+    ASSERT_NE(serialize.first, nullptr);
+    EXPECT_EQ(*serialize.first, Contents("\"quote \\\" backslash \\\\ newline \\n tab \\t control \\u0001 unicode \xc3\xa9\""));
+
+    auto deserialize = JSON::Deserialize(*serialize.first, JSON::Create());
+    ASSERT_NE(deserialize.first, nullptr);
+    EXPECT_TRUE(deserialize.first->equals(string.get()));
+}
@@ -0,0 +1,110 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <plist/Format/SimpleXML.h>
+#include <plist/Objects.h>
+
+using plist::Format::SimpleXML;
+using plist::Format::Encoding;
+using plist::String;
+using plist::Boolean;
+using plist::Dictionary;
+using plist::Array;
+
+static std::vector<uint8_t>
+Contents(std::string const &string)
+{
+    return std::vector<uint8_t>(string.begin(), string.end());
+}
+
+static std::unique_ptr<Dictionary>
+Expected()
+{
+    auto reference = Dictionary::New();
+    reference->set("BlueprintName", String::New("App & \"Tests\""));
+    reference->set("ReferencedContainer", String::New("container:App.xcodeproj"));
+
+    auto first = Dictionary::New();
+    first->set("buildForTesting", Boolean::New(true));
+    first->set("buildForRunning", Boolean::New(false));
+    first->set("BuildableReference", std::move(reference));
+
+    auto second = Dictionary::New();
+    second->set("name", String::New("a b\xc3\xa9"));
+
+    auto entries = Array::New();
+    entries->append(std::move(first));
+    entries->append(std::move(second));
+
+    auto buildActionEntries = Dictionary::New();
+    buildActionEntries->set("BuildActionEntry", std::move(entries));
+
+    auto buildAction = Dictionary::New();
+    buildAction->set("parallelizeBuildables", Boolean::New(true));
+    buildAction->set("BuildActionEntries", std::move(buildActionEntries));
+
+    auto scheme = Dictionary::New();
+    scheme->set("version", String::New("1.3"));
+    scheme->set("BuildAction", std::move(buildAction));
+
+    auto root = Dictionary::New();
+    root->set("Scheme", std::move(scheme));
+    return root;
+}
+
+static std::string const Body =
+    "<Scheme\n"
+    "   version = \"1.3\">\n"
+    "   <!-- Build the app. -->\n"
+    "   <BuildAction\n"
+    "      parallelizeBuildables = 'YES'>\n"
+    "      <BuildActionEntries>\n"
+    "         <BuildActionEntry\n"
+    "            buildForTesting = \"YES\"\n"
+    "            buildForRunning = \"NO\">\n"
+    "            <BuildableReference\n"
+    "               BlueprintName = \"App &amp; &quot;Tests&quot;\"\n"
+    "               ReferencedContainer = \"container:App.xcodeproj\">\n"
+    "            </BuildableReference>\n"
+    "         </BuildActionEntry>\n"
+    "         <BuildActionEntry name=\"a\tb&#xe9;\"/>\n"
+    "      </BuildActionEntries>\n"
+    "   </BuildAction>\n"
+    "</Scheme>\n";
+
+TEST(SimpleXML, Deserialize)
+{
+    auto contents = Contents("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n" + Body);
+    EXPECT_NE(SimpleXML::Identify(contents), nullptr);
+
+    auto deserialize = SimpleXML::Deserialize(contents, SimpleXML::Create(Encoding::UTF8));
+    ASSERT_NE(deserialize.first, nullptr);
+    EXPECT_TRUE(deserialize.first->equals(Expected().get()));
+}
+
+TEST(SimpleXML, DeserializeDocumentType)
+{
+    /* An internal subset is not simple XML, but must parse the same way. */
+    auto contents = Contents("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<!DOCTYPE Scheme [ <!ENTITY tests \"&quot;Tests&quot;\"> ]>\n" + Body);
+    auto deserialize = SimpleXML::Deserialize(contents, SimpleXML::Create(Encoding::UTF8));
+    ASSERT_NE(deserialize.first, nullptr);
+    EXPECT_TRUE(deserialize.first->equals(Expected().get()));
+}
+
+TEST(SimpleXML, Invalid)
+{
+    auto mismatched = Contents("<Scheme><BuildAction></Scheme></BuildAction>");
+    EXPECT_EQ(SimpleXML::Deserialize(mismatched, SimpleXML::Create(Encoding::UTF8)).first, nullptr);
+
+    auto unterminated = Contents("<Scheme version=\"1.3\">");
+    EXPECT_EQ(SimpleXML::Deserialize(unterminated, SimpleXML::Create(Encoding::UTF8)).first, nullptr);
+
+    auto entity = Contents("<Scheme version=\"&unknown;\"/>");
+    EXPECT_EQ(SimpleXML::Deserialize(entity, SimpleXML::Create(Encoding::UTF8)).first, nullptr);
+}
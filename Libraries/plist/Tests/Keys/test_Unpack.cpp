@@ -0,0 +1,98 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <plist/Objects.h>
+#include <plist/Keys/Unpack.h>
+
+using plist::Dictionary;
+using plist::Integer;
+using plist::String;
+using plist::Keys::Seen;
+using plist::Keys::Unpack;
+
+TEST(Unpack, Complete)
+{
+    auto dict = Dictionary::New();
+    dict->set("a", String::New("a"));
+    dict->set("b", Integer::New(1));
+
+    Seen seen;
+    auto unpack = Unpack("Test", dict.get(), &seen);
+    EXPECT_NE(nullptr, unpack.cast<String>("a"));
+    EXPECT_NE(nullptr, unpack.cast<Integer>("b"));
+    EXPECT_EQ(nullptr, unpack.cast<String>("c"));
+    EXPECT_TRUE(unpack.complete(true));
+}
+
+TEST(Unpack, Unhandled)
+{
+    auto dict = Dictionary::New();
+    dict->set("a", String::New("a"));
+    dict->set("b", String::New("b"));
+
+    Seen seen;
+    auto unpack = Unpack("Test", dict.get(), &seen);
+    EXPECT_NE(nullptr, unpack.cast<String>("a"));
+    EXPECT_FALSE(unpack.complete(true));
+    EXPECT_EQ(1, unpack.errors().size());
+    EXPECT_EQ("unhandled Test key b", unpack.errors().front());
+}
+
+TEST(Unpack, SharedSeen)
+{
+    auto dict = Dictionary::New();
+    dict->set("base", String::New("base"));
+    dict->set("derived", String::New("derived"));
+
+    /* Parsing a type hierarchy shares the seen keys between levels. */
+    Seen seen;
+    auto base = Unpack("Base", dict.get(), &seen);
+    EXPECT_NE(nullptr, base.cast<String>("base"));
+    EXPECT_TRUE(base.complete(false));
+
+    auto derived = Unpack("Derived", dict.get(), &seen);
+    EXPECT_NE(nullptr, derived.cast<String>("derived"));
+    EXPECT_TRUE(derived.complete(true));
+}
+
+TEST(Unpack, ManyKeys)
+{
+    auto dict = Dictionary::New();
+    for (int n = 0; n < 200; n++) {
+        dict->set("key" + std::to_string(n), Integer::New(n));
+    }
+
+    Seen seen;
+    auto unpack = Unpack("Test", dict.get(), &seen);
+    for (int n = 0; n < 200; n++) {
+        if (n != 130) {
+            EXPECT_NE(nullptr, unpack.cast<Integer>("key" + std::to_string(n)));
+        }
+    }
+    EXPECT_FALSE(unpack.complete(true));
+    EXPECT_EQ(1, unpack.errors().size());
+    EXPECT_EQ("unhandled Test key key130", unpack.errors().front());
+}
+
+TEST(Unpack, RemovedKey)
+{
+    auto dict = Dictionary::New();
+    dict->set("a", String::New("a"));
+    dict->set("b", String::New("b"));
+    dict->set("c", String::New("c"));
+    dict->remove("a");
+
+    Seen seen;
+    auto unpack = Unpack("Test", dict.get(), &seen);
+    EXPECT_NE(nullptr, unpack.cast<String>("c"));
+    EXPECT_EQ(nullptr, unpack.cast<String>("a"));
+    EXPECT_FALSE(unpack.complete(true));
+    EXPECT_EQ(1, unpack.errors().size());
+    EXPECT_EQ("unhandled Test key b", unpack.errors().front());
+}
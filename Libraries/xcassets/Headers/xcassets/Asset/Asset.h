@@ -17,10 +17,10 @@
 #include <memory>
 #include <set>
 #include <string>
-#include <unordered_set>
 #include <ext/optional>
 
 namespace libutil { class Filesystem; }
+namespace plist { namespace Keys { class Seen; } }
 
 namespace xcassets {
 namespace Asset {
@@ -113,7 +113,7 @@ protected:
     /*
      * Override to parse the contents, which can be null.
      */
-    virtual bool parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check);
+    virtual bool parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check);
 };
 
 }
@@ -36,7 +36,7 @@ public:
     static std::unique_ptr<Catalog> Load(libutil::Filesystem const *filesystem, std::string const &path);
 
 protected:
-    virtual bool parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check);
+    virtual bool parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check);
 };
 
 }
@@ -65,7 +65,7 @@ public:
     { return std::string("complicationset"); }
 
 protected:
-    virtual bool parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check);
+    virtual bool parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check);
 };
 
 }
@@ -73,7 +73,7 @@ public:
 
 protected:
     virtual bool load(libutil::Filesystem const *filesystem);
-    virtual bool parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check);
+    virtual bool parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check);
 };
 
 }
@@ -18,7 +18,7 @@ using xcassets::Asset::AppIconSet;
 bool AppIconSet::Image::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("AppIconSetImage", dict, &seen);
 
     auto FN = unpack.cast <plist::String> ("filename");
@@ -70,7 +70,7 @@ parse(plist::Dictionary const *dict)
 }
 
 bool AppIconSet::
-parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!this->children().empty()) {
         fprintf(stderr, "warning: unexpected child assets\n");
@@ -95,7 +95,7 @@ parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool
     }
 
     if (P != nullptr) {
-        std::unordered_set<std::string> seen;
+        plist::Keys::Seen seen;
         auto unpack = plist::Keys::Unpack("AppIconSet", P, &seen);
 
         auto PR = unpack.cast <plist::Boolean> ("pre-rendered");
@@ -96,7 +96,7 @@ child(ext::optional<AssetType> type) const
 }
 
 bool Asset::
-parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     /* No contents is allowed for some assets. */
     if (dict == nullptr) {
@@ -112,7 +112,7 @@ parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool
     }
 
     if (I != nullptr) {
-        std::unordered_set<std::string> seen;
+        plist::Keys::Seen seen;
         auto unpack = plist::Keys::Unpack("Info", I, &seen);
 
         auto A = unpack.cast <plist::String> ("author");
@@ -297,10 +297,10 @@ LoadChildren(Filesystem const *filesystem, std::string const &path, FullyQualifi
 {
     bool error = false;
 
-    filesystem->readDirectory(path, false, [&](std::string const &fileName) -> void {
-        std::string child = path + "/" + fileName;
+    filesystem->enumerateDirectory(path, false, false, [&](Filesystem::DirectoryEntry const &entry) -> void {
+        std::string child = path + "/" + entry.path;
 
-        if (filesystem->type(child) == Filesystem::Type::Directory) {
+        if (entry.type == Filesystem::Type::Directory) {
             std::vector<std::string> groups = name.groups();
             if (providesNamespace) {
                 // TODO: Should fully qualified names include extensions?
@@ -356,7 +356,7 @@ load(Filesystem const *filesystem)
     /*
      * Parse the contents dictionary.
      */
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     if (!this->parse(contentsDictionary.get(), &seen, true)) {
         return false;
     }
@@ -14,7 +14,7 @@ using xcassets::Asset::Catalog;
 using libutil::Filesystem;
 
 bool Catalog::
-parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Asset::parse(dict, seen, false)) {
         return false;
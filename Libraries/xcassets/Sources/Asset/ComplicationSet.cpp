@@ -16,7 +16,7 @@ using xcassets::Asset::ComplicationSet;
 bool ComplicationSet::ComplicationAsset::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("ComplicationSetComplicationAsset", dict, &seen);
 
     auto F = unpack.cast <plist::String> ("filename");
@@ -43,7 +43,7 @@ parse(plist::Dictionary const *dict)
 }
 
 bool ComplicationSet::
-parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Asset::parse(dict, seen, false)) {
         return false;
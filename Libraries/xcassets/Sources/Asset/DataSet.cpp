@@ -16,7 +16,7 @@ using xcassets::Asset::DataSet;
 bool DataSet::Data::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("ImageSetImage", dict, &seen);
 
     auto CS  = unpack.cast <plist::String> ("color-space");
@@ -58,7 +58,7 @@ parse(plist::Dictionary const *dict)
 }
 
 bool DataSet::
-parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!this->children().empty()) {
         fprintf(stderr, "warning: unexpected child assets\n");
@@ -83,7 +83,7 @@ parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool
     }
 
     if (P != nullptr) {
-        std::unordered_set<std::string> seen;
+        plist::Keys::Seen seen;
         auto unpack = plist::Keys::Unpack("Properties", P, &seen);
 
         auto ODRT = unpack.cast <plist::Array> ("on-demand-resource-tags");
@@ -13,7 +13,7 @@
 using xcassets::Asset::GCLeaderboardSet;
 
 bool GCLeaderboardSet::
-parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Asset::parse(dict, seen, false)) {
         return false;
@@ -30,7 +30,7 @@ parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool
         }
 
         if (P != nullptr) {
-            std::unordered_set<std::string> seen;
+            plist::Keys::Seen seen;
             auto unpack = plist::Keys::Unpack("Properties", P, &seen);
 
             auto CR = unpack.cast <plist::Dictionary> ("content-reference");
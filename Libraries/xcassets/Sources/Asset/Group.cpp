@@ -15,7 +15,7 @@
 using xcassets::Asset::Group;
 
 bool Group::
-parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Asset::parse(dict, seen, false)) {
         return false;
@@ -32,7 +32,7 @@ parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool
         }
 
         if (P != nullptr) {
-            std::unordered_set<std::string> seen;
+            plist::Keys::Seen seen;
             auto unpack = plist::Keys::Unpack("Properties", P, &seen);
 
             auto ODRT = unpack.cast <plist::Array> ("on-demand-resource-tags");
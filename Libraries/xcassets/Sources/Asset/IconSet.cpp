@@ -109,7 +109,7 @@ load(Filesystem const *filesystem)
 }
 
 bool IconSet::
-parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!this->children().empty()) {
         fprintf(stderr, "warning: unexpected child assets\n");
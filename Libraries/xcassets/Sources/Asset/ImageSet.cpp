@@ -17,7 +17,7 @@ using xcassets::Asset::ImageSet;
 bool ImageSet::Image::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("ImageSetImage", dict, &seen);
 
     auto CS  = unpack.cast <plist::String> ("color-space");
@@ -105,7 +105,7 @@ parse(plist::Dictionary const *dict)
 }
 
 bool ImageSet::
-parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!this->children().empty()) {
         fprintf(stderr, "warning: unexpected child assets\n");
@@ -130,7 +130,7 @@ parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool
     }
 
     if (P != nullptr) {
-        std::unordered_set<std::string> seen;
+        plist::Keys::Seen seen;
         auto unpack = plist::Keys::Unpack("Properties", P, &seen);
 
         auto TRI  = unpack.cast <plist::String> ("template-rendering-intent");
@@ -16,7 +16,7 @@ using xcassets::Asset::LaunchImage;
 bool LaunchImage::Image::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("LaunchImageImage", dict, &seen);
 
     auto F   = unpack.cast <plist::String> ("filename");
@@ -63,7 +63,7 @@ parse(plist::Dictionary const *dict)
 }
 
 bool LaunchImage::
-parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!this->children().empty()) {
         fprintf(stderr, "warning: unexpected child assets\n");
@@ -17,7 +17,7 @@ using xcassets::Asset::MipmapSet;
 bool MipmapSet::Level::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("MipmapSetLevel", dict, &seen);
 
     auto F  = unpack.cast <plist::String> ("filename");
@@ -39,7 +39,7 @@ parse(plist::Dictionary const *dict)
 }
 
 bool MipmapSet::
-parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!this->children().empty()) {
         fprintf(stderr, "warning: unexpected child assets\n");
@@ -64,7 +64,7 @@ parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool
     }
 
     if (P != nullptr) {
-        std::unordered_set<std::string> seen;
+        plist::Keys::Seen seen;
         auto unpack = plist::Keys::Unpack("Properties", P, &seen);
 
         auto LM = unpack.cast <plist::String> ("level-mode");
@@ -17,7 +17,7 @@ using xcassets::Asset::SpriteAtlas;
 using xcassets::Asset::ImageSet;
 
 bool SpriteAtlas::
-parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Asset::parse(dict, seen, false)) {
         return false;
@@ -34,7 +34,7 @@ parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool
         }
 
         if (P != nullptr) {
-            std::unordered_set<std::string> seen;
+            plist::Keys::Seen seen;
             auto unpack = plist::Keys::Unpack("Properties", P, &seen);
 
             auto CT   = unpack.cast <plist::String> ("compression-type");
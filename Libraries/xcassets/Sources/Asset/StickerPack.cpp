@@ -16,7 +16,7 @@ using xcassets::Asset::StickerPack;
 bool StickerPack::Sticker::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("StickerPackSticker", dict, &seen);
 
     auto F = unpack.cast <plist::String> ("filename");
@@ -33,7 +33,7 @@ parse(plist::Dictionary const *dict)
 }
 
 bool StickerPack::
-parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Asset::parse(dict, seen, false)) {
         return false;
@@ -54,7 +54,7 @@ parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool
     }
 
     if (P != nullptr) {
-        std::unordered_set<std::string> seen;
+        plist::Keys::Seen seen;
         auto unpack = plist::Keys::Unpack("Properties", P, &seen);
 
         auto GS = unpack.cast <plist::String> ("grid-size");
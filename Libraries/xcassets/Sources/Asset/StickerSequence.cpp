@@ -17,7 +17,7 @@ using xcassets::Asset::StickerSequence;
 bool StickerSequence::Frame::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("StickerSequenceFrame", dict, &seen);
 
     auto F = unpack.cast <plist::String> ("filename");
@@ -34,7 +34,7 @@ parse(plist::Dictionary const *dict)
 }
 
 bool StickerSequence::
-parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!this->children().empty()) {
         fprintf(stderr, "warning: unexpected child assets\n");
@@ -59,7 +59,7 @@ parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool
     }
 
     if (P != nullptr) {
-        std::unordered_set<std::string> seen;
+        plist::Keys::Seen seen;
         auto unpack = plist::Keys::Unpack("Properties", P, &seen);
 
         auto AL = unpack.cast <plist::String> ("accessibility-label");
@@ -14,7 +14,7 @@ using xcassets::Asset::Stickers;
 using libutil::Filesystem;
 
 bool Stickers::
-parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Asset::parse(dict, seen, false)) {
         return false;
@@ -20,7 +20,7 @@ using Platforms = StickersIconSet::Platforms;
 bool StickersIconSet::Image::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("StickersIconSetImage", dict, &seen);
 
     auto FN = unpack.cast <plist::String> ("filename");
@@ -57,7 +57,7 @@ parse(plist::Dictionary const *dict)
 }
 
 bool StickersIconSet::
-parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!this->children().empty()) {
         fprintf(stderr, "warning: unexpected child assets\n");
@@ -17,7 +17,7 @@ using xcassets::Asset::TextureSet;
 bool TextureSet::Texture::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("TextureSetTexture", dict, &seen);
 
     auto CS  = unpack.cast <plist::String> ("color-space");
@@ -64,7 +64,7 @@ parse(plist::Dictionary const *dict)
 }
 
 bool TextureSet::
-parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool check)
+parse(plist::Dictionary const *dict, plist::Keys::Seen *seen, bool check)
 {
     if (!Asset::parse(dict, seen, false)) {
         return false;
@@ -80,7 +80,7 @@ parse(plist::Dictionary const *dict, std::unordered_set<std::string> *seen, bool
     }
 
     if (P != nullptr) {
-        std::unordered_set<std::string> seen;
+        plist::Keys::Seen seen;
         auto unpack = plist::Keys::Unpack("Properties", P, &seen);
 
         auto I    = unpack.cast <plist::String> ("interpretation");
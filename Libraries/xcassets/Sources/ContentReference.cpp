@@ -15,7 +15,7 @@ using xcassets::ContentReference;
 bool ContentReference::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("ContentReference", dict, &seen);
 
     auto T  = unpack.coerce <plist::String> ("type");
@@ -15,7 +15,7 @@ using xcassets::Insets;
 bool Insets::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("Insets", dict, &seen);
 
     auto T = unpack.coerce <plist::Real> ("top");
@@ -16,7 +16,7 @@ using xcassets::Resizing;
 bool Resizing::Center::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("ResizingCenter", dict, &seen);
 
     auto M = unpack.cast <plist::String> ("mode");
@@ -51,7 +51,7 @@ parse(plist::Dictionary const *dict)
 bool Resizing::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("Resizing", dict, &seen);
 
     auto M  = unpack.cast <plist::String> ("mode");
@@ -11,6 +11,7 @@
 
 #include <pbxsetting/Environment.h>
 #include <pbxsetting/Level.h>
+#include <pbxbuild/Build/Environment.h>
 #include <xcexecution/Parameters.h>
 
 #include <string>
@@ -19,6 +20,8 @@
 
 namespace libutil { class Filesystem; }
 namespace process { class Context; }
+namespace process { class User; }
+namespace xcexecution { class Session; }
 
 namespace xcdriver {
 
@@ -46,6 +49,7 @@ public:
         Find,
         ExportArchive,
         Localizations,
+        Server,
     };
 
 public:
@@ -63,13 +67,21 @@ public:
     static bool
     VerifyBuildActions(std::vector<std::string> const &actions);
 
+public:
+    /*
+     * Creates the build environment, reusing what the session has loaded
+     * when there is a session.
+     */
+    static ext::optional<pbxbuild::Build::Environment>
+    CreateBuildEnvironment(process::User const *user, process::Context const *processContext, libutil::Filesystem *filesystem, xcexecution::Session *session);
+
 public:
     static std::vector<pbxsetting::Level>
     CreateOverrideLevels(process::Context const *processContext, libutil::Filesystem const *filesystem, pbxsetting::Environment const &environment, Options const &options, std::string const &workingDirectory);
 
 public:
     static xcexecution::Parameters
-    CreateParameters(Options const &options, std::vector<pbxsetting::Level> const &overrideLevels);
+    CreateParameters(Options const &options, std::vector<pbxsetting::Level> const &overrideLevels, xcexecution::Session *session = nullptr);
 };
 
 }
@@ -13,6 +13,7 @@ namespace libutil { class Filesystem; }
 namespace process { class Context; }
 namespace process { class Launcher; }
 namespace process { class User; }
+namespace xcexecution { class Session; }
 
 namespace xcdriver {
 
@@ -22,8 +23,12 @@ private:
     ~Driver();
 
 public:
+    /*
+     * Run the action for the process's arguments. The session, if any,
+     * keeps loaded state between runs in a long-running process.
+     */
     static int
-    Run(process::User const *user, process::Context const *processContext, process::Launcher *processLauncher, libutil::Filesystem *filesystem);
+    Run(process::User const *user, process::Context const *processContext, process::Launcher *processLauncher, libutil::Filesystem *filesystem, xcexecution::Session *session = nullptr);
 };
 
 }
@@ -12,6 +12,7 @@
 namespace libutil { class Filesystem; }
 namespace process { class Context; }
 namespace process { class User; }
+namespace xcexecution { class Session; }
 
 namespace xcdriver {
 
@@ -24,7 +25,7 @@ private:
 
 public:
     static int
-    Run(process::User const *user, process::Context const *processContext, libutil::Filesystem const *filesystem, Options const &options);
+    Run(process::User const *user, process::Context const *processContext, libutil::Filesystem *filesystem, Options const &options, xcexecution::Session *session = nullptr);
 };
 
 }
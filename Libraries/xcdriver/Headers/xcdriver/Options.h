@@ -48,6 +48,7 @@ private:
     ext::optional<std::string> _formatter;
     ext::optional<std::string> _executor;
     ext::optional<bool>        _generate;
+    ext::optional<bool>        _server;
 
 private:
     ext::optional<bool>        _parallelizeTargets;
@@ -157,6 +158,9 @@ public:
     /* Extension. */
     bool generate() const
     { return _generate.value_or(false); }
+    /* Extension. */
+    bool server() const
+    { return _server.value_or(false); }
 
 public:
     bool parallelizeTargets() const
@@ -0,0 +1,57 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef __xcdriver_Server_h
+#define __xcdriver_Server_h
+
+#include <string>
+
+namespace libutil { class Filesystem; }
+namespace process { class Context; }
+namespace process { class Launcher; }
+namespace process { class User; }
+
+namespace xcdriver {
+
+/*
+ * Runs requests from clients in a long-running process, so workspaces,
+ * specifications and SDKs stay loaded between requests. Clients pass their
+ * arguments, environment and working directory over a local socket along
+ * with their standard streams, so output goes directly to the client.
+ */
+class Server {
+private:
+    Server();
+    ~Server();
+
+public:
+    /*
+     * The path of the socket the server listens on. Can be overridden
+     * with the XCBUILD_SERVER_SOCKET environment variable.
+     */
+    static std::string
+    SocketPath(process::User const *user, process::Context const *processContext);
+
+public:
+    /*
+     * Serve requests one at a time until interrupted.
+     */
+    static int
+    Run(process::User const *user, process::Context const *processContext, process::Launcher *processLauncher, libutil::Filesystem *filesystem);
+
+    /*
+     * Send the process's arguments to a running server and wait for the
+     * result. Returns the exit code of the request.
+     */
+    static int
+    Request(process::User const *user, process::Context const *processContext);
+};
+
+}
+
+#endif // !__xcdriver_Server_h
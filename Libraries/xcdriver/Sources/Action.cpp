@@ -8,6 +8,7 @@
 
 #include <xcdriver/Action.h>
 #include <xcdriver/Options.h>
+#include <xcexecution/Session.h>
 #include <libutil/Filesystem.h>
 #include <libutil/FSUtil.h>
 #include <process/Context.h>
@@ -27,6 +28,16 @@ Action::
 {
 }
 
+ext::optional<pbxbuild::Build::Environment> Action::
+CreateBuildEnvironment(process::User const *user, process::Context const *processContext, Filesystem *filesystem, xcexecution::Session *session)
+{
+    if (session != nullptr) {
+        return session->buildEnvironment(user, processContext, filesystem);
+    } else {
+        return pbxbuild::Build::Environment::Default(user, processContext, filesystem);
+    }
+}
+
 std::vector<pbxsetting::Level> Action::
 CreateOverrideLevels(process::Context const *processContext, Filesystem const *filesystem, pbxsetting::Environment const &environment, Options const &options, std::string const &workingDirectory)
 {
@@ -67,7 +78,7 @@ CreateOverrideLevels(process::Context const *processContext, Filesystem const *f
 }
 
 xcexecution::Parameters Action::
-CreateParameters(Options const &options, std::vector<pbxsetting::Level> const &overrideLevels)
+CreateParameters(Options const &options, std::vector<pbxsetting::Level> const &overrideLevels, xcexecution::Session *session)
 {
     return xcexecution::Parameters(
         options.workspace(),
@@ -77,7 +88,8 @@ CreateParameters(Options const &options, std::vector<pbxsetting::Level> const &o
         options.allTargets(),
         options.actions(),
         options.configuration(),
-        overrideLevels);
+        overrideLevels,
+        session);
 }
 
 bool Action::
@@ -112,6 +124,8 @@ Determine(Options const &options)
         return Help;
     } else if (options.license()) {
         return License;
+    } else if (options.server()) {
+        return Server;
     } else if (options.checkFirstLaunchStatus()) {
         return CheckFirstLaunch;
     } else if (options.showSDKs()) {
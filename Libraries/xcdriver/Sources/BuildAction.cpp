@@ -122,7 +122,7 @@ VerifySupportedOptions(Options const &options)
 }
 
 int BuildAction::
-Run(process::User const *user, process::Context const *processContext, process::Launcher *processLauncher, Filesystem *filesystem, Options const &options)
+Run(process::User const *user, process::Context const *processContext, process::Launcher *processLauncher, Filesystem *filesystem, Options const &options, xcexecution::Session *session)
 {
     // TODO(grp): Implement these options.
     if (!VerifySupportedOptions(options)) {
@@ -153,9 +153,10 @@ Run(process::User const *user, process::Context const *processContext, process::
     }
 
     /*
-     * Use the default build environment. We don't need anything custom here.
+     * Use the default build environment. We don't need anything custom here,
+     * but reuse what the session has already loaded.
      */
-    ext::optional<pbxbuild::Build::Environment> buildEnvironment = pbxbuild::Build::Environment::Default(user, processContext, filesystem);
+    ext::optional<pbxbuild::Build::Environment> buildEnvironment = Action::CreateBuildEnvironment(user, processContext, filesystem, session);
     if (!buildEnvironment) {
         fprintf(stderr, "error: couldn't create build environment\n");
         return -1;
@@ -173,7 +174,7 @@ Run(process::User const *user, process::Context const *processContext, process::
      * Create the build parameters. The executor uses this to load a workspace and create a
      * build context, but is not required to when the parameters haven't changed from a cache.
      */
-    xcexecution::Parameters parameters = Action::CreateParameters(options, overrideLevels);
+    xcexecution::Parameters parameters = Action::CreateParameters(options, overrideLevels, session);
 
     /*
      * Perform the build!
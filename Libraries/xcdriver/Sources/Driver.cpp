@@ -14,6 +14,7 @@
 #include <xcdriver/HelpAction.h>
 #include <xcdriver/LicenseAction.h>
 #include <xcdriver/ListAction.h>
+#include <xcdriver/Server.h>
 #include <xcdriver/ShowSDKsAction.h>
 #include <xcdriver/ShowBuildSettingsAction.h>
 #include <xcdriver/UsageAction.h>
@@ -40,7 +41,7 @@ Driver::
 }
 
 int Driver::
-Run(process::User const *user, process::Context const *processContext, process::Launcher *processLauncher, Filesystem *filesystem)
+Run(process::User const *user, process::Context const *processContext, process::Launcher *processLauncher, Filesystem *filesystem, xcexecution::Session *session)
 {
     Options options;
     std::pair<bool, std::string> result = libutil::Options::Parse<Options>(&options, processContext->commandLineArguments());
@@ -53,11 +54,11 @@ Run(process::User const *user, process::Context const *processContext, process::
     Action::Type action = Action::Determine(options);
     switch (action) {
         case Action::Build:
-            return BuildAction::Run(user, processContext, processLauncher, filesystem, options);
+            return BuildAction::Run(user, processContext, processLauncher, filesystem, options, session);
         case Action::ShowBuildSettings:
-            return ShowBuildSettingsAction::Run(user, processContext, filesystem, options);
+            return ShowBuildSettingsAction::Run(user, processContext, filesystem, options, session);
         case Action::List:
-            return ListAction::Run(user, processContext, filesystem, options);
+            return ListAction::Run(user, processContext, filesystem, options, session);
         case Action::Version:
             return VersionAction::Run(user, processContext, filesystem, options);
         case Action::Usage:
@@ -79,6 +80,12 @@ Run(process::User const *user, process::Context const *processContext, process::
         case Action::Localizations:
             fprintf(stderr, "warning: localizations not implemented\n");
             break;
+        case Action::Server:
+            if (session != nullptr) {
+                fprintf(stderr, "error: already running as a server\n");
+                return 1;
+            }
+            return Server::Run(user, processContext, processLauncher, filesystem);
     }
 
     return 0;
@@ -29,16 +29,16 @@ ListAction::
 }
 
 int ListAction::
-Run(process::User const *user, process::Context const *processContext, Filesystem const *filesystem, Options const &options)
+Run(process::User const *user, process::Context const *processContext, Filesystem *filesystem, Options const &options, xcexecution::Session *session)
 {
-    ext::optional<pbxbuild::Build::Environment> buildEnvironment = pbxbuild::Build::Environment::Default(user, processContext, filesystem);
+    ext::optional<pbxbuild::Build::Environment> buildEnvironment = Action::CreateBuildEnvironment(user, processContext, filesystem, session);
     if (!buildEnvironment) {
         fprintf(stderr, "error: couldn't create build environment\n");
         return -1;
     }
 
     std::vector<pbxsetting::Level> overrideLevels = Action::CreateOverrideLevels(processContext, filesystem, buildEnvironment->baseEnvironment(), options, processContext->currentDirectory());
-    xcexecution::Parameters parameters = Action::CreateParameters(options, overrideLevels);
+    xcexecution::Parameters parameters = Action::CreateParameters(options, overrideLevels, session);
 
     ext::optional<pbxbuild::WorkspaceContext> context = parameters.loadWorkspace(filesystem, user->userName(), *buildEnvironment, processContext->currentDirectory());
     if (!context) {
@@ -77,11 +77,16 @@ Run(process::User const *user, process::Context const *processContext, Filesyste
     } else if (context->project() != nullptr) {
         pbxproj::PBX::Project::shared_ptr const &project = context->project();
 
+        pbxproj::PBX::Target::vector const *targets = project->targets();
+        if (targets == nullptr) {
+            return -1;
+        }
+
         printf("Information about project \"%s\":\n", project->name().c_str());
 
-        if (!project->targets().empty()) {
+        if (!targets->empty()) {
             printf("%4sTargets:\n", "");
-            for (auto const &target : project->targets()) {
+            for (auto const &target : *targets) {
                 printf("%8s%s\n", "", target->name().c_str());
             }
         } else {
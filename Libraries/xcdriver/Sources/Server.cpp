@@ -0,0 +1,463 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <xcdriver/Server.h>
+#include <xcdriver/Driver.h>
+#include <xcexecution/Session.h>
+#include <libutil/Filesystem.h>
+#include <plist/Format/Binary.h>
+#include <plist/Objects.h>
+#include <process/Context.h>
+#include <process/MemoryContext.h>
+#include <process/User.h>
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using xcdriver::Server;
+using libutil::Filesystem;
+
+Server::
+Server()
+{
+}
+
+Server::
+~Server()
+{
+}
+
+std::string Server::
+SocketPath(process::User const *user, process::Context const *processContext)
+{
+    if (ext::optional<std::string> path = processContext->environmentVariable("XCBUILD_SERVER_SOCKET")) {
+        return *path;
+    }
+
+    std::string directory = processContext->environmentVariable("TMPDIR").value_or("/tmp");
+    if (!directory.empty() && directory.back() == '/') {
+        directory.pop_back();
+    }
+
+    return directory + "/xcbuild-" + user->userName() + ".socket";
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+
+/*
+ * Requests are a length-prefixed binary property list. The standard
+ * streams of the client are passed along with the length.
+ */
+static size_t const MaximumRequestSize = 64 * 1024 * 1024;
+static size_t const StreamCount = 3;
+
+static bool
+WriteAll(int fd, void const *data, size_t size)
+{
+    uint8_t const *bytes = static_cast<uint8_t const *>(data);
+    while (size > 0) {
+        ssize_t written = ::write(fd, bytes, size);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        } else if (written <= 0) {
+            return false;
+        }
+
+        bytes += written;
+        size -= written;
+    }
+
+    return true;
+}
+
+static bool
+ReadAll(int fd, void *data, size_t size)
+{
+    uint8_t *bytes = static_cast<uint8_t *>(data);
+    while (size > 0) {
+        ssize_t count = ::read(fd, bytes, size);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        } else if (count <= 0) {
+            return false;
+        }
+
+        bytes += count;
+        size -= count;
+    }
+
+    return true;
+}
+
+static bool
+SendRequest(int socket, std::vector<uint8_t> const &data)
+{
+    uint64_t size = data.size();
+    struct iovec iov = { &size, sizeof(size) };
+
+    int streams[StreamCount] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+    char control[CMSG_SPACE(sizeof(streams))];
+    ::memset(control, 0, sizeof(control));
+
+    struct msghdr message;
+    ::memset(&message, 0, sizeof(message));
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    struct cmsghdr *header = CMSG_FIRSTHDR(&message);
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type = SCM_RIGHTS;
+    header->cmsg_len = CMSG_LEN(sizeof(streams));
+    ::memcpy(CMSG_DATA(header), streams, sizeof(streams));
+
+    ssize_t sent;
+    do {
+        sent = ::sendmsg(socket, &message, 0);
+    } while (sent < 0 && errno == EINTR);
+    if (sent != sizeof(size)) {
+        return false;
+    }
+
+    return WriteAll(socket, data.data(), data.size());
+}
+
+static bool
+ReceiveRequest(int socket, std::vector<uint8_t> *data, std::vector<int> *streams)
+{
+    uint64_t size = 0;
+    struct iovec iov = { &size, sizeof(size) };
+
+    char control[CMSG_SPACE(sizeof(int) * StreamCount)];
+    ::memset(control, 0, sizeof(control));
+
+    struct msghdr message;
+    ::memset(&message, 0, sizeof(message));
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+
+    ssize_t received;
+    do {
+        received = ::recvmsg(socket, &message, MSG_WAITALL);
+    } while (received < 0 && errno == EINTR);
+
+    for (struct cmsghdr *header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header)) {
+        if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS) {
+            size_t count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+            int const *fds = reinterpret_cast<int const *>(CMSG_DATA(header));
+            streams->insert(streams->end(), fds, fds + count);
+        }
+    }
+
+    if (received != sizeof(size) || size > MaximumRequestSize) {
+        return false;
+    }
+
+    data->resize(size);
+    return ReadAll(socket, data->data(), data->size());
+}
+
+static bool
+VerifyPeer(int socket)
+{
+    /* Only serve requests from the user running the server. */
+#if defined(__linux__)
+    struct ucred credentials;
+    socklen_t length = sizeof(credentials);
+    if (::getsockopt(socket, SOL_SOCKET, SO_PEERCRED, &credentials, &length) != 0) {
+        return false;
+    }
+    return credentials.uid == ::getuid();
+#else
+    uid_t uid;
+    gid_t gid;
+    if (::getpeereid(socket, &uid, &gid) != 0) {
+        return false;
+    }
+    return uid == ::getuid();
+#endif
+}
+
+static bool
+SocketAddress(std::string const &path, struct sockaddr_un *address)
+{
+    ::memset(address, 0, sizeof(*address));
+    address->sun_family = AF_UNIX;
+
+    if (path.size() >= sizeof(address->sun_path)) {
+        fprintf(stderr, "error: server socket path '%s' is too long\n", path.c_str());
+        return false;
+    }
+
+    ::memcpy(address->sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+static volatile sig_atomic_t Interrupted = 0;
+
+static void
+Interrupt(int number)
+{
+    Interrupted = 1;
+}
+
+static int
+HandleRequest(int socket, process::User const *user, process::Context const *processContext, process::Launcher *processLauncher, Filesystem *filesystem, xcexecution::Session *session)
+{
+    std::vector<uint8_t> data;
+    std::vector<int> streams;
+    bool received = ReceiveRequest(socket, &data, &streams);
+
+    auto closeStreams = [&]() {
+        for (int fd : streams) {
+            ::close(fd);
+        }
+    };
+
+    if (!received || streams.size() != StreamCount) {
+        /* Connections without any streams are checking if a server is running. */
+        if (!streams.empty()) {
+            fprintf(stderr, "warning: ignoring malformed request\n");
+        }
+        closeStreams();
+        return -1;
+    }
+
+    std::unique_ptr<plist::Object> root = plist::Format::Binary::Deserialize(data, plist::Format::Binary::Create()).first;
+    plist::Dictionary const *request = plist::CastTo<plist::Dictionary>(root.get());
+    plist::Array const *arguments = (request != nullptr ? request->value<plist::Array>("arguments") : nullptr);
+    plist::String const *directory = (request != nullptr ? request->value<plist::String>("directory") : nullptr);
+    plist::Dictionary const *environment = (request != nullptr ? request->value<plist::Dictionary>("environment") : nullptr);
+    if (arguments == nullptr || directory == nullptr || environment == nullptr) {
+        fprintf(stderr, "warning: ignoring malformed request\n");
+        closeStreams();
+        return -1;
+    }
+
+    /*
+     * Run the request as if it was this process, but with the arguments,
+     * directory and environment of the client.
+     */
+    process::MemoryContext requestContext = process::MemoryContext(processContext);
+    requestContext.currentDirectory() = directory->value();
+    requestContext.commandLineArguments().clear();
+    for (size_t n = 0; n < arguments->count(); n++) {
+        if (auto argument = arguments->value<plist::String>(n)) {
+            requestContext.commandLineArguments().push_back(argument->value());
+        }
+    }
+    requestContext.environmentVariables().clear();
+    for (size_t n = 0; n < environment->count(); n++) {
+        if (auto value = environment->value<plist::String>(environment->key(n))) {
+            requestContext.environmentVariables().insert({ environment->key(n), value->value() });
+        }
+    }
+
+    /*
+     * Output goes to the client's streams, including from launched tools.
+     */
+    fflush(stdout);
+    fflush(stderr);
+
+    int saved[StreamCount];
+    for (size_t n = 0; n < StreamCount; n++) {
+        saved[n] = ::dup(static_cast<int>(n));
+        ::dup2(streams[n], static_cast<int>(n));
+    }
+
+    if (::chdir(requestContext.currentDirectory().c_str()) != 0) {
+        fprintf(stderr, "warning: unable to change to directory '%s'\n", requestContext.currentDirectory().c_str());
+    }
+
+    session->refresh(filesystem);
+    int status = xcdriver::Driver::Run(user, &requestContext, processLauncher, filesystem, session);
+
+    fflush(stdout);
+    fflush(stderr);
+
+    if (::chdir(processContext->currentDirectory().c_str()) != 0) {
+        /* Requests use their own directory, so this isn't fatal. */
+    }
+
+    for (size_t n = 0; n < StreamCount; n++) {
+        ::dup2(saved[n], static_cast<int>(n));
+        ::close(saved[n]);
+    }
+    closeStreams();
+
+    int32_t result = status;
+    WriteAll(socket, &result, sizeof(result));
+    return status;
+}
+
+int Server::
+Run(process::User const *user, process::Context const *processContext, process::Launcher *processLauncher, Filesystem *filesystem)
+{
+    std::string path = SocketPath(user, processContext);
+
+    struct sockaddr_un address;
+    if (!SocketAddress(path, &address)) {
+        return 1;
+    }
+
+    int server = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0) {
+        fprintf(stderr, "error: unable to create server socket: %s\n", strerror(errno));
+        return 1;
+    }
+
+    /* Replace a stale socket, but not one a server is still listening on. */
+    if (::connect(server, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) == 0) {
+        fprintf(stderr, "error: a server is already running at '%s'\n", path.c_str());
+        ::close(server);
+        return 1;
+    }
+    ::close(server);
+    ::unlink(path.c_str());
+
+    server = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0) {
+        fprintf(stderr, "error: unable to create server socket: %s\n", strerror(errno));
+        return 1;
+    }
+
+    /* Only the current user can connect. */
+    mode_t mask = ::umask(0077);
+    int bound = ::bind(server, reinterpret_cast<struct sockaddr *>(&address), sizeof(address));
+    ::umask(mask);
+
+    if (bound != 0 || ::listen(server, 16) != 0) {
+        fprintf(stderr, "error: unable to listen at '%s': %s\n", path.c_str(), strerror(errno));
+        ::close(server);
+        return 1;
+    }
+
+    /*
+     * Stop accepting requests when interrupted. Don't restart the accept,
+     * so the interruption is noticed.
+     */
+    struct sigaction action;
+    ::memset(&action, 0, sizeof(action));
+    action.sa_handler = &Interrupt;
+    sigemptyset(&action.sa_mask);
+    ::sigaction(SIGINT, &action, nullptr);
+    ::sigaction(SIGTERM, &action, nullptr);
+    ::signal(SIGPIPE, SIG_IGN);
+
+    fprintf(stderr, "xcbuild server listening at '%s'\n", path.c_str());
+
+    xcexecution::Session session;
+    while (!Interrupted) {
+        int client = ::accept(server, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+
+            fprintf(stderr, "error: unable to accept request: %s\n", strerror(errno));
+            break;
+        }
+
+        if (!VerifyPeer(client)) {
+            fprintf(stderr, "warning: rejecting request from another user\n");
+        } else {
+            HandleRequest(client, user, processContext, processLauncher, filesystem, &session);
+        }
+
+        ::close(client);
+    }
+
+    ::close(server);
+    ::unlink(path.c_str());
+    return 0;
+}
+
+int Server::
+Request(process::User const *user, process::Context const *processContext)
+{
+    std::string path = SocketPath(user, processContext);
+
+    struct sockaddr_un address;
+    if (!SocketAddress(path, &address)) {
+        return 1;
+    }
+
+    int client = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (client < 0) {
+        fprintf(stderr, "error: unable to create socket: %s\n", strerror(errno));
+        return 1;
+    }
+
+    if (::connect(client, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) != 0) {
+        fprintf(stderr, "error: unable to connect to server at '%s'; start one with 'xcbuild -server'\n", path.c_str());
+        ::close(client);
+        return 1;
+    }
+
+    auto arguments = plist::Array::New();
+    for (std::string const &argument : processContext->commandLineArguments()) {
+        arguments->append(plist::String::New(argument));
+    }
+
+    auto environment = plist::Dictionary::New();
+    for (auto const &variable : processContext->environmentVariables()) {
+        environment->set(variable.first, plist::String::New(variable.second));
+    }
+
+    auto request = plist::Dictionary::New();
+    request->set("arguments", std::move(arguments));
+    request->set("directory", plist::String::New(processContext->currentDirectory()));
+    request->set("environment", std::move(environment));
+
+    auto serialize = plist::Format::Binary::Serialize(request.get(), plist::Format::Binary::Create());
+    if (serialize.first == nullptr) {
+        fprintf(stderr, "error: unable to create request: %s\n", serialize.second.c_str());
+        ::close(client);
+        return 1;
+    }
+
+    int32_t result = 0;
+    if (!SendRequest(client, *serialize.first) || !ReadAll(client, &result, sizeof(result))) {
+        fprintf(stderr, "error: lost connection to server\n");
+        ::close(client);
+        return 1;
+    }
+
+    ::close(client);
+    return result;
+}
+
+#else
+
+int Server::
+Run(process::User const *user, process::Context const *processContext, process::Launcher *processLauncher, Filesystem *filesystem)
+{
+    fprintf(stderr, "error: server mode is not supported on this platform\n");
+    return 1;
+}
+
+int Server::
+Request(process::User const *user, process::Context const *processContext)
+{
+    fprintf(stderr, "error: server mode is not supported on this platform\n");
+    return 1;
+}
+
+#endif
@@ -28,20 +28,20 @@ ShowBuildSettingsAction::
 }
 
 int ShowBuildSettingsAction::
-Run(process::User const *user, process::Context const *processContext, Filesystem const *filesystem, Options const &options)
+Run(process::User const *user, process::Context const *processContext, Filesystem *filesystem, Options const &options, xcexecution::Session *session)
 {
     if (!Action::VerifyBuildActions(options.actions())) {
         return -1;
     }
 
-    ext::optional<pbxbuild::Build::Environment> buildEnvironment = pbxbuild::Build::Environment::Default(user, processContext, filesystem);
+    ext::optional<pbxbuild::Build::Environment> buildEnvironment = Action::CreateBuildEnvironment(user, processContext, filesystem, session);
     if (!buildEnvironment) {
         fprintf(stderr, "error: couldn't create build environment\n");
         return -1;
     }
 
     std::vector<pbxsetting::Level> overrideLevels = Action::CreateOverrideLevels(processContext, filesystem, buildEnvironment->baseEnvironment(), options, processContext->currentDirectory());
-    xcexecution::Parameters parameters = Action::CreateParameters(options, overrideLevels);
+    xcexecution::Parameters parameters = Action::CreateParameters(options, overrideLevels, session);
 
     ext::optional<pbxbuild::WorkspaceContext> workspaceContext = parameters.loadWorkspace(filesystem, user->userName(), *buildEnvironment, processContext->currentDirectory());
     if (!workspaceContext) {
@@ -62,6 +62,8 @@ Text(std::string const &name) {
 
     result << "       " << name << " -showsdks" << std::endl;
 
+    result << "       " << name << " -server" << std::endl;
+
     result << "       " << name << " -exportArchive "
         "-archivePath <xcarchivepath> "
         "-exportPath <destinationpath> "
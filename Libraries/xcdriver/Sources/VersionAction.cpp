@@ -49,7 +49,7 @@ Run(process::User const *user, process::Context const *processContext, Filesyste
         }
 
         auto configuration = xcsdk::Configuration::Load(filesystem, xcsdk::Configuration::DefaultPaths(user, processContext));
-        auto manager = xcsdk::SDK::Manager::Open(filesystem, *developerRoot, configuration);
+        auto manager = xcsdk::SDK::Manager::Open(filesystem, *developerRoot, configuration, nullptr, true);
         if (manager == nullptr) {
             fprintf(stderr, "error: unable to open developer directory\n");
             return 1;
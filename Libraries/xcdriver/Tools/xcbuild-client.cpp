@@ -0,0 +1,23 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <xcdriver/Server.h>
+#include <process/DefaultContext.h>
+#include <process/DefaultUser.h>
+
+/*
+ * Takes the same options as xcbuild, but runs them in a server started
+ * with `xcbuild -server` instead of loading everything from scratch.
+ */
+int
+main(int argc, char **argv)
+{
+    process::DefaultContext processContext = process::DefaultContext();
+    process::DefaultUser user = process::DefaultUser();
+    return xcdriver::Server::Request(&user, &processContext);
+}
@@ -10,6 +10,7 @@
 #define __xcexecution_Executor_h
 
 #include <xcformatter/Formatter.h>
+#include <libutil/ExecutableCache.h>
 
 #include <memory>
 
@@ -39,6 +40,12 @@ protected:
     bool                                    _dryRun;
     bool                                    _generate;
 
+protected:
+    /*
+     * Where tools were found during the current build.
+     */
+    libutil::ExecutableCache                _executables;
+
 protected:
     Executor(std::shared_ptr<xcformatter::Formatter> const &formatter, bool dryRun, bool generate);
 
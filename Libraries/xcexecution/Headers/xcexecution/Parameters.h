@@ -22,6 +22,8 @@ namespace libutil { class Filesystem; }
 
 namespace xcexecution {
 
+class Session;
+
 /*
  * All of the inputs for a build. Can load the workspace on-demand and create
  * a build context for a build action. This data is kept at this level to avoid
@@ -38,6 +40,9 @@ private:
     ext::optional<std::string>     _configuration;
     std::vector<pbxsetting::Level> _overrideLevels;
 
+private:
+    Session                       *_session;
+
 public:
     Parameters(
         ext::optional<std::string> const &workspace,
@@ -47,7 +52,8 @@ public:
         bool allTargets,
         std::vector<std::string> const &actions,
         ext::optional<std::string> const &configuration,
-        std::vector<pbxsetting::Level> const &overrideLevels);
+        std::vector<pbxsetting::Level> const &overrideLevels,
+        Session *session = nullptr);
 
 public:
     /*
@@ -98,6 +104,13 @@ public:
     std::vector<pbxsetting::Level> const &overrideLevels() const
     { return _overrideLevels; }
 
+    /*
+     * Loaded state to reuse between builds, if any. Not part of the
+     * canonical arguments.
+     */
+    Session *session() const
+    { return _session; }
+
 public:
     /*
      * The canonical set of arguments to reproduce these parameters.
@@ -111,7 +124,8 @@ public:
 
 public:
     /*
-     * Loads the workspace from the build parameters.
+     * Loads the workspace from the build parameters. With a session, the
+     * loaded workspace is reused while it is up to date.
      */
     ext::optional<pbxbuild::WorkspaceContext> loadWorkspace(
         libutil::Filesystem const *filesystem,
@@ -120,7 +134,8 @@ public:
         std::string const &workingDirectory) const;
 
     /*
-     * Creates the build context for a specific action.
+     * Creates the build context for a specific action. With a session,
+     * the build context and its target environments are reused.
      */
     ext::optional<pbxbuild::Build::Context> createBuildContext(
         pbxbuild::WorkspaceContext const &workspaceContext) const;
@@ -0,0 +1,130 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef __xcexecution_Session_h
+#define __xcexecution_Session_h
+
+#include <pbxbuild/Build/Context.h>
+#include <pbxbuild/Build/Environment.h>
+#include <pbxbuild/WorkspaceContext.h>
+#include <libutil/Filesystem.h>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <ext/optional>
+
+namespace process { class Context; }
+namespace process { class User; }
+
+namespace xcexecution {
+
+/*
+ * State kept loaded between builds by a long-running process. Holds the
+ * build environment, loaded workspaces and build contexts (along with the
+ * target environments they compute). State is dropped when the files it
+ * was loaded from change. On Linux, those files are watched with inotify,
+ * so they are only checked after something has changed.
+ */
+class Session {
+private:
+    struct Dependency {
+        std::string                                   path;
+        ext::optional<libutil::Filesystem::Metadata>  metadata;
+    };
+
+    struct Workspace {
+        pbxbuild::WorkspaceContext                    context;
+        std::vector<Dependency>                       dependencies;
+    };
+
+private:
+    int                                               _notify;
+    bool                                              _unwatched;
+    std::unordered_set<std::string>                   _watched;
+
+private:
+    std::string                                       _environmentKey;
+    ext::optional<pbxbuild::Build::Environment>       _buildEnvironment;
+    std::vector<Dependency>                           _buildEnvironmentDependencies;
+
+private:
+    std::unordered_map<std::string, Workspace>        _workspaces;
+    std::unordered_map<std::string, pbxbuild::Build::Context> _buildContexts;
+
+public:
+    Session();
+    ~Session();
+
+    Session(Session const &) = delete;
+    Session &operator=(Session const &) = delete;
+
+public:
+    /*
+     * Drop any loaded state that is out of date. Call before each build.
+     */
+    void refresh(libutil::Filesystem const *filesystem);
+
+public:
+    /*
+     * The build environment for a process. Specifications and SDKs are
+     * kept loaded; the rest of the environment is only recomputed when
+     * the process's user or environment variables change.
+     */
+    ext::optional<pbxbuild::Build::Environment>
+    buildEnvironment(
+        process::User const *user,
+        process::Context const *processContext,
+        libutil::Filesystem *filesystem);
+
+public:
+    /*
+     * A loaded workspace, if it is still up to date.
+     */
+    ext::optional<pbxbuild::WorkspaceContext>
+    workspaceContext(std::string const &key) const;
+
+    /*
+     * Keep a loaded workspace until the files it was loaded from change.
+     */
+    void insertWorkspaceContext(
+        std::string const &key,
+        std::string const &userName,
+        libutil::Filesystem const *filesystem,
+        pbxbuild::WorkspaceContext const &workspaceContext);
+
+public:
+    /*
+     * A build context, if its workspace and environment are still up to
+     * date. Build contexts share computed target environments.
+     */
+    ext::optional<pbxbuild::Build::Context>
+    buildContext(std::string const &key) const;
+
+    /*
+     * Keep a build context until its workspace or environment changes.
+     */
+    void insertBuildContext(
+        std::string const &key,
+        pbxbuild::Build::Context const &buildContext);
+
+private:
+    void watch(libutil::Filesystem const *filesystem, std::vector<Dependency> const &dependencies);
+    bool changed();
+
+private:
+    static std::vector<Dependency>
+    Record(libutil::Filesystem const *filesystem, std::vector<std::string> const &paths);
+    static bool
+    Changed(libutil::Filesystem const *filesystem, std::vector<Dependency> const &dependencies);
+};
+
+}
+
+#endif // !__xcexecution_Session_h
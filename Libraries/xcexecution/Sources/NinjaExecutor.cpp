@@ -21,10 +21,7 @@
 #include <process/MemoryContext.h>
 #include <process/Launcher.h>
 #include <process/User.h>
-#include <libutil/md5.h>
-
-#include <sstream>
-#include <iomanip>
+#include <libutil/Hash.h>
 
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -111,25 +108,14 @@ NinjaDescription(std::string const &description)
 static std::string
 NinjaHash(char const *data, size_t size)
 {
-    md5_state_t state;
-    md5_init(&state);
-    md5_append(&state, reinterpret_cast<const md5_byte_t *>(data), size);
-    uint8_t digest[16];
-    md5_finish(&state, reinterpret_cast<md5_byte_t *>(&digest));
-
-    std::ostringstream ss;
-    ss << std::hex << std::setfill('0');
-    for (uint8_t c : digest) {
-        ss << std::setw(2) << static_cast<int>(c);
-    }
-
-    return ss.str();
+    return libutil::Hash::Data(data, size).hex();
 }
 
 static ext::optional<std::string>
 NinjaBuiltinExecutablePath(
     process::Context const *processContext,
     Filesystem const *filesystem,
+    libutil::ExecutableCache *executables,
     std::string builtinExecutable)
 {
     std::vector<std::string> builtinExecutablePaths;
@@ -146,23 +132,24 @@ NinjaBuiltinExecutablePath(
             break;
         }
     }
-    return filesystem->findExecutable(builtinExecutable, builtinExecutablePaths);
+    return executables->find(filesystem, builtinExecutable, builtinExecutablePaths);
 }
 
 static ext::optional<std::string>
 NinjaExecutablePath(
     process::Context const *processContext,
     Filesystem const *filesystem,
+    libutil::ExecutableCache *executables,
     std::vector<std::string> const &executablePaths,
     pbxbuild::Tool::Invocation::Executable const &executable)
 {
     if (ext::optional<std::string> const &builtin = executable.builtin()) {
-        return NinjaBuiltinExecutablePath(processContext, filesystem, *builtin);
+        return NinjaBuiltinExecutablePath(processContext, filesystem, executables, *builtin);
     } else if (ext::optional<std::string> const &external = executable.external()) {
         if (FSUtil::IsAbsolutePath(*external)) {
             return *external;
         } else {
-            return filesystem->findExecutable(*external, executablePaths);
+            return executables->find(filesystem, *external, executablePaths);
         }
     } else {
         abort();
@@ -280,15 +267,16 @@ WriteNinjaRegenerate(
 }
 
 static bool
-WriteNinja(Filesystem *filesystem, ninja::Writer const &writer, std::string const &path)
+WriteNinja(Filesystem *filesystem, ninja::Writer const &writer, std::string const &path, bool skipIfIdentical)
 {
     if (!filesystem->createDirectory(FSUtil::GetDirectoryName(path), true)) {
         return false;
     }
 
     std::string contents = writer.serialize();
-    std::vector<uint8_t> copy = std::vector<uint8_t>(contents.begin(), contents.end());
-    if (!filesystem->write(copy, path)) {
+    if (!filesystem->writeAtomically(path, skipIfIdentical, false, [&contents](Filesystem::Append const &append) -> bool {
+        return append(reinterpret_cast<uint8_t const *>(contents.data()), contents.size());
+    })) {
         return false;
     }
 
@@ -303,7 +291,10 @@ WriteAuxiliaryFiles(Filesystem *filesystem, std::map<std::string, pbxbuild::Tool
             return false;
         }
 
-        if (!filesystem->write(*it.second->data(), it.first)) {
+        std::vector<uint8_t> const &contents = *it.second->data();
+        if (!filesystem->writeAtomically(it.first, true, false, [&contents](Filesystem::Append const &append) -> bool {
+            return append(contents.data(), contents.size());
+        })) {
             return false;
         }
     }
@@ -365,6 +356,9 @@ build(
     pbxbuild::Build::Environment const &buildEnvironment,
     Parameters const &buildParameters)
 {
+    /* Tools could have changed since the last build. */
+    _executables.invalidate();
+
     /*
      * Load the derived data hash in order to output the Ninja file in the
      * right derived data directory. This does not load the workspace context
@@ -392,7 +386,7 @@ build(
      * Find the dependency info tool.
      */
     std::string executableRoot = FSUtil::GetDirectoryName(processContext->executablePath());
-    std::string dependencyInfoToolPath = *NinjaBuiltinExecutablePath(processContext, filesystem, "dependency-info-tool");
+    std::string dependencyInfoToolPath = *NinjaBuiltinExecutablePath(processContext, filesystem, &_executables, "dependency-info-tool");
 
     /*
      * If the Ninja file needs to be generated, generate it.
@@ -689,9 +683,10 @@ buildAction(
         inputPaths);
 
     /*
-     * Serialize the Ninja file into the build root.
+     * Serialize the Ninja file into the build root. Always update it, as Ninja
+     * expects it to be newer than its inputs once regenerated.
      */
-    if (!WriteNinja(filesystem, writer, ninjaPath)) {
+    if (!WriteNinja(filesystem, writer, ninjaPath, false)) {
         fprintf(stderr, "error: failed to write Ninja to %s\n", ninjaPath.c_str());
         return false;
     }
@@ -781,7 +776,7 @@ buildTargetInvocations(
         // TODO(grp): This should perhaps be a separate flag for a 'phony' invocation.
         if (invocation.executable()) {
             /* Find invocation executable. */
-            ext::optional<std::string> executablePath = NinjaExecutablePath(processContext, filesystem, targetEnvironment.executablePaths(), *invocation.executable());
+            ext::optional<std::string> executablePath = NinjaExecutablePath(processContext, filesystem, &_executables, targetEnvironment.executablePaths(), *invocation.executable());
             if (!executablePath) {
                 fprintf(stderr, "unable to find executable: %s\n", invocation.executable()->builtin().value_or(invocation.executable()->external().value_or("<NONE>")).c_str());
 
@@ -799,7 +794,7 @@ buildTargetInvocations(
      * Serialize the Ninja file into the build root.
      */
     std::string path = TargetNinjaPath(target, targetEnvironment);
-    if (!WriteNinja(filesystem, writer, path)) {
+    if (!WriteNinja(filesystem, writer, path, true)) {
         fprintf(stderr, "error: unable to write target ninja: %s\n", path.c_str());
         return false;
     }
@@ -7,14 +7,12 @@
  */
 
 #include <xcexecution/Parameters.h>
+#include <xcexecution/Session.h>
 
 #include <pbxbuild/Build/DependencyResolver.h>
 #include <libutil/Filesystem.h>
 #include <libutil/FSUtil.h>
-#include <libutil/md5.h>
-
-#include <sstream>
-#include <iomanip>
+#include <libutil/Hash.h>
 
 using xcexecution::Parameters;
 using libutil::Filesystem;
@@ -29,7 +27,8 @@ Parameters(
     bool allTargets,
     std::vector<std::string> const &actions,
     ext::optional<std::string> const &configuration,
-    std::vector<pbxsetting::Level> const &overrideLevels) :
+    std::vector<pbxsetting::Level> const &overrideLevels,
+    Session *session) :
     _workspace     (workspace),
     _project       (project),
     _scheme        (scheme),
@@ -37,7 +36,8 @@ Parameters(
     _allTargets    (allTargets),
     _actions       (actions),
     _configuration (configuration),
-    _overrideLevels(overrideLevels)
+    _overrideLevels(overrideLevels),
+    _session       (session)
 {
 }
 
@@ -93,24 +93,12 @@ canonicalArguments() const
 std::string Parameters::
 canonicalHash() const
 {
-    md5_state_t state;
-    md5_init(&state);
-
-    std::vector<std::string> arguments = canonicalArguments();
-    for (std::string const &argument : arguments) {
-        /* Inlucde trailing NUL terminator to separate arguments. */
-        md5_append(&state, reinterpret_cast<const md5_byte_t *>(argument.data()), argument.size() + 1);
-    }
-
-    uint8_t digest[16];
-    md5_finish(&state, reinterpret_cast<md5_byte_t *>(&digest));
-
-    std::ostringstream ss;
-    ss << std::hex << std::setfill('0');
-    for (uint8_t c : digest) {
-        ss << std::setw(2) << static_cast<int>(c);
+    libutil::Hash hash;
+    for (std::string const &argument : canonicalArguments()) {
+        /* Includes the trailing NUL terminator to separate arguments. */
+        hash.update(argument);
     }
-    return ss.str();
+    return hash.digest().hex();
 }
 
 static pbxproj::PBX::Project::shared_ptr
@@ -153,6 +141,19 @@ OpenProject(Filesystem const *filesystem, ext::optional<std::string> const &proj
 ext::optional<pbxbuild::WorkspaceContext> Parameters::
 loadWorkspace(Filesystem const *filesystem, std::string const &userName, pbxbuild::Build::Environment const &buildEnvironment, std::string const &workingDirectory) const
 {
+    /*
+     * The same options can refer to different workspaces depending on the
+     * user and working directory, so those are part of the session key.
+     */
+    std::string sessionKey;
+    if (_session != nullptr) {
+        sessionKey = userName + '\0' + workingDirectory + '\0' + _workspace.value_or("") + '\0' + _project.value_or("");
+        if (ext::optional<pbxbuild::WorkspaceContext> workspaceContext = _session->workspaceContext(sessionKey)) {
+            return workspaceContext;
+        }
+    }
+
+    ext::optional<pbxbuild::WorkspaceContext> workspaceContext;
     if (_workspace) {
         xcworkspace::XC::Workspace::shared_ptr workspace = xcworkspace::XC::Workspace::Open(filesystem, *_workspace);
         if (workspace == nullptr) {
@@ -160,20 +161,34 @@ loadWorkspace(Filesystem const *filesystem, std::string const &userName, pbxbuil
             return ext::nullopt;
         }
 
-        return pbxbuild::WorkspaceContext::Workspace(filesystem, userName, buildEnvironment.baseEnvironment(), workspace);
+        workspaceContext = pbxbuild::WorkspaceContext::Workspace(filesystem, userName, buildEnvironment.baseEnvironment(), workspace);
     } else {
         pbxproj::PBX::Project::shared_ptr project = OpenProject(filesystem, _project, workingDirectory);
         if (project == nullptr) {
             return ext::nullopt;
         }
 
-        return pbxbuild::WorkspaceContext::Project(filesystem, userName, buildEnvironment.baseEnvironment(), project);
+        workspaceContext = pbxbuild::WorkspaceContext::Project(filesystem, userName, buildEnvironment.baseEnvironment(), project);
     }
+
+    if (_session != nullptr) {
+        _session->insertWorkspaceContext(sessionKey, userName, filesystem, *workspaceContext);
+    }
+
+    return workspaceContext;
 }
 
 ext::optional<pbxbuild::Build::Context> Parameters::
 createBuildContext(pbxbuild::WorkspaceContext const &workspaceContext) const
 {
+    std::string sessionKey;
+    if (_session != nullptr) {
+        sessionKey = workspaceContext.basePath() + '\0' + canonicalHash();
+        if (ext::optional<pbxbuild::Build::Context> buildContext = _session->buildContext(sessionKey)) {
+            return buildContext;
+        }
+    }
+
     std::vector<std::string> actions = (!_actions.empty() ? _actions : std::vector<std::string>({ "build" }));
     std::string action = actions.front(); // TODO(grp): Support multiple actions and skipUnavailableOptions.
     if (action != "build") {
@@ -226,7 +241,7 @@ createBuildContext(pbxbuild::WorkspaceContext const &workspaceContext) const
         }
     }
 
-    return pbxbuild::Build::Context(
+    pbxbuild::Build::Context buildContext = pbxbuild::Build::Context(
         workspaceContext,
         scheme,
         schemeGroup,
@@ -234,6 +249,12 @@ createBuildContext(pbxbuild::WorkspaceContext const &workspaceContext) const
         configuration,
         defaultConfiguration,
         _overrideLevels);
+
+    if (_session != nullptr) {
+        _session->insertBuildContext(sessionKey, buildContext);
+    }
+
+    return buildContext;
 }
 
 ext::optional<pbxbuild::DirectedGraph<pbxproj::PBX::Target::shared_ptr>> Parameters::
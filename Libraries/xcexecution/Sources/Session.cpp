@@ -0,0 +1,349 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <xcexecution/Session.h>
+#include <xcsdk/Configuration.h>
+#include <xcsdk/SDK/Manager.h>
+#include <xcsdk/SDK/Platform.h>
+#include <xcsdk/SDK/Toolchain.h>
+#include <libutil/FSUtil.h>
+#include <process/Context.h>
+#include <process/User.h>
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using xcexecution::Session;
+using libutil::Filesystem;
+using libutil::FSUtil;
+
+Session::
+Session() :
+    _notify   (-1),
+    _unwatched(false)
+{
+#if defined(__linux__)
+    _notify = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+}
+
+Session::
+~Session()
+{
+#if defined(__linux__)
+    if (_notify >= 0) {
+        ::close(_notify);
+    }
+#endif
+}
+
+std::vector<Session::Dependency> Session::
+Record(Filesystem const *filesystem, std::vector<std::string> const &paths)
+{
+    std::vector<Dependency> dependencies;
+    dependencies.reserve(paths.size());
+
+    for (std::string const &path : paths) {
+        dependencies.push_back({ path, filesystem->metadata(path) });
+    }
+
+    return dependencies;
+}
+
+bool Session::
+Changed(Filesystem const *filesystem, std::vector<Dependency> const &dependencies)
+{
+    for (Dependency const &dependency : dependencies) {
+        ext::optional<Filesystem::Metadata> metadata = filesystem->metadata(dependency.path);
+        if (!metadata || !dependency.metadata) {
+            if (static_cast<bool>(metadata) != static_cast<bool>(dependency.metadata)) {
+                return true;
+            }
+        } else if (metadata->type != dependency.metadata->type ||
+                   metadata->size != dependency.metadata->size ||
+                   metadata->modificationTime != dependency.metadata->modificationTime) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Session::
+watch(Filesystem const *filesystem, std::vector<Dependency> const &dependencies)
+{
+#if defined(__linux__)
+    if (_notify < 0 || _unwatched) {
+        return;
+    }
+
+    for (Dependency const &dependency : dependencies) {
+        /*
+         * Watch directories themselves, and files through their containing
+         * directory. Missing entries are watched through their nearest
+         * existing parent, so creating them (or a parent) is noticed.
+         */
+        std::string directory = dependency.path;
+        while (filesystem->type(directory) != Filesystem::Type::Directory) {
+            std::string parent = FSUtil::GetDirectoryName(directory);
+            if (parent.empty() || parent == directory) {
+                break;
+            }
+            directory = parent;
+        }
+
+        if (!_watched.insert(directory).second) {
+            continue;
+        }
+
+        uint32_t mask = IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_MODIFY | IN_MOVE_SELF | IN_MOVED_FROM | IN_MOVED_TO;
+        if (::inotify_add_watch(_notify, directory.c_str(), mask) < 0) {
+            /* Can't rely on events for this directory, so always check. */
+            _unwatched = true;
+        }
+    }
+#else
+    (void)filesystem;
+    (void)dependencies;
+#endif
+}
+
+bool Session::
+changed()
+{
+#if defined(__linux__)
+    if (_notify < 0 || _unwatched) {
+        return true;
+    }
+
+    /* Drain pending events; any event (including an overflow) is a change. */
+    bool changed = false;
+    char buffer[4096];
+    while (::read(_notify, buffer, sizeof(buffer)) > 0) {
+        changed = true;
+    }
+
+    return changed;
+#else
+    return true;
+#endif
+}
+
+void Session::
+refresh(Filesystem const *filesystem)
+{
+    if (!changed()) {
+        return;
+    }
+
+    /*
+     * A parent of a missing entry may have been created, so watch the
+     * nearest existing parents again before checking for changes.
+     */
+    if (_buildEnvironment) {
+        watch(filesystem, _buildEnvironmentDependencies);
+    }
+    for (auto const &entry : _workspaces) {
+        watch(filesystem, entry.second.dependencies);
+    }
+
+    if (_buildEnvironment && Changed(filesystem, _buildEnvironmentDependencies)) {
+        _environmentKey.clear();
+        _buildEnvironment = ext::nullopt;
+        _buildEnvironmentDependencies.clear();
+        _buildContexts.clear();
+    }
+
+    for (auto it = _workspaces.begin(); it != _workspaces.end();) {
+        if (Changed(filesystem, it->second.dependencies)) {
+            /* Build contexts hold a copy of their workspace. */
+            it = _workspaces.erase(it);
+            _buildContexts.clear();
+        } else {
+            ++it;
+        }
+    }
+}
+
+/*
+ * The files and directories the specifications and SDKs of an environment
+ * were loaded from. Directories are included so added files are noticed.
+ */
+static std::vector<std::string>
+EnvironmentPaths(process::User const *user, process::Context const *processContext, Filesystem const *filesystem, pbxbuild::Build::Environment const &buildEnvironment)
+{
+    std::shared_ptr<xcsdk::SDK::Manager> const &sdkManager = buildEnvironment.sdkManager();
+    std::string const &developerRoot = sdkManager->path();
+
+    std::vector<std::string> configurationPaths = xcsdk::Configuration::DefaultPaths(user, processContext);
+    std::vector<std::string> paths = configurationPaths;
+    paths.push_back(developerRoot);
+    paths.push_back(developerRoot + "/Platforms");
+    paths.push_back(developerRoot + "/Toolchains");
+    if (ext::optional<xcsdk::Configuration> configuration = xcsdk::Configuration::Load(filesystem, configurationPaths)) {
+        paths.insert(paths.end(), configuration->extraPlatformsPaths().begin(), configuration->extraPlatformsPaths().end());
+        paths.insert(paths.end(), configuration->extraToolchainsPaths().begin(), configuration->extraToolchainsPaths().end());
+    }
+
+    /*
+     * SDKs are loaded only when used, so depend on all of them.
+     */
+    std::unordered_map<std::string, std::string> platforms;
+    for (xcsdk::SDK::Platform::shared_ptr const &platform : sdkManager->platforms()) {
+        platforms.insert({ platform->name(), platform->path() });
+
+        paths.push_back(platform->path());
+        paths.push_back(platform->path() + "/Info.plist");
+        paths.push_back(platform->path() + "/version.plist");
+        paths.push_back(platform->path() + "/Developer/SDKs");
+        for (std::string const &targetPath : platform->targetPaths()) {
+            paths.push_back(targetPath);
+            paths.push_back(targetPath + "/SDKSettings.plist");
+            paths.push_back(targetPath + "/Info.plist");
+            paths.push_back(targetPath + "/System/Library/CoreServices/SystemVersion.plist");
+        }
+    }
+
+    for (xcsdk::SDK::Toolchain::shared_ptr const &toolchain : sdkManager->toolchains()) {
+        paths.push_back(toolchain->path());
+        paths.push_back(toolchain->path() + "/ToolchainInfo.plist");
+        paths.push_back(toolchain->path() + "/Info.plist");
+        std::vector<std::string> executablePaths = toolchain->executablePaths();
+        paths.insert(paths.end(), executablePaths.begin(), executablePaths.end());
+    }
+
+    /*
+     * Specification domains are either a file or a directory searched
+     * for specification files, the same as when registering them.
+     */
+    std::vector<std::pair<std::string, std::string>> domains = pbxspec::Manager::DefaultDomains(developerRoot);
+    std::vector<std::pair<std::string, std::string>> platformDomains = pbxspec::Manager::PlatformDomains(platforms);
+    std::vector<std::pair<std::string, std::string>> platformDependentDomains = pbxspec::Manager::PlatformDependentDomains(developerRoot);
+    domains.insert(domains.end(), platformDomains.begin(), platformDomains.end());
+    domains.insert(domains.end(), platformDependentDomains.begin(), platformDependentDomains.end());
+
+    for (auto const &domain : domains) {
+        paths.push_back(domain.second);
+
+        std::string realPath = filesystem->resolvePath(domain.second);
+        if (realPath.empty()) {
+            continue;
+        }
+        if (realPath != domain.second) {
+            paths.push_back(realPath);
+        }
+
+        if (filesystem->type(realPath) == Filesystem::Type::Directory) {
+            filesystem->enumerateDirectory(realPath, true, false, [&](Filesystem::DirectoryEntry const &entry) {
+                std::string extension = FSUtil::GetFileExtension(entry.path);
+                if (entry.type == Filesystem::Type::Directory || extension == "xcspec" || extension == "pbfilespec") {
+                    paths.push_back(realPath + "/" + entry.path);
+                }
+            });
+        }
+    }
+
+    std::vector<std::string> buildRules = pbxspec::Manager::DeveloperBuildRules(developerRoot);
+    paths.insert(paths.end(), buildRules.begin(), buildRules.end());
+
+    return paths;
+}
+
+ext::optional<pbxbuild::Build::Environment> Session::
+buildEnvironment(process::User const *user, process::Context const *processContext, Filesystem *filesystem)
+{
+    /*
+     * Outside of specifications and SDKs, the environment only depends on
+     * the user and the environment variables of the process.
+     */
+    std::vector<std::string> variables;
+    for (auto const &entry : processContext->environmentVariables()) {
+        variables.push_back(entry.first + "=" + entry.second);
+    }
+    std::sort(variables.begin(), variables.end());
+
+    std::string key = user->userName();
+    for (std::string const &variable : variables) {
+        key += '\0';
+        key += variable;
+    }
+
+    if (_buildEnvironment && key == _environmentKey) {
+        return _buildEnvironment;
+    }
+
+    ext::optional<pbxbuild::Build::Environment> buildEnvironment = pbxbuild::Build::Environment::Default(user, processContext, filesystem, _buildEnvironment ? &*_buildEnvironment : nullptr);
+    if (!buildEnvironment) {
+        return ext::nullopt;
+    }
+
+    if (!_buildEnvironment || buildEnvironment->specManager() != _buildEnvironment->specManager()) {
+        _buildEnvironmentDependencies = Record(filesystem, EnvironmentPaths(user, processContext, filesystem, *buildEnvironment));
+        watch(filesystem, _buildEnvironmentDependencies);
+    }
+
+    /* Target environments are computed from the base environment. */
+    _buildContexts.clear();
+
+    /* Environments can't be assigned, so replace it. */
+    _environmentKey = key;
+    _buildEnvironment = ext::nullopt;
+    _buildEnvironment.emplace(*buildEnvironment);
+    return buildEnvironment;
+}
+
+ext::optional<pbxbuild::WorkspaceContext> Session::
+workspaceContext(std::string const &key) const
+{
+    auto it = _workspaces.find(key);
+    if (it == _workspaces.end()) {
+        return ext::nullopt;
+    }
+
+    return it->second.context;
+}
+
+void Session::
+insertWorkspaceContext(std::string const &key, std::string const &userName, Filesystem const *filesystem, pbxbuild::WorkspaceContext const &workspaceContext)
+{
+    std::vector<std::string> paths = workspaceContext.loadedFilePaths();
+
+    /* New schemes are found by listing their directories, even ones that don't exist yet. */
+    for (xcscheme::SchemeGroup::shared_ptr const &schemeGroup : workspaceContext.schemeGroups()) {
+        paths.push_back(schemeGroup->path() + "/xcshareddata/xcschemes");
+        paths.push_back(schemeGroup->path() + "/xcuserdata/" + userName + ".xcuserdatad/xcschemes");
+    }
+
+    Workspace workspace = { workspaceContext, Record(filesystem, paths) };
+    watch(filesystem, workspace.dependencies);
+
+    _workspaces.erase(key);
+    _workspaces.insert({ key, std::move(workspace) });
+}
+
+ext::optional<pbxbuild::Build::Context> Session::
+buildContext(std::string const &key) const
+{
+    auto it = _buildContexts.find(key);
+    if (it == _buildContexts.end()) {
+        return ext::nullopt;
+    }
+
+    return it->second;
+}
+
+void Session::
+insertBuildContext(std::string const &key, pbxbuild::Build::Context const &buildContext)
+{
+    _buildContexts.erase(key);
+    _buildContexts.insert({ key, buildContext });
+}
@@ -35,6 +35,8 @@ SimpleExecutor(std::shared_ptr<xcformatter::Formatter> const &formatter, bool dr
     Executor (formatter, dryRun, false),
     _builtins(builtins)
 {
+    /* A tool that isn't found yet could be built by an earlier invocation. */
+    _executables = libutil::ExecutableCache(false);
 }
 
 SimpleExecutor::
@@ -51,6 +53,9 @@ build(
     pbxbuild::Build::Environment const &buildEnvironment,
     Parameters const &buildParameters)
 {
+    /* Tools could have changed since the last build. */
+    _executables.invalidate();
+
     ext::optional<pbxbuild::WorkspaceContext> workspaceContext = buildParameters.loadWorkspace(filesystem, user->userName(), buildEnvironment, processContext->currentDirectory());
     if (!workspaceContext) {
         return false;
@@ -182,27 +187,28 @@ writeAuxiliaryFiles(
         xcformatter::Formatter::Print(_formatter->writeAuxiliaryFile(auxiliaryFile.path()));
 
         if (!_dryRun) {
-            std::vector<uint8_t> data;
-
-            for (pbxbuild::Tool::AuxiliaryFile::Chunk const &chunk : auxiliaryFile.chunks()) {
-                switch (chunk.type()) {
-                    case pbxbuild::Tool::AuxiliaryFile::Chunk::Type::Data: {
-                        data.insert(data.end(), chunk.data()->begin(), chunk.data()->end());
-                        break;
-                    }
-                    case pbxbuild::Tool::AuxiliaryFile::Chunk::Type::File: {
-                        std::vector<uint8_t> contents;
-                        if (!filesystem->read(&contents, *chunk.file())) {
-                            return false;
+            /* Unchanged files keep their modification time, so dependents aren't rebuilt. */
+            if (!filesystem->writeAtomically(auxiliaryFile.path(), true, false, [&](Filesystem::Append const &append) -> bool {
+                for (pbxbuild::Tool::AuxiliaryFile::Chunk const &chunk : auxiliaryFile.chunks()) {
+                    switch (chunk.type()) {
+                        case pbxbuild::Tool::AuxiliaryFile::Chunk::Type::Data: {
+                            if (!append(chunk.data()->data(), chunk.data()->size())) {
+                                return false;
+                            }
+                            break;
                         }
-                        data.insert(data.end(), contents.begin(), contents.end());
-                        break;
+                        case pbxbuild::Tool::AuxiliaryFile::Chunk::Type::File: {
+                            std::unique_ptr<libutil::MappedFile> contents = filesystem->map(*chunk.file());
+                            if (contents == nullptr || !append(contents->data(), contents->size())) {
+                                return false;
+                            }
+                            break;
+                        }
+                        default: abort();
                     }
-                    default: abort();
                 }
-            }
-
-            if (!filesystem->write(data, auxiliaryFile.path())) {
+                return true;
+            })) {
                 return false;
             }
         }
@@ -282,7 +288,7 @@ performInvocations(
                         path = external;
                     }
                 } else {
-                    path = filesystem->findExecutable(*external, executablePaths);
+                    path = _executables.find(filesystem, *external, executablePaths);
                 }
 
                 if (path) {
@@ -312,6 +318,17 @@ performInvocations(
             if (!success) {
                 return std::make_pair(false, std::vector<pbxbuild::Tool::Invocation>({ invocation }));
             }
+
+            /*
+             * Later invocations could run a tool built by this one. Without
+             * declared outputs, it could have written anywhere.
+             */
+            if (invocation.outputs().empty()) {
+                _executables.invalidate();
+            }
+            for (std::string const &output : invocation.outputs()) {
+                _executables.invalidate(FSUtil::GetDirectoryName(output));
+            }
         }
     }
 
@@ -0,0 +1,211 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <xcexecution/Parameters.h>
+#include <xcexecution/Session.h>
+#include <libutil/DefaultFilesystem.h>
+#include <libutil/MemoryFilesystem.h>
+#include <process/DefaultUser.h>
+#include <process/MemoryContext.h>
+
+using xcexecution::Parameters;
+using xcexecution::Session;
+using libutil::DefaultFilesystem;
+using libutil::MemoryFilesystem;
+
+static std::string const ProjectContents = R"PROJECT(// !$*UTF8*$!
+{
+	archiveVersion = 1;
+	classes = {
+	};
+	objectVersion = 46;
+	objects = {
+		G10000000000000000000001 = {isa = PBXGroup; children = (); sourceTree = "<group>"; };
+		P10000000000000000000001 = {
+			isa = PBXProject;
+			buildConfigurationList = L10000000000000000000001;
+			compatibilityVersion = "Xcode 3.2";
+			mainGroup = G10000000000000000000001;
+			projectDirPath = "";
+			projectRoot = "";
+			targets = ();
+		};
+		C10000000000000000000001 = {isa = XCBuildConfiguration; buildSettings = {}; name = Debug; };
+		L10000000000000000000001 = {
+			isa = XCConfigurationList;
+			buildConfigurations = (C10000000000000000000001);
+			defaultConfigurationIsVisible = 0;
+			defaultConfigurationName = Debug;
+		};
+	};
+	rootObject = P10000000000000000000001;
+}
+)PROJECT";
+
+static std::vector<uint8_t>
+Contents(std::string const &string)
+{
+    return std::vector<uint8_t>(string.begin(), string.end());
+}
+
+TEST(Session, ReuseUntilChanged)
+{
+    auto filesystem = MemoryFilesystem({
+        MemoryFilesystem::Entry::Directory("App.xcodeproj", {
+            MemoryFilesystem::Entry::File("project.pbxproj", Contents(ProjectContents)),
+        }),
+    });
+
+    auto buildEnvironment = pbxbuild::Build::Environment(nullptr, nullptr, pbxsetting::Environment(), { });
+
+    Session session;
+    auto parameters = Parameters(ext::nullopt, filesystem.path("App.xcodeproj"), ext::nullopt, ext::nullopt, false, { }, ext::nullopt, { }, &session);
+
+    /* Loading again reuses the loaded workspace and build context. */
+    auto first = parameters.loadWorkspace(&filesystem, "user", buildEnvironment, filesystem.path(""));
+    ASSERT_TRUE(first);
+    ASSERT_NE(first->project(), nullptr);
+
+    auto firstContext = parameters.createBuildContext(*first);
+    ASSERT_TRUE(firstContext);
+    EXPECT_EQ("Debug", firstContext->configuration());
+
+    session.refresh(&filesystem);
+    auto second = parameters.loadWorkspace(&filesystem, "user", buildEnvironment, filesystem.path(""));
+    ASSERT_TRUE(second);
+    EXPECT_EQ(first->project(), second->project());
+
+    auto secondContext = parameters.createBuildContext(*second);
+    ASSERT_TRUE(secondContext);
+    EXPECT_EQ(firstContext->workspaceContext().project(), secondContext->workspaceContext().project());
+
+    /* Other parameters don't share the loaded workspace. */
+    auto other = Parameters(ext::nullopt, filesystem.path("App.xcodeproj"), ext::nullopt, ext::nullopt, false, { }, ext::nullopt, { });
+    auto unshared = other.loadWorkspace(&filesystem, "user", buildEnvironment, filesystem.path(""));
+    ASSERT_TRUE(unshared);
+    EXPECT_NE(first->project(), unshared->project());
+
+    /* Changing the project drops the loaded workspace. */
+    ASSERT_TRUE(filesystem.write(Contents(ProjectContents + "\n"), filesystem.path("App.xcodeproj/project.pbxproj")));
+    session.refresh(&filesystem);
+
+    auto third = parameters.loadWorkspace(&filesystem, "user", buildEnvironment, filesystem.path(""));
+    ASSERT_TRUE(third);
+    EXPECT_NE(first->project(), third->project());
+
+    auto thirdContext = parameters.createBuildContext(*third);
+    ASSERT_TRUE(thirdContext);
+    EXPECT_EQ(third->project(), thirdContext->workspaceContext().project());
+}
+
+TEST(Session, CreatedDependencies)
+{
+    /* Watching only works on a real filesystem. */
+    char root[] = "/tmp/xcexecution-session-XXXXXX";
+    ASSERT_NE(nullptr, mkdtemp(root));
+    std::string path = root;
+
+    DefaultFilesystem filesystem;
+    ASSERT_TRUE(filesystem.createDirectory(path + "/App.xcodeproj", false));
+    ASSERT_TRUE(filesystem.write(Contents(ProjectContents), path + "/App.xcodeproj/project.pbxproj"));
+
+    auto buildEnvironment = pbxbuild::Build::Environment(nullptr, nullptr, pbxsetting::Environment(), { });
+
+    Session session;
+    auto parameters = Parameters(ext::nullopt, path + "/App.xcodeproj", ext::nullopt, ext::nullopt, false, { }, ext::nullopt, { }, &session);
+    auto first = parameters.loadWorkspace(&filesystem, "user", buildEnvironment, path);
+    ASSERT_TRUE(first);
+
+    /* Creating a parent of a missing scheme directory isn't a change itself. */
+    ASSERT_TRUE(filesystem.createDirectory(path + "/App.xcodeproj/xcshareddata", false));
+    session.refresh(&filesystem);
+    auto second = parameters.loadWorkspace(&filesystem, "user", buildEnvironment, path);
+    ASSERT_TRUE(second);
+    EXPECT_EQ(first->project(), second->project());
+
+    /* Creating the scheme directory is noticed, through its parent. */
+    ASSERT_TRUE(filesystem.createDirectory(path + "/App.xcodeproj/xcshareddata/xcschemes", false));
+    session.refresh(&filesystem);
+    auto third = parameters.loadWorkspace(&filesystem, "user", buildEnvironment, path);
+    ASSERT_TRUE(third);
+    EXPECT_NE(second->project(), third->project());
+
+    /* So is creating a user scheme directory, with its parents at once. */
+    ASSERT_TRUE(filesystem.createDirectory(path + "/App.xcodeproj/xcuserdata/user.xcuserdatad/xcschemes", true));
+    session.refresh(&filesystem);
+    auto fourth = parameters.loadWorkspace(&filesystem, "user", buildEnvironment, path);
+    ASSERT_TRUE(fourth);
+    EXPECT_NE(third->project(), fourth->project());
+
+    filesystem.removeDirectory(path, true);
+}
+
+TEST(Session, BuildEnvironmentUntilChanged)
+{
+    std::string const buildSystem = "{ Type = BuildSystem; Identifier = com.apple.build-system.core; Options = (); }";
+    auto filesystem = MemoryFilesystem({
+        MemoryFilesystem::Entry::Directory("Developer", {
+            MemoryFilesystem::Entry::Directory("Library", {
+                MemoryFilesystem::Entry::Directory("Xcode", {
+                    MemoryFilesystem::Entry::Directory("Specifications", {
+                        MemoryFilesystem::Entry::File("BuildSystem.xcspec", Contents(buildSystem)),
+                    }),
+                }),
+            }),
+            MemoryFilesystem::Entry::Directory("Platforms", {
+                MemoryFilesystem::Entry::Directory("Test.platform", {
+                    MemoryFilesystem::Entry::File("Info.plist", Contents("{ Identifier = test; Name = test; }")),
+                    MemoryFilesystem::Entry::Directory("Developer", {
+                        MemoryFilesystem::Entry::Directory("SDKs", {
+                            MemoryFilesystem::Entry::Directory("Test1.0.sdk", {
+                                MemoryFilesystem::Entry::File("SDKSettings.plist", Contents("{ CanonicalName = test1.0; }")),
+                            }),
+                        }),
+                    }),
+                }),
+            }),
+            MemoryFilesystem::Entry::Directory("Toolchains", { }),
+        }),
+    });
+
+    auto user = process::DefaultUser();
+    auto processContext = process::MemoryContext("xcbuild", filesystem.path(""), { }, { { "DEVELOPER_DIR", filesystem.path("Developer") } });
+
+    Session session;
+    auto first = session.buildEnvironment(&user, &processContext, &filesystem);
+    ASSERT_TRUE(first);
+
+    /* Unchanged, the specifications and SDKs are kept. */
+    session.refresh(&filesystem);
+    auto second = session.buildEnvironment(&user, &processContext, &filesystem);
+    ASSERT_TRUE(second);
+    EXPECT_EQ(first->specManager(), second->specManager());
+    EXPECT_EQ(first->sdkManager(), second->sdkManager());
+
+    /* Changing an SDK's settings reloads them. */
+    ASSERT_TRUE(filesystem.write(Contents("{ CanonicalName = test1.0; Version = 1.0; }"), filesystem.path("Developer/Platforms/Test.platform/Developer/SDKs/Test1.0.sdk/SDKSettings.plist")));
+    session.refresh(&filesystem);
+    auto third = session.buildEnvironment(&user, &processContext, &filesystem);
+    ASSERT_TRUE(third);
+    EXPECT_NE(second->sdkManager(), third->sdkManager());
+
+    /* Changing a specification reloads them. */
+    ASSERT_TRUE(filesystem.write(Contents(buildSystem + "\n"), filesystem.path("Developer/Library/Xcode/Specifications/BuildSystem.xcspec")));
+    session.refresh(&filesystem);
+    auto fourth = session.buildEnvironment(&user, &processContext, &filesystem);
+    ASSERT_TRUE(fourth);
+    EXPECT_NE(third->specManager(), fourth->specManager());
+
+    /* So does changing a platform's information. */
+    ASSERT_TRUE(filesystem.write(Contents("{ Identifier = test; Name = test; Version = 2; }"), filesystem.path("Developer/Platforms/Test.platform/Info.plist")));
+    session.refresh(&filesystem);
+    auto fifth = session.buildEnvironment(&user, &processContext, &filesystem);
+    ASSERT_TRUE(fifth);
+    EXPECT_NE(fourth->specManager(), fifth->specManager());
+}
@@ -56,12 +56,18 @@ public:
     xcscheme::XC::Scheme::shared_ptr scheme(std::string const &name) const;
 
 public:
+    /*
+     * Open the schemes in a project or workspace. Schemes are parsed on up
+     * to `threads` threads, as with `libutil::Parallel::ForEach`; pass one
+     * when already running in parallel.
+     */
     static SchemeGroup::shared_ptr Open(
         libutil::Filesystem const *filesystem,
         ext::optional<std::string> const &userName,
         std::string const &basePath,
         std::string const &path,
-        std::string const &name);
+        std::string const &name,
+        size_t threads = 0);
 };
 
 }
@@ -10,11 +10,13 @@
 
 #include <libutil/Filesystem.h>
 #include <libutil/FSUtil.h>
+#include <libutil/Parallel.h>
 
 using xcscheme::SchemeGroup;
 using xcscheme::XC::Scheme;
 using libutil::Filesystem;
 using libutil::FSUtil;
+using libutil::Parallel;
 
 SchemeGroup::
 SchemeGroup()
@@ -34,7 +36,7 @@ scheme(std::string const &name) const
 }
 
 SchemeGroup::shared_ptr SchemeGroup::
-Open(Filesystem const *filesystem, ext::optional<std::string> const &userName, std::string const &basePath, std::string const &path, std::string const &name)
+Open(Filesystem const *filesystem, ext::optional<std::string> const &userName, std::string const &basePath, std::string const &path, std::string const &name, size_t threads)
 {
     if (path.empty() || basePath.empty()) {
         return nullptr;
@@ -54,48 +56,55 @@ Open(Filesystem const *filesystem, ext::optional<std::string> const &userName, s
     group->_path = path;
     group->_name = name;
 
-    std::string schemePath;
+    struct Entry {
+        std::string name;
+        std::string owner;
+        std::string path;
+        Scheme::shared_ptr scheme;
+    };
+    std::vector<Entry> entries;
 
-    schemePath = path + "/xcshareddata/xcschemes";
-    filesystem->readDirectory(schemePath, false, [&](std::string const &filename) -> void {
+    std::string sharedPath = path + "/xcshareddata/xcschemes";
+    filesystem->readDirectory(sharedPath, false, [&](std::string const &filename) -> void {
         if (FSUtil::GetFileExtension(filename) != "xcscheme") {
             return;
         }
 
-        std::string name = filename.substr(0, filename.find('.'));
-        auto scheme = Scheme::Open(filesystem, name, std::string(), schemePath + "/" + filename);
-        if (!scheme) {
-            fprintf(stderr, "warning: failed parsing shared scheme '%s'\n", name.c_str());
-        } else {
-            group->_schemes.push_back(scheme);
-        }
-
-        if (!group->_defaultScheme && name == group->name()) {
-            group->_defaultScheme = scheme;
-        }
+        entries.push_back({ filename.substr(0, filename.find('.')), std::string(), sharedPath + "/" + filename, nullptr });
     });
 
     if (userName) {
-        schemePath = path + "/xcuserdata/" + *userName + ".xcuserdatad/xcschemes";
-        filesystem->readDirectory(schemePath, false, [&](std::string const &filename) -> void {
+        std::string userPath = path + "/xcuserdata/" + *userName + ".xcuserdatad/xcschemes";
+        filesystem->readDirectory(userPath, false, [&](std::string const &filename) -> void {
             if (FSUtil::GetFileExtension(filename) != "xcscheme") {
                 return;
             }
 
-            std::string name = filename.substr(0, filename.find('.'));
-            auto scheme = Scheme::Open(filesystem, name, *userName, schemePath + "/" + filename);
-            if (!scheme) {
-                fprintf(stderr, "warning: failed parsing user scheme '%s'\n", name.c_str());
-            } else {
-                group->_schemes.push_back(scheme);
-            }
-
-            if (!group->_defaultScheme && name == group->name()) {
-                group->_defaultScheme = scheme;
-            }
+            entries.push_back({ filename.substr(0, filename.find('.')), *userName, userPath + "/" + filename, nullptr });
         });
     }
 
+    /*
+     * Schemes are independent, so parse them concurrently. Add them to the
+     * group afterwards to keep the order they were found in.
+     */
+    Parallel::ForEach(entries.size(), [&](size_t n) {
+        Entry *entry = &entries[n];
+        entry->scheme = Scheme::Open(filesystem, entry->name, entry->owner, entry->path);
+    }, threads);
+
+    for (Entry const &entry : entries) {
+        if (!entry.scheme) {
+            fprintf(stderr, "warning: failed parsing %s scheme '%s'\n", entry.owner.empty() ? "shared" : "user", entry.name.c_str());
+        } else {
+            group->_schemes.push_back(entry.scheme);
+        }
+
+        if (!group->_defaultScheme && entry.name == group->name()) {
+            group->_defaultScheme = entry.scheme;
+        }
+    }
+
     if (!group->_schemes.empty() && !group->_defaultScheme) {
         group->_defaultScheme = group->_schemes[0];
     }
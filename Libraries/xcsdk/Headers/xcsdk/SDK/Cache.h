@@ -0,0 +1,114 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef __xcsdk_SDK_Cache_h
+#define __xcsdk_SDK_Cache_h
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <ext/optional>
+
+namespace libutil { class Filesystem; }
+namespace plist { class Dictionary; }
+namespace process { class Context; }
+namespace process { class User; }
+
+namespace xcsdk { namespace SDK {
+
+/*
+ * Remembers the directories and property lists read while discovering the
+ * toolchains, platforms, and SDKs in a developer root, so later runs don't
+ * need to read and parse them again. A directory is only used while its
+ * modification time is unchanged, and a property list while its size and
+ * modification time are unchanged.
+ */
+class Cache {
+private:
+    struct Directory {
+        int64_t                                  modificationTime;
+        std::vector<std::string>                 entries;
+        bool                                     used;
+    };
+
+    struct File {
+        uint64_t                                 size;
+        int64_t                                  modificationTime;
+        std::shared_ptr<plist::Dictionary const> contents;
+        bool                                     used;
+    };
+
+private:
+    libutil::Filesystem                       *_filesystem;
+    std::string                                _path;
+
+private:
+    std::mutex                                 _mutex;
+    std::unordered_map<std::string, Directory> _directories;
+    std::unordered_map<std::string, File>      _files;
+    bool                                       _modified;
+
+public:
+    Cache(libutil::Filesystem *filesystem, std::string const &path);
+
+public:
+    /*
+     * The path to the cache file.
+     */
+    std::string const &path() const
+    { return _path; }
+
+public:
+    /*
+     * Load the cache file. Returns false, leaving the cache empty, if
+     * there is no cache file or it can't be used.
+     */
+    bool load();
+
+    /*
+     * Write the cache file, if anything new was read since it was loaded.
+     * Entries that were not used since loading are dropped.
+     */
+    bool store();
+
+public:
+    /*
+     * Read the entries in a directory, from the cache if it's up to date.
+     * The cache can be null, to read the directory directly.
+     */
+    static bool
+    ReadDirectory(libutil::Filesystem const *filesystem, std::string const &path, Cache *cache, std::function<void(std::string const &)> const &cb);
+
+    /*
+     * Read a property list containing a dictionary, from the cache if it's
+     * up to date. The cache can be null, to read the file directly.
+     */
+    static std::unique_ptr<plist::Dictionary>
+    ReadPropertyList(libutil::Filesystem const *filesystem, std::string const &path, Cache *cache);
+
+public:
+    /*
+     * The directory for caches of developer root contents.
+     */
+    static ext::optional<std::string>
+    DefaultDirectory(process::User const *user, process::Context const *processContext);
+
+    /*
+     * The default cache file for a developer root.
+     */
+    static ext::optional<std::string>
+    DefaultPath(process::User const *user, process::Context const *processContext, std::string const &developerRoot);
+};
+
+} }
+
+#endif  // !__xcsdk_SDK_Cache_h
@@ -0,0 +1,149 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#ifndef __xcsdk_SDK_LookupCache_h
+#define __xcsdk_SDK_LookupCache_h
+
+#include <libutil/Filesystem.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <ext/optional>
+
+namespace process { class Context; }
+namespace process { class User; }
+
+namespace xcsdk { namespace SDK {
+
+class Target;
+
+/*
+ * Results of earlier lookups of tools and SDK values, so repeating a lookup
+ * doesn't need to load the developer root. Each result records the files
+ * and directories it depends on, and is only used while none of them have
+ * changed.
+ */
+class LookupCache {
+public:
+    /*
+     * The state of a file or directory when a result was found.
+     */
+    struct Dependency {
+        std::string                                    path;
+        ext::optional<libutil::Filesystem::Metadata>   metadata;
+    };
+
+private:
+    struct Entry {
+        std::vector<std::string>                       values;
+        std::vector<Dependency>                        dependencies;
+    };
+
+private:
+    libutil::Filesystem                               *_filesystem;
+    std::string                                        _path;
+
+private:
+    std::unordered_map<std::string, Entry>             _entries;
+    std::unordered_set<std::string>                    _inserted;
+
+public:
+    LookupCache(libutil::Filesystem *filesystem, std::string const &path);
+
+public:
+    /*
+     * The path to the cache file.
+     */
+    std::string const &path() const
+    { return _path; }
+
+public:
+    /*
+     * Load the cache file. Returns false, leaving the cache empty, if
+     * there is no cache file or it can't be used.
+     */
+    bool load();
+
+    /*
+     * Write the cache file, if anything was inserted since it was loaded.
+     * The file is read again first, so entries other processes stored in
+     * the meantime are kept. Entries stored between that read and the
+     * write can still be lost; that only means repeating their lookup.
+     */
+    bool store();
+
+    /*
+     * Remove the cache file and forget all entries.
+     */
+    bool remove();
+
+public:
+    /*
+     * The values stored for a key, if they are still up to date.
+     */
+    ext::optional<std::vector<std::string>>
+    find(std::string const &key) const;
+
+    /*
+     * Store values for a key. The dependencies should be captured before
+     * the lookup they describe, so changes during the lookup aren't missed.
+     */
+    void
+    insert(std::string const &key, std::vector<std::string> const &values, std::vector<Dependency> const &dependencies);
+
+public:
+    /*
+     * Capture the current state of a file or directory.
+     */
+    Dependency
+    dependency(std::string const &path) const;
+
+    /*
+     * Capture the directories a tool would be found in, one per search path.
+     * Adding the tool to any of them can change which one is found.
+     */
+    std::vector<Dependency>
+    searchDependencies(std::vector<std::string> const &searchPaths, std::string const &name) const;
+
+    /*
+     * Capture the SDK directory and the files its values are read from,
+     * including its platform's.
+     */
+    std::vector<Dependency>
+    targetDependencies(Target const &target) const;
+
+public:
+    /*
+     * Open and load the cache file, as xcrun's options ask. With `kill`
+     * (-k), the existing file is removed first. With `bypass` (-n), no
+     * cache is used and null is returned; the file is left alone unless
+     * it was also killed.
+     */
+    static std::unique_ptr<LookupCache>
+    Open(libutil::Filesystem *filesystem, std::string const &path, bool kill, bool bypass);
+
+public:
+    /*
+     * A key for the inputs to a lookup.
+     */
+    static std::string
+    Key(std::vector<std::string> const &components);
+
+    /*
+     * The default cache file.
+     */
+    static ext::optional<std::string>
+    DefaultPath(process::User const *user, process::Context const *processContext);
+};
+
+} }
+
+#endif  // !__xcsdk_SDK_LookupCache_h
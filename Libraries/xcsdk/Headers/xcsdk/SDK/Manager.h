@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <ext/optional>
 
 namespace libutil { class Filesystem; }
@@ -23,6 +24,8 @@ namespace xcsdk { class Configuration; }
 
 namespace xcsdk { namespace SDK {
 
+class Cache;
+
 /*
  * Represents the contents of a developer root, containing toolchains,
  * platforms, and SDKs. There is usually only one developer root.
@@ -32,6 +35,22 @@ private:
     std::string                        _path;
     std::vector<Platform::shared_ptr>  _platforms;
     std::vector<Toolchain::shared_ptr> _toolchains;
+    bool                               _lazy;
+
+private:
+    /*
+     * Lookup tables for finding targets and toolchains by name or path.
+     * Each entry keeps its position in the search order, so when a name
+     * and a path both match, the earlier one is used. Targets are not
+     * indexed when opened lazily.
+     */
+    template<typename T>
+    using Index = std::unordered_map<std::string, std::pair<size_t, T>>;
+
+    Index<Target::shared_ptr>          _targetNames;
+    Index<Target::shared_ptr>          _targetPaths;
+    Index<Toolchain::shared_ptr>       _toolchainNames;
+    Index<Toolchain::shared_ptr>       _toolchainPaths;
 
 public:
     Manager();
@@ -104,9 +123,12 @@ public:
 
 public:
     /*
-     * Load from a developer root. Returns nullptr on error.
+     * Load from a developer root. Returns nullptr on error. If there is a
+     * cache, unchanged toolchains, platforms, and SDKs are loaded from it.
+     * If lazy, each platform's SDKs are only loaded once they are searched
+     * or listed, and the filesystem must remain valid until then.
      */
-    static std::shared_ptr<Manager> Open(libutil::Filesystem const *filesystem, std::string const &path, ext::optional<Configuration> const &configuration);
+    static std::shared_ptr<Manager> Open(libutil::Filesystem const *filesystem, std::string const &path, ext::optional<Configuration> const &configuration, Cache *cache = nullptr, bool lazy = false);
 };
 
 } }
@@ -14,6 +14,7 @@
 #include <pbxsetting/Level.h>
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -22,7 +23,9 @@ namespace plist { class Dictionary; }
 
 namespace xcsdk { namespace SDK {
 
-class Platform {
+class Cache;
+
+class Platform : public std::enable_shared_from_this<Platform> {
 public:
     typedef std::shared_ptr <Platform> shared_ptr;
     typedef std::vector <shared_ptr> vector;
@@ -30,7 +33,16 @@ public:
 private:
     std::weak_ptr<Manager>           _manager;
     PlatformVersion::shared_ptr      _platformVersion;
-    std::vector<Target::shared_ptr>  _targets;
+
+private:
+    /*
+     * The SDKs are found when the platform is opened, but might only be
+     * loaded when they are first needed.
+     */
+    libutil::Filesystem const              *_filesystem;
+    std::vector<std::string>                _targetPaths;
+    mutable std::vector<Target::shared_ptr> _targets;
+    mutable std::once_flag                  _targetsLoaded;
 
 private:
     std::string                      _path;
@@ -71,8 +83,14 @@ public:
 public:
     inline PlatformVersion::shared_ptr const &platformVersion() const
     { return _platformVersion; }
-    inline std::vector<Target::shared_ptr> const &targets() const
-    { return _targets; }
+    inline std::vector<std::string> const &targetPaths() const
+    { return _targetPaths; }
+
+    /*
+     * The SDKs in the platform. If the platform was opened lazily, this
+     * loads them the first time it's called.
+     */
+    std::vector<Target::shared_ptr> const &targets() const;
 
 public:
     inline std::string const &path() const
@@ -127,10 +145,21 @@ public:
     std::vector<std::string> executablePaths() const;
 
 public:
-    static Platform::shared_ptr Open(libutil::Filesystem const *filesystem, std::shared_ptr<Manager> manager, std::string const &path);
+    /*
+     * The file a platform's information is read from.
+     */
+    static std::string SettingsFileName(std::string const &path);
+
+public:
+    /*
+     * Open a platform. If lazy, its SDKs are not loaded until they are
+     * used, and the filesystem must remain valid until then.
+     */
+    static Platform::shared_ptr Open(libutil::Filesystem const *filesystem, std::shared_ptr<Manager> manager, std::string const &path, Cache *cache = nullptr, bool lazy = false);
 
 private:
     bool parse(plist::Dictionary const *dict);
+    void loadTargets(Cache *cache) const;
 };
 
 } }
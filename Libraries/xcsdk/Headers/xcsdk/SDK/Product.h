@@ -18,6 +18,8 @@ namespace plist { class Dictionary; }
 
 namespace xcsdk { namespace SDK {
 
+class Cache;
+
 class Product {
 public:
     typedef std::shared_ptr <Product> shared_ptr;
@@ -45,7 +47,13 @@ public:
     { return _productCopyright; }
 
 public:
-    static Product::shared_ptr Open(libutil::Filesystem const *filesystem, std::string const &path);
+    /*
+     * The file an SDK's product information is read from.
+     */
+    static std::string SettingsFileName(std::string const &path);
+
+public:
+    static Product::shared_ptr Open(libutil::Filesystem const *filesystem, std::string const &path, Cache *cache = nullptr);
 
 private:
     bool parse(plist::Dictionary const *dict);
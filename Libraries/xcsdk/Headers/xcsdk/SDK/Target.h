@@ -23,6 +23,7 @@ namespace plist { class Dictionary; }
 
 namespace xcsdk { namespace SDK {
 
+class Cache;
 class Manager;
 class Platform;
 
@@ -131,7 +132,13 @@ public:
     std::vector<std::string> executablePaths() const;
 
 public:
-    static Target::shared_ptr Open(libutil::Filesystem const *filesystem, std::shared_ptr<Manager> manager, std::shared_ptr<Platform>, std::string const &path);
+    /*
+     * The files an SDK's settings are read from, in order of preference.
+     */
+    static std::vector<std::string> SettingsFileNames(std::string const &path);
+
+public:
+    static Target::shared_ptr Open(libutil::Filesystem const *filesystem, std::shared_ptr<Manager> manager, std::shared_ptr<Platform>, std::string const &path, Cache *cache = nullptr);
 
 private:
     bool parse(plist::Dictionary const *dict);
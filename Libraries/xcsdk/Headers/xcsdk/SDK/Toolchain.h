@@ -21,6 +21,7 @@ namespace plist { class Dictionary; }
 
 namespace xcsdk { namespace SDK {
 
+class Cache;
 class Manager;
 
 class Toolchain {
@@ -99,7 +100,7 @@ public:
     std::vector<std::string> executablePaths() const;
 
 public:
-    static Toolchain::shared_ptr Open(libutil::Filesystem const *filesystem, std::string const &path);
+    static Toolchain::shared_ptr Open(libutil::Filesystem const *filesystem, std::string const &path, Cache *cache = nullptr);
 
 public:
     static std::string DefaultIdentifier(void);
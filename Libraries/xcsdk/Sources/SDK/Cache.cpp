@@ -0,0 +1,285 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <xcsdk/SDK/Cache.h>
+#include <libutil/Filesystem.h>
+#include <libutil/FSUtil.h>
+#include <libutil/Hash.h>
+#include <plist/Array.h>
+#include <plist/Dictionary.h>
+#include <plist/Integer.h>
+#include <plist/String.h>
+#include <plist/Format/Any.h>
+#include <plist/Format/Binary.h>
+#include <process/Context.h>
+#include <process/User.h>
+
+using xcsdk::SDK::Cache;
+using libutil::Filesystem;
+using libutil::FSUtil;
+
+/*
+ * Increment when the cache layout or the parsed representation changes.
+ */
+static int64_t const CacheVersion = 1;
+
+Cache::
+Cache(Filesystem *filesystem, std::string const &path) :
+    _filesystem(filesystem),
+    _path      (path),
+    _modified  (false)
+{
+}
+
+bool Cache::
+load()
+{
+    std::vector<uint8_t> contents;
+    if (!_filesystem->exists(_path) || !_filesystem->read(&contents, _path)) {
+        return false;
+    }
+
+    std::unique_ptr<plist::Object> root = plist::Format::Binary::Deserialize(contents, plist::Format::Binary::Create()).first;
+    auto dict = plist::CastTo <plist::Dictionary> (root.get());
+    if (dict == nullptr) {
+        return false;
+    }
+
+    auto version     = dict->value <plist::Integer> ("Version");
+    auto directories = dict->value <plist::Dictionary> ("Directories");
+    auto files       = dict->value <plist::Dictionary> ("Files");
+    if (version == nullptr || version->value() != CacheVersion || directories == nullptr || files == nullptr) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for (size_t n = 0; n < directories->count(); n++) {
+        auto directory        = directories->value <plist::Dictionary> (n);
+        auto modificationTime = (directory != nullptr ? directory->value <plist::Integer> ("ModificationTime") : nullptr);
+        auto entries          = (directory != nullptr ? directory->value <plist::Array> ("Entries") : nullptr);
+        if (modificationTime == nullptr || entries == nullptr) {
+            continue;
+        }
+
+        Directory cached = { modificationTime->value(), { }, false };
+        for (size_t m = 0; m < entries->count(); m++) {
+            if (auto entry = entries->value <plist::String> (m)) {
+                cached.entries.push_back(entry->value());
+            }
+        }
+        _directories.insert({ directories->key(n), std::move(cached) });
+    }
+
+    for (size_t n = 0; n < files->count(); n++) {
+        auto file             = files->value <plist::Dictionary> (n);
+        auto size             = (file != nullptr ? file->value <plist::Integer> ("Size") : nullptr);
+        auto modificationTime = (file != nullptr ? file->value <plist::Integer> ("ModificationTime") : nullptr);
+        auto fileContents     = (file != nullptr ? file->value <plist::Dictionary> ("Contents") : nullptr);
+        if (size == nullptr || modificationTime == nullptr || fileContents == nullptr) {
+            continue;
+        }
+
+        std::shared_ptr<plist::Dictionary const> copy = fileContents->copy();
+        _files.insert({ files->key(n), { static_cast<uint64_t>(size->value()), modificationTime->value(), copy, false } });
+    }
+
+    return true;
+}
+
+bool Cache::
+store()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (!_modified) {
+        return true;
+    }
+
+    std::unique_ptr<plist::Dictionary> directories = plist::Dictionary::New();
+    for (auto const &entry : _directories) {
+        if (!entry.second.used) {
+            continue;
+        }
+
+        std::unique_ptr<plist::Array> entries = plist::Array::New();
+        for (std::string const &name : entry.second.entries) {
+            entries->append(plist::String::New(name));
+        }
+
+        std::unique_ptr<plist::Dictionary> directory = plist::Dictionary::New();
+        directory->set("ModificationTime", plist::Integer::New(entry.second.modificationTime));
+        directory->set("Entries", std::move(entries));
+        directories->set(entry.first, std::move(directory));
+    }
+
+    std::unique_ptr<plist::Dictionary> files = plist::Dictionary::New();
+    for (auto const &entry : _files) {
+        if (!entry.second.used) {
+            continue;
+        }
+
+        std::unique_ptr<plist::Dictionary> file = plist::Dictionary::New();
+        file->set("Size", plist::Integer::New(static_cast<int64_t>(entry.second.size)));
+        file->set("ModificationTime", plist::Integer::New(entry.second.modificationTime));
+        file->set("Contents", entry.second.contents->copy());
+        files->set(entry.first, std::move(file));
+    }
+
+    std::unique_ptr<plist::Dictionary> root = plist::Dictionary::New();
+    root->set("Version", plist::Integer::New(CacheVersion));
+    root->set("Directories", std::move(directories));
+    root->set("Files", std::move(files));
+
+    auto serialize = plist::Format::Binary::Serialize(root.get(), plist::Format::Binary::Create());
+    if (serialize.first == nullptr) {
+        return false;
+    }
+
+    if (!_filesystem->createDirectory(FSUtil::GetDirectoryName(_path), true)) {
+        return false;
+    }
+
+    if (!_filesystem->write(*serialize.first, _path)) {
+        return false;
+    }
+
+    _modified = false;
+    return true;
+}
+
+bool Cache::
+ReadDirectory(Filesystem const *filesystem, std::string const &path, Cache *cache, std::function<void(std::string const &)> const &cb)
+{
+    /* Without a modification time, there's no way to tell if it changed. */
+    ext::optional<Filesystem::Metadata> metadata;
+    if (cache != nullptr) {
+        metadata = filesystem->metadata(path);
+        if (metadata && (metadata->type != Filesystem::Type::Directory || metadata->modificationTime == 0)) {
+            metadata = ext::nullopt;
+        }
+    }
+
+    if (metadata) {
+        std::vector<std::string> entries;
+        bool found = false;
+
+        {
+            std::lock_guard<std::mutex> lock(cache->_mutex);
+            auto it = cache->_directories.find(path);
+            if (it != cache->_directories.end() && it->second.modificationTime == metadata->modificationTime) {
+                it->second.used = true;
+                entries = it->second.entries;
+                found = true;
+            }
+        }
+
+        if (found) {
+            for (std::string const &entry : entries) {
+                cb(entry);
+            }
+            return true;
+        }
+    }
+
+    std::vector<std::string> entries;
+    if (!filesystem->readDirectory(path, false, [&](std::string const &entry) {
+        entries.push_back(entry);
+    })) {
+        return false;
+    }
+
+    if (metadata) {
+        std::lock_guard<std::mutex> lock(cache->_mutex);
+        cache->_directories[path] = { metadata->modificationTime, entries, true };
+        cache->_modified = true;
+    }
+
+    for (std::string const &entry : entries) {
+        cb(entry);
+    }
+
+    return true;
+}
+
+std::unique_ptr<plist::Dictionary> Cache::
+ReadPropertyList(Filesystem const *filesystem, std::string const &path, Cache *cache)
+{
+    /* Read the metadata first, so a change while reading isn't missed. */
+    ext::optional<Filesystem::Metadata> metadata;
+    if (cache != nullptr) {
+        metadata = filesystem->metadata(path);
+        if (metadata && (metadata->type != Filesystem::Type::File || metadata->modificationTime == 0)) {
+            metadata = ext::nullopt;
+        }
+    }
+
+    if (metadata) {
+        std::shared_ptr<plist::Dictionary const> contents;
+
+        {
+            std::lock_guard<std::mutex> lock(cache->_mutex);
+            auto it = cache->_files.find(path);
+            if (it != cache->_files.end() && it->second.size == metadata->size && it->second.modificationTime == metadata->modificationTime) {
+                it->second.used = true;
+                contents = it->second.contents;
+            }
+        }
+
+        if (contents != nullptr) {
+            return contents->copy();
+        }
+    }
+
+    std::vector<uint8_t> contents;
+    if (!filesystem->read(&contents, path)) {
+        return nullptr;
+    }
+
+    auto result = plist::Format::Any::Deserialize(contents);
+    if (plist::CastTo <plist::Dictionary> (result.first.get()) == nullptr) {
+        return nullptr;
+    }
+
+    std::unique_ptr<plist::Dictionary> dict = std::unique_ptr<plist::Dictionary>(static_cast<plist::Dictionary *>(result.first.release()));
+
+    if (metadata) {
+        std::shared_ptr<plist::Dictionary const> copy = dict->copy();
+
+        std::lock_guard<std::mutex> lock(cache->_mutex);
+        cache->_files[path] = { metadata->size, metadata->modificationTime, copy, true };
+        cache->_modified = true;
+    }
+
+    return dict;
+}
+
+ext::optional<std::string> Cache::
+DefaultDirectory(process::User const *user, process::Context const *processContext)
+{
+    if (ext::optional<std::string> environmentPath = processContext->environmentVariable("XCSDK_CACHE_PATH")) {
+        return *environmentPath;
+    } else if (ext::optional<std::string> homePath = user->userHomeDirectory()) {
+        return *homePath + "/.xcsdk/Cache";
+    } else {
+        return ext::nullopt;
+    }
+}
+
+ext::optional<std::string> Cache::
+DefaultPath(process::User const *user, process::Context const *processContext, std::string const &developerRoot)
+{
+    ext::optional<std::string> directory = DefaultDirectory(user, processContext);
+    if (!directory) {
+        return ext::nullopt;
+    }
+
+    /* Each developer root has its own cache, so switching between them doesn't invalidate it. */
+    std::string hash = libutil::Hash::Data(developerRoot.data(), developerRoot.size()).hex();
+    return *directory + "/" + hash + ".plist";
+}
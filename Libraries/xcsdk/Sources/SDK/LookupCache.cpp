@@ -0,0 +1,293 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <xcsdk/SDK/LookupCache.h>
+#include <xcsdk/SDK/Cache.h>
+#include <xcsdk/SDK/Platform.h>
+#include <xcsdk/SDK/PlatformVersion.h>
+#include <xcsdk/SDK/Product.h>
+#include <xcsdk/SDK/Target.h>
+#include <libutil/FSUtil.h>
+#include <libutil/Hash.h>
+#include <plist/Array.h>
+#include <plist/Dictionary.h>
+#include <plist/Integer.h>
+#include <plist/String.h>
+#include <plist/Format/Binary.h>
+
+using xcsdk::SDK::LookupCache;
+using xcsdk::SDK::Platform;
+using xcsdk::SDK::PlatformVersion;
+using xcsdk::SDK::Product;
+using xcsdk::SDK::Target;
+using libutil::Filesystem;
+using libutil::FSUtil;
+
+/*
+ * Limit the number of lookups kept; old ones are dropped when it's reached.
+ */
+static size_t const LookupCacheLimit = 1024;
+
+LookupCache::
+LookupCache(Filesystem *filesystem, std::string const &path) :
+    _filesystem(filesystem),
+    _path      (path)
+{
+}
+
+static bool
+ReadEntries(Filesystem const *filesystem, std::string const &path, std::function<void(std::string const &, std::vector<std::string> const &, std::vector<LookupCache::Dependency> const &)> const &cb)
+{
+    std::vector<uint8_t> contents;
+    if (!filesystem->exists(path) || !filesystem->read(&contents, path)) {
+        return false;
+    }
+
+    std::unique_ptr<plist::Object> root = plist::Format::Binary::Deserialize(contents, plist::Format::Binary::Create()).first;
+    auto entries = plist::CastTo <plist::Dictionary> (root.get());
+    if (entries == nullptr) {
+        return false;
+    }
+
+    for (size_t n = 0; n < entries->count(); n++) {
+        auto entry        = entries->value <plist::Dictionary> (n);
+        auto values       = (entry != nullptr ? entry->value <plist::Array> ("Values") : nullptr);
+        auto dependencies = (entry != nullptr ? entry->value <plist::Array> ("Dependencies") : nullptr);
+        if (values == nullptr || dependencies == nullptr) {
+            continue;
+        }
+
+        std::vector<std::string> loadedValues;
+        for (size_t m = 0; m < values->count(); m++) {
+            if (auto value = values->value <plist::String> (m)) {
+                loadedValues.push_back(value->value());
+            }
+        }
+
+        std::vector<LookupCache::Dependency> loadedDependencies;
+        for (size_t m = 0; m < dependencies->count(); m++) {
+            auto dependency       = dependencies->value <plist::Dictionary> (m);
+            auto path             = (dependency != nullptr ? dependency->value <plist::String> ("Path") : nullptr);
+            auto size             = (dependency != nullptr ? dependency->value <plist::Integer> ("Size") : nullptr);
+            auto modificationTime = (dependency != nullptr ? dependency->value <plist::Integer> ("ModificationTime") : nullptr);
+            if (path == nullptr) {
+                continue;
+            }
+
+            ext::optional<Filesystem::Metadata> metadata;
+            if (size != nullptr && modificationTime != nullptr) {
+                metadata = Filesystem::Metadata { Filesystem::Type::File, static_cast<uint64_t>(size->value()), modificationTime->value() };
+            }
+            loadedDependencies.push_back({ path->value(), metadata });
+        }
+
+        cb(entries->key(n), loadedValues, loadedDependencies);
+    }
+
+    return true;
+}
+
+bool LookupCache::
+load()
+{
+    return ReadEntries(_filesystem, _path, [&](std::string const &key, std::vector<std::string> const &values, std::vector<Dependency> const &dependencies) {
+        _entries.insert({ key, { values, dependencies } });
+    });
+}
+
+bool LookupCache::
+store()
+{
+    if (_inserted.empty()) {
+        return true;
+    }
+
+    /* Keep what other processes stored since this one loaded. */
+    std::unordered_map<std::string, Entry> merged;
+    ReadEntries(_filesystem, _path, [&](std::string const &key, std::vector<std::string> const &values, std::vector<Dependency> const &dependencies) {
+        if (_inserted.find(key) == _inserted.end()) {
+            merged.insert({ key, { values, dependencies } });
+        }
+    });
+    if (merged.size() + _inserted.size() > LookupCacheLimit) {
+        merged.clear();
+    }
+    for (std::string const &key : _inserted) {
+        merged[key] = _entries[key];
+    }
+
+    std::unique_ptr<plist::Dictionary> entries = plist::Dictionary::New();
+    for (auto const &entry : merged) {
+        std::unique_ptr<plist::Array> values = plist::Array::New();
+        for (std::string const &value : entry.second.values) {
+            values->append(plist::String::New(value));
+        }
+
+        std::unique_ptr<plist::Array> dependencies = plist::Array::New();
+        for (Dependency const &dependency : entry.second.dependencies) {
+            std::unique_ptr<plist::Dictionary> stored = plist::Dictionary::New();
+            stored->set("Path", plist::String::New(dependency.path));
+            if (dependency.metadata) {
+                stored->set("Size", plist::Integer::New(static_cast<int64_t>(dependency.metadata->size)));
+                stored->set("ModificationTime", plist::Integer::New(dependency.metadata->modificationTime));
+            }
+            dependencies->append(std::move(stored));
+        }
+
+        std::unique_ptr<plist::Dictionary> stored = plist::Dictionary::New();
+        stored->set("Values", std::move(values));
+        stored->set("Dependencies", std::move(dependencies));
+        entries->set(entry.first, std::move(stored));
+    }
+
+    auto serialize = plist::Format::Binary::Serialize(entries.get(), plist::Format::Binary::Create());
+    if (serialize.first == nullptr) {
+        return false;
+    }
+
+    if (!_filesystem->createDirectory(FSUtil::GetDirectoryName(_path), true)) {
+        return false;
+    }
+
+    if (!_filesystem->write(*serialize.first, _path)) {
+        return false;
+    }
+
+    _entries = std::move(merged);
+    _inserted.clear();
+    return true;
+}
+
+bool LookupCache::
+remove()
+{
+    _entries.clear();
+    _inserted.clear();
+
+    if (!_filesystem->exists(_path)) {
+        return true;
+    }
+    return _filesystem->removeFile(_path);
+}
+
+ext::optional<std::vector<std::string>> LookupCache::
+find(std::string const &key) const
+{
+    auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        return ext::nullopt;
+    }
+
+    for (Dependency const &stored : it->second.dependencies) {
+        Dependency current = dependency(stored.path);
+        if ((bool)current.metadata != (bool)stored.metadata) {
+            return ext::nullopt;
+        }
+
+        /* Without modification times, changes can't be detected. */
+        if (current.metadata && (current.metadata->modificationTime == 0 || current.metadata->size != stored.metadata->size || current.metadata->modificationTime != stored.metadata->modificationTime)) {
+            return ext::nullopt;
+        }
+    }
+
+    return it->second.values;
+}
+
+void LookupCache::
+insert(std::string const &key, std::vector<std::string> const &values, std::vector<Dependency> const &dependencies)
+{
+    if (_entries.size() >= LookupCacheLimit && _entries.find(key) == _entries.end()) {
+        _entries.clear();
+    }
+
+    _entries[key] = { values, dependencies };
+    _inserted.insert(key);
+}
+
+LookupCache::Dependency LookupCache::
+dependency(std::string const &path) const
+{
+    /* Follow links, so changes to what they point to are seen. */
+    std::string resolved = _filesystem->resolvePath(path);
+    if (resolved.empty()) {
+        return { path, ext::nullopt };
+    }
+
+    ext::optional<Filesystem::Metadata> metadata = _filesystem->metadata(resolved);
+    if (metadata) {
+        metadata->type = Filesystem::Type::File;
+    }
+    return { path, metadata };
+}
+
+std::vector<LookupCache::Dependency> LookupCache::
+searchDependencies(std::vector<std::string> const &searchPaths, std::string const &name) const
+{
+    std::vector<Dependency> dependencies;
+    for (std::string const &searchPath : searchPaths) {
+        /* The name can have directories of its own. */
+        dependencies.push_back(dependency(FSUtil::GetDirectoryName(searchPath + "/" + name)));
+    }
+    return dependencies;
+}
+
+std::vector<LookupCache::Dependency> LookupCache::
+targetDependencies(Target const &target) const
+{
+    std::vector<Dependency> dependencies;
+    dependencies.push_back(dependency(target.path()));
+
+    /* Include unused settings files too, as creating one changes which is read. */
+    for (std::string const &settingsFileName : Target::SettingsFileNames(target.path())) {
+        dependencies.push_back(dependency(settingsFileName));
+    }
+    dependencies.push_back(dependency(Product::SettingsFileName(target.path())));
+
+    if (Platform::shared_ptr platform = target.platform()) {
+        dependencies.push_back(dependency(Platform::SettingsFileName(platform->path())));
+        dependencies.push_back(dependency(PlatformVersion::VersionFileName(platform->path())));
+    }
+
+    return dependencies;
+}
+
+std::unique_ptr<LookupCache> LookupCache::
+Open(Filesystem *filesystem, std::string const &path, bool kill, bool bypass)
+{
+    auto cache = std::unique_ptr<LookupCache>(new LookupCache(filesystem, path));
+    if (kill) {
+        cache->remove();
+    }
+    if (bypass) {
+        return nullptr;
+    }
+
+    cache->load();
+    return cache;
+}
+
+std::string LookupCache::
+Key(std::vector<std::string> const &components)
+{
+    libutil::Hash hash;
+    for (std::string const &component : components) {
+        hash.update(component);
+    }
+    return hash.digest().hex();
+}
+
+ext::optional<std::string> LookupCache::
+DefaultPath(process::User const *user, process::Context const *processContext)
+{
+    ext::optional<std::string> directory = Cache::DefaultDirectory(user, processContext);
+    if (!directory) {
+        return ext::nullopt;
+    }
+
+    return *directory + "/xcrun_db";
+}
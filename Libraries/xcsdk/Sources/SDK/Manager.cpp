@@ -7,8 +7,10 @@
  */
 
 #include <xcsdk/SDK/Manager.h>
+#include <xcsdk/SDK/Cache.h>
 #include <xcsdk/Configuration.h>
 #include <libutil/FSUtil.h>
+#include <libutil/Parallel.h>
 #include <pbxsetting/Setting.h>
 #include <pbxsetting/Type.h>
 
@@ -16,15 +18,18 @@
 #include <iostream>
 
 using xcsdk::Configuration;
+using xcsdk::SDK::Cache;
 using xcsdk::SDK::Manager;
 using xcsdk::SDK::Platform;
 using xcsdk::SDK::Target;
 using xcsdk::SDK::Toolchain;
 using libutil::Filesystem;
 using libutil::FSUtil;
+using libutil::Parallel;
 
 Manager::
-Manager()
+Manager() :
+    _lazy(false)
 {
 }
 
@@ -46,23 +51,117 @@ _resolvePath(Filesystem const *filesystem, std::string const &name)
     return name;
 }
 
+template<typename T>
+static T
+FindIndexed(
+    std::unordered_map<std::string, std::pair<size_t, T>> const &names,
+    std::unordered_map<std::string, std::pair<size_t, T>> const &paths,
+    Filesystem const *filesystem,
+    std::string const &name)
+{
+    auto nameIt = names.find(name);
+
+    /* Only something that looks like a path could match a path. */
+    auto pathIt = paths.end();
+    if (name.find('/') != std::string::npos) {
+        pathIt = paths.find(_resolvePath(filesystem, name));
+    }
+
+    if (nameIt != names.end() && (pathIt == paths.end() || nameIt->second.first <= pathIt->second.first)) {
+        return nameIt->second.second;
+    } else if (pathIt != paths.end()) {
+        return pathIt->second.second;
+    } else {
+        return nullptr;
+    }
+}
+
+static Target::shared_ptr
+FindPlatformTarget(Platform::shared_ptr const &platform, std::string const &name, std::string const &pathFromName)
+{
+    for (Target::shared_ptr const &target : platform->targets()) {
+        /* Try both the name and the path; either are valid. */
+        if (target->canonicalName() == name || target->path() == pathFromName) {
+            return target;
+        }
+    }
+
+    /* If the platform name matches but no targets do, use any target. */
+    if (platform->name() == name || platform->path() == pathFromName) {
+        if (!platform->targets().empty()) {
+            return platform->targets().back();
+        }
+    }
+
+    return nullptr;
+}
+
+static std::string
+Lowercase(std::string string)
+{
+    std::transform(string.begin(), string.end(), string.begin(), ::tolower);
+    return string;
+}
+
+static bool
+LikelyPlatform(Platform::shared_ptr const &platform, std::string const &name, std::string const &pathFromName)
+{
+    if (platform->name() == name || platform->path() == pathFromName) {
+        return true;
+    }
+
+    /* The SDK is inside the platform. */
+    std::string prefix = platform->path() + "/";
+    if (pathFromName.compare(0, prefix.size(), prefix) == 0) {
+        return true;
+    }
+
+    /* Canonical names usually start with the platform name, or match the SDK's directory. */
+    std::string lowercase = Lowercase(name);
+    if (lowercase.compare(0, platform->name().size(), platform->name()) == 0) {
+        return true;
+    }
+
+    for (std::string const &targetPath : platform->targetPaths()) {
+        if (Lowercase(FSUtil::GetBaseNameWithoutExtension(targetPath)) == lowercase) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 Target::shared_ptr Manager::
 findTarget(Filesystem const *filesystem, std::string const &name) const
 {
-    std::string pathFromName = _resolvePath(filesystem, name);
+    if (!_lazy) {
+        return FindIndexed(_targetNames, _targetPaths, filesystem, name);
+    }
+
+    std::string pathFromName = name;
+    if (name.find('/') != std::string::npos) {
+        pathFromName = _resolvePath(filesystem, name);
+    }
+
+    /*
+     * Load the platforms that probably have the SDK first, together. Then
+     * search in platform order, so the same SDK is found as when not lazy;
+     * platforms after the match don't need to load their SDKs.
+     */
+    std::vector<Platform::shared_ptr> likely;
     for (Platform::shared_ptr const &platform : _platforms) {
-        for (Target::shared_ptr const &target : platform->targets()) {
-            /* Try both the name and the path; either are valid. */
-            if (target->canonicalName() == name || target->path() == pathFromName) {
-                return target;
-            }
+        if (LikelyPlatform(platform, name, pathFromName)) {
+            likely.push_back(platform);
         }
+    }
 
-        /* If the platform name matches but no targets do, use any target. */
-        if (platform->name() == name || platform->path() == pathFromName) {
-            if (!platform->targets().empty()) {
-                return platform->targets().back();
-            }
+    Parallel::ForEach(likely.size(), [&](size_t n) {
+        (void)likely[n]->targets();
+    });
+
+    for (Platform::shared_ptr const &platform : _platforms) {
+        if (Target::shared_ptr target = FindPlatformTarget(platform, name, pathFromName)) {
+            return target;
         }
     }
 
@@ -72,15 +171,7 @@ findTarget(Filesystem const *filesystem, std::string const &name) const
 Toolchain::shared_ptr Manager::
 findToolchain(Filesystem const *filesystem, std::string const &name) const
 {
-    std::string pathFromName = _resolvePath(filesystem, name);
-    for (Toolchain::shared_ptr const &toolchain : _toolchains) {
-        /* Match liberally: name, identifier, or path; all are valid. */
-        if (toolchain->name() == name || toolchain->identifier() == name || toolchain->path() == pathFromName) {
-            return toolchain;
-        }
-    }
-
-    return nullptr;
+    return FindIndexed(_toolchainNames, _toolchainPaths, filesystem, name);
 }
 
 std::vector<Platform::shared_ptr> Manager::
@@ -167,7 +258,7 @@ executablePaths(Platform::shared_ptr const &platform, Target::shared_ptr const &
 }
 
 std::shared_ptr<Manager> Manager::
-Open(Filesystem const *filesystem, std::string const &path, ext::optional<Configuration> const &configuration)
+Open(Filesystem const *filesystem, std::string const &path, ext::optional<Configuration> const &configuration, Cache *cache, bool lazy)
 {
     if (path.empty()) {
         fprintf(stderr, "error: empty path for sdk manager\n");
@@ -176,6 +267,7 @@ Open(Filesystem const *filesystem, std::string const &path, ext::optional<Config
 
     auto manager = std::make_shared <Manager> ();
     manager->_path = path;
+    manager->_lazy = lazy;
 
     std::vector<std::string> toolchainsPaths = { path + "/" + "Toolchains" };
     if (configuration) {
@@ -183,46 +275,102 @@ Open(Filesystem const *filesystem, std::string const &path, ext::optional<Config
         toolchainsPaths.insert(toolchainsPaths.end(), extraToolchainsPaths.begin(), extraToolchainsPaths.end());
     }
 
-    std::vector<std::shared_ptr<Toolchain>> toolchains;
+    /*
+     * Each toolchain and platform opens independently, so open them in
+     * parallel; most of the time goes to reading their property lists.
+     */
+    std::vector<std::string> toolchainPaths;
     for (std::string const &toolchainsPath : toolchainsPaths) {
-        filesystem->readDirectory(toolchainsPath, false, [&](std::string const &filename) -> void {
+        Cache::ReadDirectory(filesystem, toolchainsPath, cache, [&](std::string const &filename) -> void {
             if (FSUtil::GetFileExtension(filename) != "xctoolchain") {
                 return;
             }
 
-            auto path = _resolvePath(filesystem, toolchainsPath + "/" + filename);
-            auto toolchain = SDK::Toolchain::Open(filesystem, path);
-            if (toolchain != nullptr) {
-                toolchains.push_back(toolchain);
-            }
+            toolchainPaths.push_back(_resolvePath(filesystem, toolchainsPath + "/" + filename));
         });
     }
+
+    std::vector<std::shared_ptr<Toolchain>> toolchainResults = std::vector<std::shared_ptr<Toolchain>>(toolchainPaths.size());
+    Parallel::ForEach(toolchainPaths.size(), [&](size_t n) {
+        toolchainResults[n] = SDK::Toolchain::Open(filesystem, toolchainPaths[n], cache);
+    });
+
+    std::vector<std::shared_ptr<Toolchain>> toolchains;
+    for (std::shared_ptr<Toolchain> const &toolchain : toolchainResults) {
+        if (toolchain != nullptr) {
+            toolchains.push_back(toolchain);
+        }
+    }
     manager->_toolchains = toolchains;
 
+    /* Match liberally: name, identifier, or path; all are valid. */
+    for (size_t n = 0; n < toolchains.size(); n++) {
+        Toolchain::shared_ptr const &toolchain = toolchains[n];
+        manager->_toolchainNames.insert({ toolchain->name(), { n, toolchain } });
+        if (toolchain->identifier()) {
+            manager->_toolchainNames.insert({ *toolchain->identifier(), { n, toolchain } });
+        }
+        manager->_toolchainPaths.insert({ toolchain->path(), { n, toolchain } });
+    }
+
     std::vector<std::string> platformsPaths = { path + "/" + "Platforms" };
     if (configuration) {
         std::vector<std::string> const &extraPlatformsPaths = configuration->extraPlatformsPaths();
         platformsPaths.insert(platformsPaths.end(), extraPlatformsPaths.begin(), extraPlatformsPaths.end());
     }
 
-    std::vector<std::shared_ptr<Platform>> platforms;
+    /* Platforms find their SDKs' toolchains, so open them after the toolchains. */
+    std::vector<std::string> platformPaths;
     for (std::string const &platformsPath : platformsPaths) {
-        filesystem->readDirectory(platformsPath, false, [&](std::string const &filename) -> void {
+        Cache::ReadDirectory(filesystem, platformsPath, cache, [&](std::string const &filename) -> void {
             if (FSUtil::GetFileExtension(filename) != "platform") {
                 return;
             }
 
-            auto path = _resolvePath(filesystem, platformsPath + "/" + filename);
-            auto platform = SDK::Platform::Open(filesystem, manager, path);
-            if (platform != nullptr) {
-                platforms.push_back(platform);
-            }
+            platformPaths.push_back(_resolvePath(filesystem, platformsPath + "/" + filename));
         });
     }
+
+    std::vector<std::shared_ptr<Platform>> platformResults = std::vector<std::shared_ptr<Platform>>(platformPaths.size());
+    Parallel::ForEach(platformPaths.size(), [&](size_t n) {
+        platformResults[n] = SDK::Platform::Open(filesystem, manager, platformPaths[n], cache, lazy);
+    });
+
+    std::vector<std::shared_ptr<Platform>> platforms;
+    for (std::shared_ptr<Platform> const &platform : platformResults) {
+        if (platform != nullptr) {
+            platforms.push_back(platform);
+        }
+    }
     std::sort(platforms.begin(), platforms.end(), [](Platform::shared_ptr const &a, Platform::shared_ptr const &b) -> bool {
         return (a->description() < b->description());
     });
     manager->_platforms = platforms;
 
+    /* Lazy platforms are searched directly, to avoid loading their SDKs. */
+    if (lazy) {
+        return manager;
+    }
+
+    /* Earlier entries take precedence, in the order a linear search would try them. */
+    size_t order = 0;
+    for (Platform::shared_ptr const &platform : platforms) {
+        for (Target::shared_ptr const &target : platform->targets()) {
+            /* Try both the name and the path; either are valid. */
+            if (target->canonicalName()) {
+                manager->_targetNames.insert({ *target->canonicalName(), { order, target } });
+            }
+            manager->_targetPaths.insert({ target->path(), { order, target } });
+            order++;
+        }
+
+        /* If the platform name matches but no targets do, use any target. */
+        if (!platform->targets().empty()) {
+            manager->_targetNames.insert({ platform->name(), { order, platform->targets().back() } });
+            manager->_targetPaths.insert({ platform->path(), { order, platform->targets().back() } });
+            order++;
+        }
+    }
+
     return manager;
 }
@@ -7,27 +7,31 @@
  */
 
 #include <xcsdk/SDK/Platform.h>
+#include <xcsdk/SDK/Cache.h>
 #include <xcsdk/SDK/Manager.h>
 #include <pbxsetting/Type.h>
 #include <libutil/Filesystem.h>
 #include <libutil/FSUtil.h>
+#include <libutil/Parallel.h>
 #include <plist/Array.h>
 #include <plist/Boolean.h>
 #include <plist/Dictionary.h>
 #include <plist/String.h>
-#include <plist/Format/Any.h>
 #include <plist/Keys/Unpack.h>
 
 #include <algorithm>
 
 using xcsdk::SDK::Platform;
+using xcsdk::SDK::Cache;
 using xcsdk::SDK::Manager;
 using xcsdk::SDK::Target;
 using libutil::Filesystem;
 using libutil::FSUtil;
+using libutil::Parallel;
 
 Platform::
 Platform() :
+    _filesystem             (nullptr),
     _defaultDebuggerSettings(nullptr)
 {
 }
@@ -150,6 +154,39 @@ settings() const
     return pbxsetting::Level(settings);
 }
 
+std::vector<Target::shared_ptr> const &Platform::
+targets() const
+{
+    std::call_once(_targetsLoaded, [this] {
+        loadTargets(nullptr);
+    });
+
+    return _targets;
+}
+
+void Platform::
+loadTargets(Cache *cache) const
+{
+    Platform::shared_ptr platform = std::const_pointer_cast<Platform>(shared_from_this());
+    std::shared_ptr<Manager> manager = _manager.lock();
+
+    /* Each SDK opens independently, so open them in parallel. */
+    std::vector<Target::shared_ptr> results = std::vector<Target::shared_ptr>(_targetPaths.size());
+    Parallel::ForEach(_targetPaths.size(), [&](size_t n) {
+        results[n] = Target::Open(_filesystem, manager, platform, _targetPaths[n], cache);
+    });
+
+    for (Target::shared_ptr const &target : results) {
+        if (target != nullptr) {
+            _targets.push_back(target);
+        }
+    }
+
+    std::sort(_targets.begin(), _targets.end(), [](Target::shared_ptr const &a, Target::shared_ptr const &b) -> bool {
+        return (a->canonicalName() < b->canonicalName());
+    });
+}
+
 std::vector<std::string> Platform::
 executablePaths() const
 {
@@ -164,7 +201,7 @@ executablePaths() const
 bool Platform::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("Platform", dict, &seen);
 
     auto I   = unpack.cast <plist::String> ("Identifier");
@@ -298,8 +335,14 @@ parse(plist::Dictionary const *dict)
     return true;
 }
 
+std::string Platform::
+SettingsFileName(std::string const &path)
+{
+    return path + "/Info.plist";
+}
+
 Platform::shared_ptr Platform::
-Open(Filesystem const *filesystem, std::shared_ptr<Manager> manager, std::string const &path)
+Open(Filesystem const *filesystem, std::shared_ptr<Manager> manager, std::string const &path, Cache *cache, bool lazy)
 {
     if (path.empty()) {
         return nullptr;
@@ -308,7 +351,7 @@ Open(Filesystem const *filesystem, std::shared_ptr<Manager> manager, std::string
     /*
      * Load platform info.
      */
-    std::string settingsFileName = path + "/Info.plist";
+    std::string settingsFileName = SettingsFileName(path);
     if (!filesystem->isReadable(settingsFileName)) {
         return nullptr;
     }
@@ -318,20 +361,10 @@ Open(Filesystem const *filesystem, std::shared_ptr<Manager> manager, std::string
         return nullptr;
     }
 
-    std::vector<uint8_t> contents;
-    if (!filesystem->read(&contents, settingsFileName)) {
-        return nullptr;
-    }
-
     /*
      * Parse platform info property list.
      */
-    auto result = plist::Format::Any::Deserialize(contents);
-    if (result.first == nullptr) {
-        return nullptr;
-    }
-
-    plist::Dictionary *plist = plist::CastTo<plist::Dictionary>(result.first.get());
+    std::unique_ptr<plist::Dictionary> plist = Cache::ReadPropertyList(filesystem, settingsFileName, cache);
     if (plist == nullptr) {
         return nullptr;
     }
@@ -346,32 +379,33 @@ Open(Filesystem const *filesystem, std::shared_ptr<Manager> manager, std::string
     /*
      * Parse platform info dictionary.
      */
-    if (!platform->parse(plist)) {
+    if (!platform->parse(plist.get())) {
         return nullptr;
     }
 
     /*
      * Load platform version information.
      */
-    platform->_platformVersion = PlatformVersion::Open(filesystem, platform->_path);
+    platform->_platformVersion = PlatformVersion::Open(filesystem, platform->_path, cache);
 
     /*
-     * Load all the SDKs inside the platform.
+     * Find all the SDKs inside the platform, loading them now unless lazy.
      */
     std::string sdksPath = platform->_path + "/Developer/SDKs";
-    filesystem->readDirectory(sdksPath, false, [&](std::string const &filename) -> void {
+    Cache::ReadDirectory(filesystem, sdksPath, cache, [&](std::string const &filename) -> void {
         if (FSUtil::GetFileExtension(filename) != "sdk") {
             return;
         }
 
-        if (auto target = Target::Open(filesystem, manager, platform, sdksPath + "/" + filename)) {
-            platform->_targets.push_back(target);
-        }
+        platform->_targetPaths.push_back(sdksPath + "/" + filename);
     });
 
-    std::sort(platform->_targets.begin(), platform->_targets.end(), [](Target::shared_ptr const &a, Target::shared_ptr const &b) -> bool {
-        return (a->canonicalName() < b->canonicalName());
-    });
+    platform->_filesystem = filesystem;
+    if (!lazy) {
+        std::call_once(platform->_targetsLoaded, [&] {
+            platform->loadTargets(cache);
+        });
+    }
 
     return platform;
 }
@@ -7,13 +7,14 @@
  */
 
 #include <xcsdk/SDK/PlatformVersion.h>
+#include <xcsdk/SDK/Cache.h>
 #include <libutil/Filesystem.h>
 #include <plist/Dictionary.h>
 #include <plist/String.h>
-#include <plist/Format/Any.h>
 #include <plist/Keys/Unpack.h>
 
 using xcsdk::SDK::PlatformVersion;
+using xcsdk::SDK::Cache;
 using libutil::Filesystem;
 
 PlatformVersion::
@@ -24,7 +25,7 @@ PlatformVersion()
 bool PlatformVersion::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("PlatformVersion", dict, &seen);
 
     auto PN     = unpack.cast <plist::String> ("ProjectName");
@@ -65,8 +66,14 @@ parse(plist::Dictionary const *dict)
     return true;
 }
 
+std::string PlatformVersion::
+VersionFileName(std::string const &path)
+{
+    return path + "/version.plist";
+}
+
 PlatformVersion::shared_ptr PlatformVersion::
-Open(Filesystem const *filesystem, std::string const &path)
+Open(Filesystem const *filesystem, std::string const &path, Cache *cache)
 {
     if (path.empty()) {
         return nullptr;
@@ -75,7 +82,7 @@ Open(Filesystem const *filesystem, std::string const &path)
     /*
      * Read version info.
      */
-    std::string versionFileName = path + "/version.plist";
+    std::string versionFileName = VersionFileName(path);
     if (!filesystem->isReadable(versionFileName)) {
         return nullptr;
     }
@@ -85,20 +92,10 @@ Open(Filesystem const *filesystem, std::string const &path)
         return nullptr;
     }
 
-    std::vector<uint8_t> contents;
-    if (!filesystem->read(&contents, versionFileName)) {
-        return nullptr;
-    }
-
     /*
      * Parse property list.
      */
-    auto result = plist::Format::Any::Deserialize(contents);
-    if (result.first == nullptr) {
-        return nullptr;
-    }
-
-    plist::Dictionary *plist = plist::CastTo<plist::Dictionary>(result.first.get());
+    std::unique_ptr<plist::Dictionary> plist = Cache::ReadPropertyList(filesystem, versionFileName, cache);
     if (plist == nullptr) {
         return nullptr;
     }
@@ -107,7 +104,7 @@ Open(Filesystem const *filesystem, std::string const &path)
      * Parse the version dictionary and create the object.
      */
     auto platformVersion = std::make_shared<PlatformVersion>();
-    if (!platformVersion->parse(plist)) {
+    if (!platformVersion->parse(plist.get())) {
         return nullptr;
     }
 
@@ -7,13 +7,14 @@
  */
 
 #include <xcsdk/SDK/Product.h>
+#include <xcsdk/SDK/Cache.h>
 #include <libutil/Filesystem.h>
 #include <plist/Dictionary.h>
 #include <plist/String.h>
-#include <plist/Format/Any.h>
 #include <plist/Keys/Unpack.h>
 
 using xcsdk::SDK::Product;
+using xcsdk::SDK::Cache;
 using libutil::Filesystem;
 
 Product::
@@ -24,7 +25,7 @@ Product()
 bool Product::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("Product", dict, &seen);
 
     auto PN   = unpack.cast <plist::String> ("ProductName");
@@ -60,8 +61,14 @@ parse(plist::Dictionary const *dict)
     return true;
 }
 
+std::string Product::
+SettingsFileName(std::string const &path)
+{
+    return path + "/System/Library/CoreServices/SystemVersion.plist";
+}
+
 Product::shared_ptr Product::
-Open(Filesystem const *filesystem, std::string const &path)
+Open(Filesystem const *filesystem, std::string const &path, Cache *cache)
 {
     if (path.empty()) {
         return nullptr;
@@ -70,7 +77,7 @@ Open(Filesystem const *filesystem, std::string const &path)
     /*
      * Load information.
      */
-    std::string settingsFileName = path + "/System/Library/CoreServices/SystemVersion.plist";
+    std::string settingsFileName = SettingsFileName(path);
     if (!filesystem->isReadable(settingsFileName)) {
         return nullptr;
     }
@@ -80,20 +87,10 @@ Open(Filesystem const *filesystem, std::string const &path)
         return nullptr;
     }
 
-    std::vector<uint8_t> contents;
-    if (!filesystem->read(&contents, settingsFileName)) {
-        return nullptr;
-    }
-
     /*
      * Parse property list.
      */
-    auto result = plist::Format::Any::Deserialize(contents);
-    if (result.first == nullptr) {
-        return nullptr;
-    }
-
-    plist::Dictionary *plist = plist::CastTo<plist::Dictionary>(result.first.get());
+    std::unique_ptr<plist::Dictionary> plist = Cache::ReadPropertyList(filesystem, settingsFileName, cache);
     if (plist == nullptr) {
         return nullptr;
     }
@@ -102,7 +99,7 @@ Open(Filesystem const *filesystem, std::string const &path)
      * Parse the dictionary and create the object.
      */
     auto product = std::make_shared <Product> ();
-    if (!product->parse(plist)) {
+    if (!product->parse(plist.get())) {
         return nullptr;
     }
 
@@ -7,18 +7,19 @@
  */
 
 #include <xcsdk/SDK/Target.h>
+#include <xcsdk/SDK/Cache.h>
 #include <xcsdk/SDK/Manager.h>
 #include <pbxsetting/Type.h>
 #include <plist/Array.h>
 #include <plist/Boolean.h>
 #include <plist/Dictionary.h>
 #include <plist/String.h>
-#include <plist/Format/Any.h>
 #include <plist/Keys/Unpack.h>
 #include <libutil/Filesystem.h>
 #include <libutil/FSUtil.h>
 
 using xcsdk::SDK::Target;
+using xcsdk::SDK::Cache;
 using xcsdk::SDK::Manager;
 using xcsdk::SDK::Platform;
 using libutil::Filesystem;
@@ -64,7 +65,7 @@ executablePaths() const
 bool Target::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("Target", dict, &seen);
 
     auto Ts    = unpack.cast <plist::Array> ("Toolchains");
@@ -199,8 +200,14 @@ parse(plist::Dictionary const *dict)
     return true;
 }
 
+std::vector<std::string> Target::
+SettingsFileNames(std::string const &path)
+{
+    return { path + "/SDKSettings.plist", path + "/Info.plist" };
+}
+
 Target::shared_ptr Target::
-Open(Filesystem const *filesystem, std::shared_ptr<Manager> manager, std::shared_ptr<Platform> platform, std::string const &path)
+Open(Filesystem const *filesystem, std::shared_ptr<Manager> manager, std::shared_ptr<Platform> platform, std::string const &path, Cache *cache)
 {
     if (path.empty()) {
         return nullptr;
@@ -209,33 +216,26 @@ Open(Filesystem const *filesystem, std::shared_ptr<Manager> manager, std::shared
     /*
      * Load target settings.
      */
-    std::string settingsFileName = path + "/SDKSettings.plist";
-    if (!filesystem->isReadable(settingsFileName.c_str())) {
-        settingsFileName = path + "/Info.plist";
-        if (!filesystem->isReadable(settingsFileName.c_str())) {
-            return nullptr;
+    std::string settingsFileName;
+    for (std::string const &fileName : SettingsFileNames(path)) {
+        if (filesystem->isReadable(fileName)) {
+            settingsFileName = fileName;
+            break;
         }
     }
-
-    std::string realPath = filesystem->resolvePath(settingsFileName);
-    if (realPath.empty()) {
+    if (settingsFileName.empty()) {
         return nullptr;
     }
 
-    std::vector<uint8_t> contents;
-    if (!filesystem->read(&contents, settingsFileName)) {
+    std::string realPath = filesystem->resolvePath(settingsFileName);
+    if (realPath.empty()) {
         return nullptr;
     }
 
     /*
      * Parse settings property list.
      */
-    auto result = plist::Format::Any::Deserialize(contents);
-    if (result.first == nullptr) {
-        return nullptr;
-    }
-
-    plist::Dictionary *plist = plist::CastTo<plist::Dictionary>(result.first.get());
+    std::unique_ptr<plist::Dictionary> plist = Cache::ReadPropertyList(filesystem, settingsFileName, cache);
     if (plist == nullptr) {
         return nullptr;
     }
@@ -252,14 +252,14 @@ Open(Filesystem const *filesystem, std::shared_ptr<Manager> manager, std::shared
     /*
      * Parse the settings dictionary.
      */
-    if (!target->parse(plist)) {
+    if (!target->parse(plist.get())) {
         return nullptr;
     }
 
     /*
      * Parse product information.
      */
-    target->_product = Product::Open(filesystem, target->_path);
+    target->_product = Product::Open(filesystem, target->_path, cache);
 
     return target;
 }
@@ -7,6 +7,7 @@
  */
 
 #include <xcsdk/SDK/Toolchain.h>
+#include <xcsdk/SDK/Cache.h>
 #include <libutil/Filesystem.h>
 #include <libutil/FSUtil.h>
 #include <plist/Array.h>
@@ -15,9 +16,9 @@
 #include <plist/Integer.h>
 #include <plist/String.h>
 #include <plist/Keys/Unpack.h>
-#include <plist/Format/Any.h>
 
 using xcsdk::SDK::Toolchain;
+using xcsdk::SDK::Cache;
 using libutil::Filesystem;
 using libutil::FSUtil;
 
@@ -43,7 +44,7 @@ executablePaths() const
 bool Toolchain::
 parse(plist::Dictionary const *dict)
 {
-    std::unordered_set<std::string> seen;
+    plist::Keys::Seen seen;
     auto unpack = plist::Keys::Unpack("Toolchain", dict, &seen);
 
     auto I    = unpack.cast <plist::String> ("Identifier");
@@ -133,7 +134,7 @@ parse(plist::Dictionary const *dict)
 }
 
 Toolchain::shared_ptr Toolchain::
-Open(Filesystem const *filesystem, std::string const &path)
+Open(Filesystem const *filesystem, std::string const &path, Cache *cache)
 {
     if (path.empty()) {
         return nullptr;
@@ -155,20 +156,10 @@ Open(Filesystem const *filesystem, std::string const &path)
         return nullptr;
     }
 
-    std::vector<uint8_t> contents;
-    if (!filesystem->read(&contents, settingsFileName)) {
-        return nullptr;
-    }
-
     /*
      * Parse property list.
      */
-    auto result = plist::Format::Any::Deserialize(contents);
-    if (result.first == nullptr) {
-        return nullptr;
-    }
-
-    plist::Dictionary *plist = plist::CastTo<plist::Dictionary>(result.first.get());
+    std::unique_ptr<plist::Dictionary> plist = Cache::ReadPropertyList(filesystem, settingsFileName, cache);
     if (plist == nullptr) {
         return nullptr;
     }
@@ -183,7 +174,7 @@ Open(Filesystem const *filesystem, std::string const &path)
     /*
      * Parse the toolchain dictionary.
      */
-    if (!toolchain->parse(plist)) {
+    if (!toolchain->parse(plist.get())) {
         return nullptr;
     }
 
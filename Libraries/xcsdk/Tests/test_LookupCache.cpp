@@ -0,0 +1,235 @@
+/**
+ Copyright (c) 2015-present, Facebook, Inc.
+ All rights reserved.
+
+ This source code is licensed under the BSD-style license found in the
+ LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <xcsdk/SDK/LookupCache.h>
+#include <xcsdk/SDK/Platform.h>
+#include <xcsdk/SDK/Target.h>
+#include <libutil/DefaultFilesystem.h>
+
+#include <fcntl.h>
+#include <ftw.h>
+#include <sys/stat.h>
+
+using xcsdk::SDK::LookupCache;
+using libutil::DefaultFilesystem;
+
+static void
+WriteFile(std::string const &path, std::string const &contents)
+{
+    FILE *fp = fopen(path.c_str(), "wb");
+    ASSERT_NE(fp, nullptr);
+    fwrite(contents.data(), 1, contents.size(), fp);
+    fclose(fp);
+}
+
+static void
+SetOldModificationTime(std::string const &path)
+{
+    /* So a change made right after is seen even with coarse timestamps. */
+    struct timespec times[2] = { { 1000000000, 0 }, { 1000000000, 0 } };
+    ASSERT_EQ(0, utimensat(AT_FDCWD, path.c_str(), times, 0));
+}
+
+static std::string
+TemporaryDirectory()
+{
+    char root[] = "/tmp/xcsdk-lookup-XXXXXX";
+    EXPECT_NE(mkdtemp(root), nullptr);
+    return root;
+}
+
+static void
+RemoveDirectory(std::string const &path)
+{
+    nftw(path.c_str(), [](char const *entry, struct stat const *, int, struct FTW *) -> int {
+        return remove(entry);
+    }, 16, FTW_DEPTH | FTW_PHYS);
+}
+
+TEST(LookupCache, Hit)
+{
+    std::string path = TemporaryDirectory();
+    DefaultFilesystem filesystem;
+    WriteFile(path + "/SDKSettings.plist", "{ CanonicalName = test1.0; }");
+    SetOldModificationTime(path + "/SDKSettings.plist");
+
+    std::string key = LookupCache::Key({ "sdk", "path", path });
+    EXPECT_EQ(key, LookupCache::Key({ "sdk", "path", path }));
+    EXPECT_NE(key, LookupCache::Key({ "sdk", "version", path }));
+
+    LookupCache cache(&filesystem, path + "/Cache/xcrun_db");
+    EXPECT_FALSE(cache.load());
+    EXPECT_FALSE(cache.find(key));
+    cache.insert(key, { path }, { cache.dependency(path + "/SDKSettings.plist") });
+    ASSERT_TRUE(cache.store());
+
+    LookupCache loaded(&filesystem, cache.path());
+    EXPECT_TRUE(loaded.load());
+    ext::optional<std::vector<std::string>> values = loaded.find(key);
+    ASSERT_TRUE(values);
+    EXPECT_EQ(std::vector<std::string>({ path }), *values);
+
+    /* A changed dependency invalidates the entry. */
+    WriteFile(path + "/SDKSettings.plist", "{ CanonicalName = test2.0; }");
+    EXPECT_FALSE(loaded.find(key));
+
+    RemoveDirectory(path);
+}
+
+TEST(LookupCache, MissingDependency)
+{
+    std::string path = TemporaryDirectory();
+    DefaultFilesystem filesystem;
+
+    /* A dependency that didn't exist is invalidated by creating it. */
+    LookupCache cache(&filesystem, path + "/xcrun_db");
+    cache.insert("key", { "value" }, { cache.dependency(path + "/missing") });
+    EXPECT_TRUE(cache.find("key"));
+
+    WriteFile(path + "/missing", "");
+    EXPECT_FALSE(cache.find("key"));
+
+    RemoveDirectory(path);
+}
+
+TEST(LookupCache, SearchDirectoryGainsTool)
+{
+    std::string path = TemporaryDirectory();
+    DefaultFilesystem filesystem;
+    ASSERT_TRUE(filesystem.createDirectory(path + "/first", false));
+    ASSERT_TRUE(filesystem.createDirectory(path + "/second", false));
+    WriteFile(path + "/second/tool", "");
+    SetOldModificationTime(path + "/first");
+    SetOldModificationTime(path + "/second");
+    SetOldModificationTime(path + "/second/tool");
+
+    LookupCache cache(&filesystem, path + "/xcrun_db");
+    std::vector<LookupCache::Dependency> dependencies = cache.searchDependencies({ path + "/first", path + "/second" }, "tool");
+    ASSERT_EQ(2, dependencies.size());
+    EXPECT_EQ(path + "/first", dependencies[0].path);
+    dependencies.push_back(cache.dependency(path + "/second/tool"));
+    cache.insert("tool", { path + "/second/tool" }, dependencies);
+    ASSERT_TRUE(cache.store());
+
+    LookupCache loaded(&filesystem, cache.path());
+    EXPECT_TRUE(loaded.load());
+    EXPECT_TRUE(loaded.find("tool"));
+
+    /* An earlier search directory now has the tool, so it would be found there. */
+    WriteFile(path + "/first/tool", "");
+    EXPECT_FALSE(loaded.find("tool"));
+
+    RemoveDirectory(path);
+}
+
+TEST(LookupCache, TargetDependencies)
+{
+    std::string path = TemporaryDirectory();
+    DefaultFilesystem filesystem;
+    std::string platformPath = path + "/Test.platform";
+    std::string sdkPath = platformPath + "/Developer/SDKs/Test1.0.sdk";
+    ASSERT_TRUE(filesystem.createDirectory(sdkPath + "/System/Library/CoreServices", true));
+    WriteFile(platformPath + "/Info.plist", "{ Identifier = test; Name = test; Version = 1; }");
+    WriteFile(sdkPath + "/SDKSettings.plist", "{ CanonicalName = test1.0; Version = 1.0; }");
+    WriteFile(sdkPath + "/System/Library/CoreServices/SystemVersion.plist", "{ ProductBuildVersion = 1A1; }");
+    SetOldModificationTime(platformPath + "/Info.plist");
+    SetOldModificationTime(sdkPath + "/SDKSettings.plist");
+    SetOldModificationTime(sdkPath + "/System/Library/CoreServices/SystemVersion.plist");
+
+    xcsdk::SDK::Platform::shared_ptr platform = xcsdk::SDK::Platform::Open(&filesystem, nullptr, platformPath);
+    ASSERT_NE(nullptr, platform);
+    ASSERT_EQ(1, platform->targets().size());
+    xcsdk::SDK::Target::shared_ptr target = platform->targets().front();
+    ASSERT_NE(nullptr, target->product());
+
+    /* Changing any file an SDK value is read from invalidates the entry. */
+    LookupCache cache(&filesystem, path + "/xcrun_db");
+    for (std::string const &file : std::vector<std::string>({
+        sdkPath + "/SDKSettings.plist",
+        sdkPath + "/System/Library/CoreServices/SystemVersion.plist",
+        platformPath + "/Info.plist",
+        platformPath + "/version.plist",
+    })) {
+        cache.insert("sdk", { "1A1" }, cache.targetDependencies(*target));
+        EXPECT_TRUE(cache.find("sdk"));
+
+        WriteFile(file, "{ Changed = YES; }");
+        EXPECT_FALSE(cache.find("sdk")) << file;
+    }
+
+    RemoveDirectory(path);
+}
+
+TEST(LookupCache, NoCache)
+{
+    std::string path = TemporaryDirectory();
+    DefaultFilesystem filesystem;
+
+    LookupCache cache(&filesystem, path + "/xcrun_db");
+    cache.insert("key", { "value" }, { });
+    ASSERT_TRUE(cache.store());
+
+    /* Bypassing uses no cache, and leaves the file alone. */
+    EXPECT_EQ(nullptr, LookupCache::Open(&filesystem, cache.path(), false, true));
+    EXPECT_TRUE(filesystem.exists(cache.path()));
+
+    auto opened = LookupCache::Open(&filesystem, cache.path(), false, false);
+    ASSERT_NE(nullptr, opened);
+    EXPECT_TRUE(opened->find("key"));
+
+    RemoveDirectory(path);
+}
+
+TEST(LookupCache, KillCache)
+{
+    std::string path = TemporaryDirectory();
+    DefaultFilesystem filesystem;
+
+    LookupCache cache(&filesystem, path + "/xcrun_db");
+    cache.insert("key", { "value" }, { });
+    ASSERT_TRUE(cache.store());
+
+    /* Killing removes the file; the cache is then filled again. */
+    auto opened = LookupCache::Open(&filesystem, cache.path(), true, false);
+    ASSERT_NE(nullptr, opened);
+    EXPECT_FALSE(filesystem.exists(cache.path()));
+    EXPECT_FALSE(opened->find("key"));
+    opened->insert("other", { "value" }, { });
+    ASSERT_TRUE(opened->store());
+    EXPECT_TRUE(filesystem.exists(cache.path()));
+
+    /* Killing and bypassing together removes the file and uses no cache. */
+    EXPECT_EQ(nullptr, LookupCache::Open(&filesystem, cache.path(), true, true));
+    EXPECT_FALSE(filesystem.exists(cache.path()));
+
+    RemoveDirectory(path);
+}
+
+TEST(LookupCache, MergeOnStore)
+{
+    std::string path = TemporaryDirectory();
+    DefaultFilesystem filesystem;
+
+    /* Two runs loading the same file keep each other's entries. */
+    LookupCache first(&filesystem, path + "/xcrun_db");
+    LookupCache second(&filesystem, first.path());
+    first.load();
+    second.load();
+    first.insert("first", { "1" }, { });
+    second.insert("second", { "2" }, { });
+    ASSERT_TRUE(first.store());
+    ASSERT_TRUE(second.store());
+
+    LookupCache loaded(&filesystem, first.path());
+    EXPECT_TRUE(loaded.load());
+    EXPECT_TRUE(loaded.find("first"));
+    EXPECT_TRUE(loaded.find("second"));
+
+    RemoveDirectory(path);
+}
@@ -8,15 +8,23 @@
 
 #include <gtest/gtest.h>
 #include <xcsdk/Configuration.h>
+#include <xcsdk/SDK/Cache.h>
 #include <xcsdk/SDK/Manager.h>
 #include <xcsdk/SDK/Platform.h>
 #include <xcsdk/SDK/Toolchain.h>
+#include <libutil/DefaultFilesystem.h>
 #include <libutil/MemoryFilesystem.h>
 
+#include <fcntl.h>
+#include <ftw.h>
+#include <sys/stat.h>
+
 using xcsdk::Configuration;
+using xcsdk::SDK::Cache;
 using xcsdk::SDK::Manager;
 using xcsdk::SDK::Platform;
 using xcsdk::SDK::Toolchain;
+using libutil::DefaultFilesystem;
 using libutil::MemoryFilesystem;
 
 static std::vector<uint8_t>
@@ -58,3 +66,201 @@ TEST(Manager, ConfigurationExtraPaths)
     Toolchain::shared_ptr const &toolchain = manager->toolchains().front();
     EXPECT_EQ(toolchain->identifier(), std::string("extra"));
 }
+
+TEST(Manager, Find)
+{
+    auto filesystem = MemoryFilesystem({
+        MemoryFilesystem::Entry::Directory("Platforms", {
+            MemoryFilesystem::Entry::Directory("Test.platform", {
+                MemoryFilesystem::Entry::File("Info.plist", Contents("{ \
+                    Identifier = test; \
+                    Name = test; \
+                }")),
+                MemoryFilesystem::Entry::Directory("Developer", {
+                    MemoryFilesystem::Entry::Directory("SDKs", {
+                        MemoryFilesystem::Entry::Directory("Test1.0.sdk", {
+                            MemoryFilesystem::Entry::File("SDKSettings.plist", Contents("{ CanonicalName = test1.0; }")),
+                        }),
+                    }),
+                }),
+            }),
+        }),
+        MemoryFilesystem::Entry::Directory("Toolchains", {
+            MemoryFilesystem::Entry::Directory("Custom.xctoolchain", {
+                MemoryFilesystem::Entry::File("ToolchainInfo.plist", Contents("{ Identifier = com.example.custom; }")),
+            }),
+        }),
+    });
+
+    auto manager = Manager::Open(&filesystem, filesystem.path(""), ext::nullopt);
+    ASSERT_NE(manager, nullptr);
+    ASSERT_EQ(manager->platforms().size(), 1);
+    ASSERT_EQ(manager->platforms().front()->targets().size(), 1);
+    ASSERT_EQ(manager->toolchains().size(), 1);
+
+    /* Targets by canonical name, path, platform name, and platform path. */
+    auto target = manager->platforms().front()->targets().front();
+    EXPECT_EQ(target, manager->findTarget(&filesystem, "test1.0"));
+    EXPECT_EQ(target, manager->findTarget(&filesystem, target->path()));
+    EXPECT_EQ(target, manager->findTarget(&filesystem, "test"));
+    EXPECT_EQ(target, manager->findTarget(&filesystem, filesystem.path("Platforms/Test.platform")));
+    EXPECT_EQ(nullptr, manager->findTarget(&filesystem, "other"));
+    EXPECT_EQ(nullptr, manager->findTarget(&filesystem, filesystem.path("Platforms/Other.platform")));
+
+    /* Toolchains by name, identifier, and path. */
+    auto toolchain = manager->toolchains().front();
+    EXPECT_EQ(toolchain, manager->findToolchain(&filesystem, "Custom"));
+    EXPECT_EQ(toolchain, manager->findToolchain(&filesystem, "com.example.custom"));
+    EXPECT_EQ(toolchain, manager->findToolchain(nullptr, toolchain->path()));
+    EXPECT_EQ(nullptr, manager->findToolchain(&filesystem, "other"));
+}
+
+TEST(Manager, Lazy)
+{
+    auto filesystem = MemoryFilesystem({
+        MemoryFilesystem::Entry::Directory("Platforms", {
+            MemoryFilesystem::Entry::Directory("First.platform", {
+                MemoryFilesystem::Entry::File("Info.plist", Contents("{ Identifier = first; Name = first; Description = First; }")),
+                MemoryFilesystem::Entry::Directory("Developer", {
+                    MemoryFilesystem::Entry::Directory("SDKs", {
+                        MemoryFilesystem::Entry::Directory("First1.0.sdk", {
+                            MemoryFilesystem::Entry::File("SDKSettings.plist", Contents("{ CanonicalName = first1.0; }")),
+                        }),
+                    }),
+                }),
+            }),
+            MemoryFilesystem::Entry::Directory("Second.platform", {
+                MemoryFilesystem::Entry::File("Info.plist", Contents("{ Identifier = second; Name = second; Description = Second; }")),
+                MemoryFilesystem::Entry::Directory("Developer", {
+                    MemoryFilesystem::Entry::Directory("SDKs", {
+                        MemoryFilesystem::Entry::Directory("Second1.0.sdk", {
+                            MemoryFilesystem::Entry::File("SDKSettings.plist", Contents("{ CanonicalName = second1.0; }")),
+                        }),
+                    }),
+                }),
+            }),
+        }),
+    });
+
+    auto manager = Manager::Open(&filesystem, filesystem.path(""), ext::nullopt, nullptr, true);
+    ASSERT_NE(manager, nullptr);
+    ASSERT_EQ(manager->platforms().size(), 2);
+    Platform::shared_ptr first = manager->platforms().front();
+    Platform::shared_ptr second = manager->platforms().back();
+    EXPECT_EQ(1, first->targetPaths().size());
+    EXPECT_EQ(1, second->targetPaths().size());
+
+    /* Finding an SDK doesn't load the platforms after it. */
+    auto target = manager->findTarget(&filesystem, "first1.0");
+    ASSERT_NE(target, nullptr);
+    EXPECT_EQ(first, target->platform());
+    EXPECT_EQ(target, manager->findTarget(&filesystem, "first"));
+    EXPECT_EQ(target, manager->findTarget(&filesystem, target->path()));
+
+    /* Removed before its SDKs were needed, so none are loaded. */
+    ASSERT_TRUE(filesystem.removeFile(filesystem.path("Platforms/Second.platform/Developer/SDKs/Second1.0.sdk/SDKSettings.plist")));
+    EXPECT_EQ(nullptr, manager->findTarget(&filesystem, "second1.0"));
+    EXPECT_EQ(1, first->targets().size());
+    EXPECT_TRUE(second->targets().empty());
+}
+
+TEST(Manager, LazyOrder)
+{
+    /* The first platform's SDK doesn't look like it matches, but does. */
+    auto filesystem = MemoryFilesystem({
+        MemoryFilesystem::Entry::Directory("Platforms", {
+            MemoryFilesystem::Entry::Directory("First.platform", {
+                MemoryFilesystem::Entry::File("Info.plist", Contents("{ Identifier = first; Name = first; Description = First; }")),
+                MemoryFilesystem::Entry::Directory("Developer", {
+                    MemoryFilesystem::Entry::Directory("SDKs", {
+                        MemoryFilesystem::Entry::Directory("Other.sdk", {
+                            MemoryFilesystem::Entry::File("SDKSettings.plist", Contents("{ CanonicalName = second1.0; }")),
+                        }),
+                    }),
+                }),
+            }),
+            MemoryFilesystem::Entry::Directory("Second.platform", {
+                MemoryFilesystem::Entry::File("Info.plist", Contents("{ Identifier = second; Name = second; Description = Second; }")),
+                MemoryFilesystem::Entry::Directory("Developer", {
+                    MemoryFilesystem::Entry::Directory("SDKs", {
+                        MemoryFilesystem::Entry::Directory("Second1.0.sdk", {
+                            MemoryFilesystem::Entry::File("SDKSettings.plist", Contents("{ CanonicalName = second1.0; }")),
+                        }),
+                    }),
+                }),
+            }),
+        }),
+    });
+
+    /* Lazy and eager managers find the SDK in the same platform. */
+    for (bool lazy : { false, true }) {
+        auto manager = Manager::Open(&filesystem, filesystem.path(""), ext::nullopt, nullptr, lazy);
+        ASSERT_NE(manager, nullptr);
+        ASSERT_EQ(manager->platforms().size(), 2);
+
+        auto target = manager->findTarget(&filesystem, "second1.0");
+        ASSERT_NE(target, nullptr);
+        EXPECT_EQ(manager->platforms().front(), target->platform());
+    }
+}
+
+static void
+WriteFile(std::string const &path, std::string const &contents)
+{
+    FILE *fp = fopen(path.c_str(), "wb");
+    ASSERT_NE(fp, nullptr);
+    fwrite(contents.data(), 1, contents.size(), fp);
+    fclose(fp);
+}
+
+TEST(Manager, Cache)
+{
+    char root[] = "/tmp/xcsdk-cache-XXXXXX";
+    ASSERT_NE(mkdtemp(root), nullptr);
+    std::string path = root;
+
+    DefaultFilesystem filesystem;
+    ASSERT_TRUE(filesystem.createDirectory(path + "/Toolchains/XcodeDefault.xctoolchain", true));
+    ASSERT_TRUE(filesystem.createDirectory(path + "/Platforms/Test.platform/Developer/SDKs/Test1.0.sdk", true));
+    WriteFile(path + "/Toolchains/XcodeDefault.xctoolchain/ToolchainInfo.plist", "{ Identifier = com.apple.dt.toolchain.XcodeDefault; }");
+    WriteFile(path + "/Platforms/Test.platform/Info.plist", "{ Identifier = test; Name = test; }");
+    WriteFile(path + "/Platforms/Test.platform/Developer/SDKs/Test1.0.sdk/SDKSettings.plist", "{ CanonicalName = test1.0; }");
+
+    /* Discovering the SDKs fills the cache. */
+    Cache cache(&filesystem, path + "/Cache/cache.plist");
+    EXPECT_FALSE(cache.load());
+    auto manager = Manager::Open(&filesystem, path, ext::nullopt, &cache);
+    ASSERT_NE(manager, nullptr);
+    ASSERT_EQ(1, manager->platforms().size());
+    ASSERT_EQ(1, manager->platforms().front()->targets().size());
+    ASSERT_TRUE(cache.store());
+
+    /* Unchanged files are not read again: change one without changing its size or time. */
+    std::string platformInfo = path + "/Platforms/Test.platform/Info.plist";
+    struct stat st;
+    ASSERT_EQ(0, stat(platformInfo.c_str(), &st));
+    WriteFile(platformInfo, "{ Identifier = west; Name = west; }");
+    struct timespec times[2] = { st.st_atim, st.st_mtim };
+    ASSERT_EQ(0, utimensat(AT_FDCWD, platformInfo.c_str(), times, 0));
+
+    Cache loaded(&filesystem, cache.path());
+    EXPECT_TRUE(loaded.load());
+    manager = Manager::Open(&filesystem, path, ext::nullopt, &loaded);
+    ASSERT_NE(manager, nullptr);
+    ASSERT_EQ(1, manager->platforms().size());
+    EXPECT_EQ("test", manager->platforms().front()->name());
+    ASSERT_EQ(1, manager->platforms().front()->targets().size());
+    EXPECT_EQ(std::string("test1.0"), manager->platforms().front()->targets().front()->canonicalName());
+    ASSERT_EQ(1, manager->toolchains().size());
+
+    /* Changed files are read again. */
+    WriteFile(platformInfo, "{ Identifier = changed; Name = changed; }");
+    manager = Manager::Open(&filesystem, path, ext::nullopt, &loaded);
+    ASSERT_NE(manager, nullptr);
+    ASSERT_EQ(1, manager->platforms().size());
+    EXPECT_EQ("changed", manager->platforms().front()->name());
+
+    nftw(path.c_str(), [](char const *entry, struct stat const *, int, struct FTW *) -> int {
+        return remove(entry);
+    }, 16, FTW_DEPTH | FTW_PHYS);
+}
@@ -8,6 +8,8 @@
 
 #include <xcsdk/Configuration.h>
 #include <xcsdk/Environment.h>
+#include <xcsdk/SDK/Cache.h>
+#include <xcsdk/SDK/LookupCache.h>
 #include <xcsdk/SDK/Manager.h>
 #include <xcsdk/SDK/Toolchain.h>
 #include <libutil/DefaultFilesystem.h>
@@ -26,6 +28,7 @@
 using libutil::DefaultFilesystem;
 using libutil::Filesystem;
 using libutil::FSUtil;
+using xcsdk::SDK::LookupCache;
 
 class Options {
 private:
@@ -209,8 +212,8 @@ Help(std::string const &error = std::string())
     fprintf(stderr, "Options:\n");
     fprintf(stderr, INDENT "-v, --verbose\n");
     fprintf(stderr, INDENT "-l, --log\n");
-    fprintf(stderr, INDENT "-n, --no-cache (not implemented)\n");
-    fprintf(stderr, INDENT "-k, --kill-cache (not implemented)\n");
+    fprintf(stderr, INDENT "-n, --no-cache\n");
+    fprintf(stderr, INDENT "-k, --kill-cache\n");
 #undef INDENT
 
     return (error.empty() ? 0 : -1);
@@ -223,6 +226,61 @@ Version()
     return 0;
 }
 
+static int
+RunTool(
+    Filesystem *filesystem,
+    process::Context const *processContext,
+    process::Launcher *processLauncher,
+    Options const &options,
+    std::string const &executable,
+    ext::optional<std::string> const &SDKPath,
+    bool verbose,
+    bool log)
+{
+    if (options.find()) {
+        /*
+         * Just find the tool; i.e. print its path.
+         */
+        printf("%s\n", executable.c_str());
+        return 0;
+    } else {
+        /* Run is the default. */
+
+        std::unordered_map<std::string, std::string> environment = processContext->environmentVariables();
+
+        if (SDKPath) {
+            /*
+             * Update effective environment to include the target path.
+             */
+            environment["SDKROOT"] = *SDKPath;
+            if (log) {
+                printf("env SDKROOT=%s %s\n", SDKPath->c_str(), executable.c_str());
+            }
+        }
+
+        /*
+         * Execute the process!
+         */
+        if (verbose) {
+            printf("verbose: executing tool: %s\n", executable.c_str());
+        }
+
+        process::MemoryContext context = process::MemoryContext(
+            executable,
+            processContext->currentDirectory(),
+            options.args(),
+            environment);
+
+        ext::optional<int> exitCode = processLauncher->launch(filesystem, &context);
+        if (!exitCode) {
+            fprintf(stderr, "error: unable to execute tool '%s'\n", options.tool()->c_str());
+            return -1;
+        }
+
+        return *exitCode;
+    }
+}
+
 static int Run(Filesystem *filesystem, process::User const *user, process::Context const *processContext, process::Launcher *processLauncher)
 {
     /*
@@ -264,36 +322,118 @@ static int Run(Filesystem *filesystem, process::User const *user, process::Conte
     bool nocache = options.noCache() || (bool)processContext->environmentVariable("xcrun_nocache");
 
     /*
-     * Warn about unhandled arguments.
+     * Find the developer root.
+     */
+    ext::optional<std::string> developerRoot = xcsdk::Environment::DeveloperRoot(user, processContext, filesystem);
+    if (!developerRoot) {
+        fprintf(stderr, "error: unable to find developer root\n");
+        return -1;
+    }
+
+    /*
+     * Both the lookups and the contents of the developer root are cached.
+     */
+    ext::optional<std::string> lookupCachePath = LookupCache::DefaultPath(user, processContext);
+    ext::optional<std::string> cachePath = xcsdk::SDK::Cache::DefaultPath(user, processContext, *developerRoot);
+    if (options.killCache()) {
+        if (verbose) {
+            fprintf(stderr, "verbose: removing cache\n");
+        }
+        if (cachePath && filesystem->exists(*cachePath)) {
+            filesystem->removeFile(*cachePath);
+        }
+    }
+
+    std::string SDKMode;
+    if (options.showSDKPath()) {
+        SDKMode = "path";
+    } else if (options.showSDKVersion()) {
+        SDKMode = "version";
+    } else if (options.showSDKBuildVersion()) {
+        SDKMode = "build-version";
+    } else if (options.showSDKPlatformPath()) {
+        SDKMode = "platform-path";
+    } else if (options.showSDKPlatformVersion()) {
+        SDKMode = "platform-version";
+    }
+    bool showSDKValue = !SDKMode.empty();
+
+    /*
+     * Use an earlier lookup, if nothing it depends on has changed.
      */
-    if (nocache || options.killCache()) {
-        fprintf(stderr, "warning: cache options not implemented\n");
+    std::unique_ptr<LookupCache> lookupCache;
+    std::string lookupKey;
+    std::vector<std::string> lookupSources;
+    if (lookupCachePath) {
+        lookupCache = LookupCache::Open(filesystem, *lookupCachePath, options.killCache(), nocache || !(showSDKValue || options.tool()));
+    }
+    if (lookupCache != nullptr) {
+        std::vector<std::string> searchPaths = processContext->executableSearchPaths();
+        lookupKey = LookupCache::Key({
+            showSDKValue ? "sdk" : "tool",
+            SDKMode,
+            *developerRoot,
+            toolchainSpecified ? "specified" : "",
+            toolchainsInput.value_or(""),
+            SDK.value_or(""),
+            options.tool().value_or(""),
+            pbxsetting::Type::FormatList(searchPaths),
+        });
+
+        if (ext::optional<std::vector<std::string>> values = lookupCache->find(lookupKey)) {
+            if (verbose) {
+                fprintf(stderr, "verbose: using cached lookup\n");
+            }
+
+            if (showSDKValue && values->size() == 1) {
+                printf("%s\n", values->front().c_str());
+                return 0;
+            } else if (!showSDKValue && (values->size() == 1 || values->size() == 2)) {
+                ext::optional<std::string> SDKPath = (values->size() == 2 ? ext::optional<std::string>(values->back()) : ext::nullopt);
+                return RunTool(filesystem, processContext, processLauncher, options, values->front(), SDKPath, verbose, log);
+            }
+        }
+
+        /* The developer root's contents and configuration decide what's found. */
+        lookupSources = xcsdk::Configuration::DefaultPaths(user, processContext);
+        lookupSources.push_back(*developerRoot + "/Platforms");
+        lookupSources.push_back(*developerRoot + "/Toolchains");
+    }
+
+    std::vector<LookupCache::Dependency> lookupDependencies;
+    if (lookupCache != nullptr) {
+        for (std::string const &source : lookupSources) {
+            lookupDependencies.push_back(lookupCache->dependency(source));
+        }
     }
 
     /*
      * Load the SDK manager from the developer root.
      */
-    ext::optional<std::string> developerRoot = xcsdk::Environment::DeveloperRoot(user, processContext, filesystem);
-    if (!developerRoot) {
-        fprintf(stderr, "error: unable to find developer root\n");
-        return -1;
+    std::unique_ptr<xcsdk::SDK::Cache> cache;
+    bool warm = false;
+    if (!nocache && cachePath) {
+        cache = std::unique_ptr<xcsdk::SDK::Cache>(new xcsdk::SDK::Cache(filesystem, *cachePath));
+        warm = cache->load();
     }
+
+    /*
+     * With a warm cache, loading every SDK is cheap and keeps them all in
+     * the cache. Otherwise, only load the SDKs that are used.
+     */
     auto configuration = xcsdk::Configuration::Load(filesystem, xcsdk::Configuration::DefaultPaths(user, processContext));
-    auto manager = xcsdk::SDK::Manager::Open(filesystem, *developerRoot, configuration);
+    auto manager = xcsdk::SDK::Manager::Open(filesystem, *developerRoot, configuration, cache.get(), !warm);
     if (manager == nullptr) {
         fprintf(stderr, "error: unable to load manager from '%s'\n", developerRoot->c_str());
         return -1;
     }
+    if (cache != nullptr) {
+        cache->store();
+    }
     if (verbose) {
         fprintf(stderr, "verbose: using developer root '%s'\n", manager->path().c_str());
     }
 
-    bool showSDKValue = options.showSDKPath() ||
-        options.showSDKVersion() ||
-        options.showSDKBuildVersion() ||
-        options.showSDKPlatformPath() ||
-        options.showSDKPlatformVersion();
-
     /*
      * Determine the SDK to use.
      */
@@ -324,37 +464,49 @@ static int Run(Filesystem *filesystem, process::User const *user, process::Conte
         }
     }
 
+    if (lookupCache != nullptr && target != nullptr) {
+        std::vector<LookupCache::Dependency> targetDependencies = lookupCache->targetDependencies(*target);
+        lookupDependencies.insert(lookupDependencies.end(), targetDependencies.begin(), targetDependencies.end());
+    }
+
     /*
      * Perform SDK-specific actions.
      */
     if (showSDKValue) {
+        std::string value;
         if (options.showSDKPath()) {
-            printf("%s\n", target->path().c_str());
+            value = target->path();
         } else if (options.showSDKVersion()) {
-            printf("%s\n", target->version().value_or("").c_str());
+            value = target->version().value_or("");
         } else if (options.showSDKBuildVersion()) {
             if (auto product = target->product()) {
-                printf("%s\n", product->buildVersion().value_or("").c_str());
+                value = product->buildVersion().value_or("");
             } else {
                 fprintf(stderr, "error: sdk has no build version\n");
                 return -1;
             }
         } else if (options.showSDKPlatformPath()) {
             if (auto platform = target->platform()) {
-                printf("%s\n", platform->path().c_str());
+                value = platform->path();
             } else {
                 fprintf(stderr, "error: sdk has no platform\n");
                 return -1;
             }
         } else if (options.showSDKPlatformVersion()) {
             if (auto platform = target->platform()) {
-                printf("%s\n", platform->version().value_or("").c_str());
+                value = platform->version().value_or("");
             } else {
                 fprintf(stderr, "error: sdk has no platform\n");
                 return -1;
             }
         }
 
+        if (lookupCache != nullptr) {
+            lookupCache->insert(lookupKey, { value }, lookupDependencies);
+            lookupCache->store();
+        }
+
+        printf("%s\n", value.c_str());
         return 0;
     } else {
         /*
@@ -407,6 +559,15 @@ static int Run(Filesystem *filesystem, process::User const *user, process::Conte
         std::vector<std::string> defaultExecutablePaths = processContext->executableSearchPaths();
         executablePaths.insert(executablePaths.end(), defaultExecutablePaths.begin(), defaultExecutablePaths.end());
 
+        /*
+         * The tool is found in the first directory that has it, so the
+         * directories before it must still not have it.
+         */
+        std::vector<LookupCache::Dependency> searchDependencies;
+        if (lookupCache != nullptr) {
+            searchDependencies = lookupCache->searchDependencies(executablePaths, *options.tool());
+        }
+
         /*
          * Find the tool to execute.
          */
@@ -419,48 +580,26 @@ static int Run(Filesystem *filesystem, process::User const *user, process::Conte
             fprintf(stderr, "verbose: resolved tool '%s' to: %s\n", options.tool()->c_str(), executable->c_str());
         }
 
-        if (options.find()) {
-            /*
-             * Just find the tool; i.e. print its path.
-             */
-            printf("%s\n", executable->c_str());
-            return 0;
-        } else {
-            /* Run is the default. */
-
-            std::unordered_map<std::string, std::string> environment = processContext->environmentVariables();
+        ext::optional<std::string> SDKPath = (target != nullptr ? ext::optional<std::string>(target->path()) : ext::nullopt);
 
-            if (target != nullptr) {
-                /*
-                 * Update effective environment to include the target path.
-                 */
-                environment["SDKROOT"] = target->path();
-                if (log) {
-                    printf("env SDKROOT=%s %s\n", target->path().c_str(), executable->c_str());
+        if (lookupCache != nullptr) {
+            for (size_t n = 0; n < executablePaths.size(); n++) {
+                lookupDependencies.push_back(searchDependencies[n]);
+                if (FSUtil::NormalizePath(executablePaths[n] + "/" + *options.tool()) == *executable) {
+                    break;
                 }
             }
+            lookupDependencies.push_back(lookupCache->dependency(*executable));
 
-            /*
-             * Execute the process!
-             */
-            if (verbose) {
-                printf("verbose: executing tool: %s\n", executable->c_str());
-            }
-
-            process::MemoryContext context = process::MemoryContext(
-                *executable,
-                processContext->currentDirectory(),
-                options.args(),
-                environment);
-
-            ext::optional<int> exitCode = processLauncher->launch(filesystem, &context);
-            if (!exitCode) {
-                fprintf(stderr, "error: unable to execute tool '%s'\n", options.tool()->c_str());
-                return -1;
+            std::vector<std::string> values = { *executable };
+            if (SDKPath) {
+                values.push_back(*SDKPath);
             }
-
-            return *exitCode;
+            lookupCache->insert(lookupKey, values, lookupDependencies);
+            lookupCache->store();
         }
+
+        return RunTool(filesystem, processContext, processLauncher, options, *executable, SDKPath, verbose, log);
     }
 }
 